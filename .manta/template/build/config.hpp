@@ -14,6 +14,10 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#define AUDIO_ENABLED ( 0 )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 #include <manta.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
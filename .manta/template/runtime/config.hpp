@@ -32,6 +32,10 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#define AUDIO_ENABLED ( 0 )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 #include <manta.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
\ No newline at end of file
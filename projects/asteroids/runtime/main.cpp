@@ -9,6 +9,7 @@
 #include <manta/input.hpp>
 #include <manta/draw.hpp>
 #include <manta/fonts.hpp>
+#include <manta/profiler.hpp>
 
 #include <scene.hpp>
 
@@ -16,6 +17,8 @@
 
 namespace Project
 {
+	static bool profilerOverlay = false;
+
 	bool init( int argc, char **argv )
 	{
 		scene_init();
@@ -34,10 +37,24 @@ namespace Project
 		if( Keyboard::check_pressed( vk_escape ) ) { Engine::exit(); }
 		if( Keyboard::check_pressed( vk_f4 ) ) { Window::fullscreen_set( !Window::fullscreen ); }
 
+	#if PROFILING
+		// Profiler: F3 toggles the overlay, F2 starts/stops a Chrome trace capture
+		if( Keyboard::check_pressed( vk_f3 ) ) { profilerOverlay = !profilerOverlay; }
+		if( Keyboard::check_pressed( vk_f2 ) )
+		{
+			if( Profiler::tracing() ) { Profiler::trace_end( "profile.json" ); } else { Profiler::trace_begin(); }
+		}
+	#endif
+	}
+
+	void simulate( Delta delta )
+	{
 		// Update Scene
 		scene_update( delta );
+	}
 
-		// Render
+	void render( Delta delta )
+	{
 		Gfx::frame_begin();
 		{
 			Gfx::clear_color( { 20, 20, 40 } );
@@ -48,6 +65,9 @@ namespace Project
 
 			// Debug
 			draw_text_f( fnt_consolas, 24, 8.0f, 8.0f, c_white, "FPS: %d", Frame::fps );
+		#if PROFILING
+			if( profilerOverlay ) { debug_overlay_profiler( 8.0f, 40.0f, Window::width - 16.0f ); }
+		#endif
 		}
 		Gfx::frame_end();
 	}
@@ -57,6 +77,6 @@ namespace Project
 
 int main( int argc, char **argv )
 {
-	ProjectCallbacks callbacks { Project::init, Project::free, Project::update };
+	ProjectCallbacks callbacks { Project::init, Project::free, Project::update, Project::simulate, Project::render };
 	return Engine::main( argc, argv, callbacks );
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <manta/draw.hpp>
 #include <manta/window.hpp>
 #include <manta/input.hpp>
+#include <manta/text.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -12,11 +13,18 @@
 namespace Scene
 {
 	ObjectContext objects;
+	PartitionGrid partition;
+	Buffer quicksave;
 	int score = false;
 	bool dead = true;
 }
 
 
+static TextMesh textScore;
+static TextMesh textDeath;
+static TextMesh textRestart;
+
+
 static void create_asteroid()
 {
 	Scene::objects.create<obj_asteroid>( random<float>( 4.0f, 8.0f ) );
@@ -28,16 +36,39 @@ void scene_init()
 	// Init ObjectContext
 	Scene::objects.init();
 
+	// Init Partition (broadphase for object collisions)
+	Scene::partition.init( 64.0f );
+
+	// Init Quicksave (ObjectContext snapshot)
+	Scene::quicksave.init( 64 * 1024, true );
+
 	// Create Player
 	Scene::objects.create( obj_rocket );
 
 	// Create Astroids
 	for( int i = 0; i < 5; i++ ) { create_asteroid(); }
+
+	// Init HUD Text
+	textScore.init();
+	textDeath.init();
+	textRestart.init();
+	textRestart.set( fnt_consolas, 24, "Press Space to restart!" );
 }
 
 
 void scene_free()
 {
+	// Free HUD Text
+	textRestart.free();
+	textDeath.free();
+	textScore.free();
+
+	// Free Quicksave
+	Scene::quicksave.free();
+
+	// Free Partition
+	Scene::partition.free();
+
 	// Free ObjectContext
 	Scene::objects.free();
 }
@@ -48,8 +79,26 @@ void scene_update( const Delta delta )
 	// Spawn Asteroid
 	if( Frame::tickSecond ) { create_asteroid(); }
 
-	// Step Objects
+	// Quicksave (F5) & Quickload (F9)
+	if( Keyboard::check_pressed( vk_f5 ) ) { Scene::objects.snapshot( Scene::quicksave ); }
+	if( Keyboard::check_pressed( vk_f9 ) && Scene::quicksave.size() > 0 )
+	{
+		// Proxies are rebuilt by the next EVENT_PARTITION pass (see EVENT_LOAD)
+		if( Scene::objects.restore( Scene::quicksave ) ) { Scene::partition.clear(); }
+	}
+
+	// Move Asteroids
+	obj_asteroid_move( delta );
+
+	// Partition Objects (after the move, so step queries see this frame's asteroid positions)
+	Scene::partition.begin();
+	Scene::objects.event_partition( &Scene::partition );
+	Scene::partition.end();
+
+	// Step Objects (creates & destroys are applied together after the pass)
+	Scene::objects.defer_begin();
 	Scene::objects.event_step( delta );
+	Scene::objects.defer_end();
 
 	// Game State
 	Scene::dead = Scene::objects.count( obj_rocket ) == 0;
@@ -79,22 +128,32 @@ void scene_draw( const Delta delta )
 	// Draw Objects
 	Scene::objects.event_draw( delta );
 
+	// HUD text is laid out once & only rebuilt when the string changes (see TextMesh)
+	const Align halign = draw_get_halign();
+	const Align valign = draw_get_valign();
+	draw_set_halign( Align_Center );
+	draw_set_valign( Align_Middle );
+
 	if( !Scene::dead )
 	{
 		// Draw Score
-		const i32v2 dScore = text_dimensions_f( fnt_consolas, 24, "Score: %d", Scene::score );
-		draw_text_f( fnt_consolas, 32, Window::width * 0.5f - dScore.x, 16.0f, c_white, "Score: %d", Scene::score );
+		textScore.set_f( fnt_consolas, 32, "Score: %d", Scene::score );
+		textScore.draw( Window::width * 0.5f, 32.0f, c_white );
 	}
 	else
 	{
 		// Death Screen
-		const i32v2 dMsg = text_dimensions_f( fnt_consolas, 48, "You died! Score: %d", Scene::score );
-		const i32v2 dRst = text_dimensions( fnt_consolas, 24, "Press Space to restart!" );
+		textDeath.set_f( fnt_consolas, 48, "You died! Score: %d", Scene::score );
+		const i32v2 dMsg = textDeath.dimensions();
+		const i32v2 dRst = textRestart.dimensions();
 
 		const float cX = Window::width * 0.5f;
 		const float cY = Window::height * 0.5f;
 		draw_rectangle( 0.0f, cY - dMsg.y * 0.5f - 64.0f, Window::width, cY + dRst.y * 0.5f + 64.0f, { 0, 0, 0, 127 } );
-		draw_text_f( fnt_consolas, 48, cX - dMsg.x * 0.5f, cY - dMsg.y * 0.5f - 32.0f, c_white, "You died! Score: %d", Scene::score );
-		draw_text( fnt_consolas, 24, cX - dRst.x * 0.5f, cY - dRst.y * 0.5f + 32.0f, c_white, "Press Space to restart!" );
+		textDeath.draw( cX, cY - 32.0f, c_white );
+		textRestart.draw( cX, cY + 32.0f, c_white );
 	}
+
+	draw_set_halign( halign );
+	draw_set_valign( valign );
 }
@@ -1,12 +1,15 @@
 #pragma once
 
 #include <manta/objects.hpp>
+#include <manta/partition.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 namespace Scene
 {
 	extern ObjectContext objects;
+	extern PartitionGrid partition;
+	extern Buffer quicksave;
 	extern int score;
 	extern bool dead;
 }
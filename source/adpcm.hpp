@@ -0,0 +1,76 @@
+#pragma once
+
+#include <types.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// IMA ADPCM (4 bits per sample)
+//
+// Shared by build.exe (encoding .sound assets) and the runtime (stream decoding). Sounds are split into blocks of a
+// fixed number of frames that decode independently: per channel, a block stores a header (i16 predictor, u8 step
+// index, u8 padding) followed by 'frames / 2' bytes of nibbles (low nibble first).
+
+#define ADPCM_HEADER_SIZE ( 4 )
+
+struct AdpcmState
+{
+	i32 predictor = 0;
+	i32 index = 0;
+};
+
+
+static constexpr i16 ADPCM_STEPS[89] =
+{
+	7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97,
+	107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+	876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871,
+	5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623,
+	27086, 29794, 32767,
+};
+
+
+static constexpr i8 ADPCM_INDICES[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline usize adpcm_block_size( const u32 frames, const u32 channels )
+{
+	return channels * ( ADPCM_HEADER_SIZE + frames / 2 );
+}
+
+
+inline i32 adpcm_decode( AdpcmState &state, const u8 nibble )
+{
+	const i32 step = ADPCM_STEPS[state.index];
+	i32 difference = step >> 3;
+	if( nibble & 4 ) { difference += step; }
+	if( nibble & 2 ) { difference += step >> 1; }
+	if( nibble & 1 ) { difference += step >> 2; }
+
+	state.predictor += ( nibble & 8 ) ? -difference : difference;
+	state.predictor = state.predictor < -32768 ? -32768 : ( state.predictor > 32767 ? 32767 : state.predictor );
+	state.index += ADPCM_INDICES[nibble];
+	state.index = state.index < 0 ? 0 : ( state.index > 88 ? 88 : state.index );
+	return state.predictor;
+}
+
+
+inline u8 adpcm_encode( AdpcmState &state, const i32 sample )
+{
+	i32 difference = sample - state.predictor;
+	u8 nibble = 0;
+	if( difference < 0 ) { nibble = 8; difference = -difference; }
+
+	i32 step = ADPCM_STEPS[state.index];
+	if( difference >= step ) { nibble |= 4; difference -= step; }
+	step >>= 1;
+	if( difference >= step ) { nibble |= 2; difference -= step; }
+	step >>= 1;
+	if( difference >= step ) { nibble |= 1; }
+
+	// Track the decoder
+	adpcm_decode( state, nibble );
+	return nibble;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
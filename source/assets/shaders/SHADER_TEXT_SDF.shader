@@ -0,0 +1,60 @@
+#include <shader_api.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+vertex_input BuiltinVertex
+{
+	float3 position semantic( POSITION ) format( FLOAT32 );
+	float2 uv semantic( TEXCOORD ) format( UNORM16 );
+	float4 color semantic( COLOR ) format( UNORM8 );
+};
+
+vertex_output VertexOutput
+{
+	float4 position semantic( POSITION );
+	float2 uv semantic( TEXCOORD );
+	float4 color semantic( COLOR );
+};
+
+fragment_input FragmentInput
+{
+	float4 position semantic( POSITION );
+	float2 uv semantic( TEXCOORD );
+	float4 color semantic( COLOR );
+};
+
+fragment_output FragmentOutput
+{
+	float4 color0 semantic( COLOR ) target( 0 );
+};
+
+cbuffer( 0 ) ShaderGlobals
+{
+	float4x4 matrixModel;
+	float4x4 matrixView;
+	float4x4 matrixPerspective;
+	float4x4 matrixMVP;
+};
+
+texture2D( 0 ) texture0;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void vertex_main( BuiltinVertex In, VertexOutput Out, ShaderGlobals globals )
+{
+	Out.position = mul( globals.matrixMVP, float4( In.position, 1.0 ) );
+	Out.uv = In.uv;
+	Out.color = In.color;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void fragment_main( FragmentInput In, FragmentOutput Out )
+{
+	// Signed distance field glyphs (see Fonts::bake_sdf): 0.5 is the glyph edge
+	float4 tex = sample_texture2D( texture0, In.uv );
+	float smoothing = clamp( fwidth( tex.a ) * 0.75, 0.001, 0.5 );
+	float alpha = smoothstep( 0.5 - smoothing, 0.5 + smoothing, tex.a );
+	if( alpha <= 0.0 ) { discard; }
+	Out.color0 = float4( In.color.rgb, In.color.a * alpha );
+}
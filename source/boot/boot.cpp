@@ -263,6 +263,10 @@ int main( int argc, char **argv )
 		linkerflags_add_library( linkerFlags, sizeof( linkerFlags ), tc, "winmm" ); // windows timer
 		#endif
 
+		#if PIPELINE_OS_LINUX
+		linkerflags_add_library( linkerFlags, sizeof( linkerFlags ), tc, "pthread" ); // texture compression threads
+		#endif
+
 		swrite( linkerFlags, file );
 		swrite( "\n", file );
 	}
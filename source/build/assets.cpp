@@ -28,6 +28,7 @@ namespace Assets
 	Fonts fonts;
 	FontRanges fontRanges;
 	Meshes meshes;
+	Sounds sounds;
 }
 
 
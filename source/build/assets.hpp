@@ -10,6 +10,7 @@
 #include <build/assets/materials.hpp>
 #include <build/assets/fonts.hpp>
 #include <build/assets/meshes.hpp>
+#include <build/assets/sounds.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -36,6 +37,7 @@ namespace Assets
 	extern Fonts fonts;
 	extern FontRanges fontRanges;
 	extern Meshes meshes;
+	extern Sounds sounds;
 
 	// Setup
 	extern void begin();
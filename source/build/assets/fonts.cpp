@@ -147,6 +147,18 @@ void Fonts::load( const char *path )
 	font.fontRangeFirst = font.fontRangeIDs[0];
 	font.fontRangeCount = font.fontRangeIDs.size();
 
+	// Signed Distance Field (optional)
+	JSON sdf = fontJSON.Object( "sdf" );
+	if( sdf )
+	{
+		const int sdfSize = sdf.GetInt( "size", 32 );
+		const int sdfSpread = sdf.GetInt( "spread", 4 );
+		ErrorIf( sdfSize <= 0 || sdfSize > 128, "Font '%s' has an invalid sdf size %d (1 - 128)", path, sdfSize );
+		ErrorIf( sdfSpread <= 0 || sdfSpread > 32, "Font '%s' has an invalid sdf spread %d (1 - 32)", path, sdfSpread );
+		font.sdfSize = static_cast<u16>( sdfSize );
+		font.sdfSpread = static_cast<u16>( sdfSpread );
+	}
+
 	// Load font .ttf file
 	char pathRelative[PATH_SIZE];
 	path_get_directory( pathRelative, sizeof( pathRelative ), path );
@@ -168,6 +180,66 @@ void Fonts::load( const char *path )
 		strjoin( ttfPath, ttf.c_str() );
 		ErrorIf( !file_copy( ttfPath, ttfPathDistributables ), "Unable to load .tff for font %s: %s", name.c_str(), ttfPath );
 	}
+
+	// Bake SDF glyphs
+	if( font.sdfSize > 0 ) { bake_sdf( font, ttfPathDistributables ); }
+}
+
+
+void Fonts::bake_sdf( Font &font, const char *path )
+{
+	// Load .ttf
+	File ttf;
+	ErrorIf( !ttf.open( path ), "Unable to open .ttf for font %s: %s", font.name.c_str(), path );
+	stbtt_fontinfo info;
+	ErrorIf( stbtt_InitFont( &info, ttf.data, stbtt_GetFontOffsetForIndex( ttf.data, 0 ) ) != 1,
+	         "Failed to get metrics for font %s: %s", font.name.c_str(), path );
+
+	// Metrics match the runtime rasterizer (see FontGlyphInfo::get_glyph_metrics)
+	const float scale = stbtt_ScaleForPixelHeight( &info, font.sdfSize * ( 96.0f / 72.0f ) );
+	int mx0, my0, mx1, my1;
+	stbtt_GetCodepointBitmapBox( &info, 'T', scale, scale, &mx0, &my0, &mx1, &my1 );
+
+	// The distance field stores 128 on the glyph edge and falls off by 128 / spread per pixel
+	const unsigned char onEdge = 128;
+	const float distanceScale = 128.0f / font.sdfSpread;
+
+	String atlas = font.name;
+	atlas.append( "_sdf" );
+	font.sdfTexture = Assets::textures.make_new( atlas );
+	font.sdfGlyphFirst = fontGlyphs.size();
+
+	// Ranges are baked in order (the runtime indexes glyphs by range offset)
+	for( u32 i = 0; i < font.fontRangeCount; i++ )
+	{
+		const FontRange &range = Assets::fontRanges[font.fontRangeFirst + i];
+		for( u32 codepoint = range.start; codepoint <= range.end; codepoint++ )
+		{
+			FontGlyph &glyph = fontGlyphs.add( { } );
+			glyph.glyph = GLYPHID_MAX;
+
+			int advance, leftSideBearing;
+			stbtt_GetCodepointHMetrics( &info, codepoint, &advance, &leftSideBearing );
+			glyph.advance = advance * scale;
+
+			int width, height, xoff, yoff;
+			unsigned char *bitmap = stbtt_GetCodepointSDF( &info, scale, codepoint, font.sdfSpread, onEdge, distanceScale,
+			                                               &width, &height, &xoff, &yoff );
+			if( bitmap == nullptr ) { continue; }
+
+			Texture2DBuffer glyphTexture { static_cast<u16>( width ), static_cast<u16>( height ) };
+			for( int p = 0; p < width * height; p++ ) { glyphTexture.data[p] = { 255, 255, 255, bitmap[p] }; }
+			stbtt_FreeSDF( bitmap, nullptr );
+
+			glyph.glyph = Assets::textures[font.sdfTexture].add_glyph( static_cast<Texture2DBuffer &&>( glyphTexture ) );
+			glyph.xshift = static_cast<i16>( xoff );
+			glyph.yshift = static_cast<i16>( yoff - my0 );
+			glyph.width = static_cast<u16>( width );
+			glyph.height = static_cast<u16>( height );
+		}
+	}
+
+	ttf.close();
 }
 
 
@@ -190,11 +262,24 @@ void Fonts::write()
 		assets_group( header );
 
 		// Struct
+		assets_struct( header,
+			"DiskFontGlyph",
+			"u32 glyph;",
+			"i16 xshift;",
+			"i16 yshift;",
+			"u16 width;",
+			"u16 height;",
+			"float advance;" );
+
 		assets_struct( header,
 			"DiskFont",
 			"u32 fontRangeFirst;",
 			"u32 fontRangeCount;",
-			"const char *file;" );
+			"const char *file;",
+			"u32 sdfGlyphFirst;",
+			"u16 sdfTexture;",
+			"u16 sdfSize;",
+			"u16 sdfSpread;" );
 
 		// Enums
 		header.append( "enum\n{\n" );
@@ -208,6 +293,8 @@ void Fonts::write()
 		header.append( "namespace Assets\n{\n" );
 		header.append( "\tconstexpr u32 fontsCount = " ).append( static_cast<int>( fonts.size() ) ).append( ";\n" );
 		header.append( "\textern const DiskFont fonts[];\n" );
+		header.append( "\tconstexpr u32 fontGlyphsCount = " ).append( static_cast<int>( fontGlyphs.size() ) ).append( ";\n" );
+		header.append( "\textern const DiskFontGlyph fontGlyphs[];\n" );
 		header.append( "}\n\n" );
 	}
 
@@ -225,14 +312,35 @@ void Fonts::write()
 			char filename[PATH_SIZE];
 			strjoin( filename, "\"", font.file.c_str(), "\"" );
 
-			snprintf( buffer, PATH_SIZE, "\t\t{ %d, %d, %s },\n",
+			snprintf( buffer, PATH_SIZE, "\t\t{ %d, %d, %s, %d, %d, %d, %d },\n",
 				font.fontRangeFirst,
 				font.fontRangeCount,
-				filename );
+				filename,
+				font.sdfGlyphFirst,
+				font.sdfTexture,
+				font.sdfSize,
+				font.sdfSpread );
 
 			source.append( buffer );
 		}
 		source.append( "\t};\n\n" );
+
+		// DiskFontGlyph Table (SDF glyphs)
+		source.append( "\tconst DiskFontGlyph fontGlyphs[fontGlyphsCount + 1] =\n\t{\n" );
+		for( FontGlyph &glyph : fontGlyphs )
+		{
+			snprintf( buffer, PATH_SIZE, "\t\t{ %uu, %d, %d, %u, %u, %ff },\n",
+				glyph.glyph,
+				glyph.xshift,
+				glyph.yshift,
+				glyph.width,
+				glyph.height,
+				glyph.advance );
+
+			source.append( buffer );
+		}
+		source.append( "\t\t{ },\n" );
+		source.append( "\t};\n" );
 		source.append( "}\n\n" );
 	}
 
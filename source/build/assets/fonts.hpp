@@ -29,12 +29,29 @@ struct FontRanges
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+struct FontGlyph
+{
+	GlyphID glyph; // GLYPHID_MAX: no bitmap (e.g. whitespace)
+	i16 xshift;
+	i16 yshift;
+	u16 width;
+	u16 height;
+	float advance;
+};
+
+
 struct Font
 {
 	u32 fontRangeFirst;
 	u32 fontRangeCount;
 	String file;
 
+	// Signed distance field atlas (sdfSize 0: none)
+	u32 sdfGlyphFirst = 0;
+	TextureID sdfTexture = 0;
+	u16 sdfSize = 0;
+	u16 sdfSpread = 0;
+
 	String name;
 	String ttf;
 	List<u32> fontRangeIDs;
@@ -44,9 +61,11 @@ struct Font
 struct Fonts
 {
 	List<Font> fonts;
+	List<FontGlyph> fontGlyphs;
 
 	void gather( const char *path, const bool recurse = true );
 	void load( const char *path );
+	void bake_sdf( Font &font, const char *path );
 	void write();
 
 	inline Font &operator[]( const u32 fontID ) { return fonts[fontID]; }
@@ -62,6 +62,7 @@ void Materials::load( const char *path )
 	ErrorIf( colorTexture.length() == 0, "Material '%s' has an invalid color texture (required)", path );
 	//String normalTexture = materialJSON.GetString( "normalTexture" );
 	//ErrorIf( normalTexture.length() == 0, "Material '%s' has an invalid normal texture (required)", path );
+	String compression = materialJSON.GetString( "compression" );
 
 	// Load texture (try relative path first)
 	char pathRelative[PATH_SIZE];
@@ -83,6 +84,7 @@ void Materials::load( const char *path )
 	material.textureIDColor = Assets::textures.make_new( name ); // TODO: Generate unique name
 	Texture &colorTextureAsset = Assets::textures[material.textureIDColor];
 	colorTextureAsset.atlasTexture = false;
+	if( compression.length() > 0 ) { colorTextureAsset.set_compression( compression, path ); }
 	colorTextureAsset.add_glyph( static_cast<Texture2DBuffer &&>( colorTextureBuffer ) );
 
 	// Register Material
@@ -0,0 +1,250 @@
+#include <build/assets/sounds.hpp>
+
+#include <build/build.hpp>
+
+#include <build/assets.hpp>
+
+#include <build/json.hpp>
+#include <build/list.hpp>
+#include <build/fileio.hpp>
+
+#include <vendor/string.hpp>
+
+#include <adpcm.hpp>
+#include <types.hpp>
+#include <debug.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct WavData
+{
+	const i16 *samples = nullptr; // interleaved
+	u32 frames = 0;
+	u32 sampleRate = 0;
+	u16 channels = 0;
+};
+
+
+static u16 read_u16( const byte *data ) { return static_cast<u16>( data[0] | ( data[1] << 8 ) ); }
+static u32 read_u32( const byte *data ) { return static_cast<u32>( read_u16( data ) | ( read_u16( data + 2 ) << 16 ) ); }
+
+
+static bool wav_parse( const File &file, WavData &wav, const char *path )
+{
+	const byte *data = file.data;
+	const usize size = file.size;
+	ErrorReturnIf( size < 12 || memcmp( data, "RIFF", 4 ) != 0 || memcmp( data + 8, "WAVE", 4 ) != 0, false,
+		"Sound '%s' is not a RIFF/WAVE file", path );
+
+	u16 format = 0;
+	u16 bits = 0;
+	for( usize tell = 12; tell + 8 <= size; )
+	{
+		const byte *chunk = data + tell;
+		const u32 chunkSize = read_u32( chunk + 4 );
+		ErrorReturnIf( tell + 8 + chunkSize > size, false, "Sound '%s' has a truncated chunk", path );
+
+		if( memcmp( chunk, "fmt ", 4 ) == 0 && chunkSize >= 16 )
+		{
+			format = read_u16( chunk + 8 );
+			wav.channels = read_u16( chunk + 10 );
+			wav.sampleRate = read_u32( chunk + 12 );
+			bits = read_u16( chunk + 22 );
+		}
+		else if( memcmp( chunk, "data", 4 ) == 0 )
+		{
+			ErrorReturnIf( format == 0, false, "Sound '%s' has a 'data' chunk before its 'fmt ' chunk", path );
+			wav.samples = reinterpret_cast<const i16 *>( chunk + 8 );
+			wav.frames = wav.channels > 0 ? chunkSize / ( wav.channels * sizeof( i16 ) ) : 0;
+		}
+
+		tell += 8 + chunkSize + ( chunkSize & 1 ); // chunks are word aligned
+	}
+
+	// 16-bit PCM (WAVE_FORMAT_PCM or WAVE_FORMAT_EXTENSIBLE)
+	ErrorReturnIf( format != 1 && format != 0xFFFE, false, "Sound '%s' must be uncompressed PCM (format: %u)", path, format );
+	ErrorReturnIf( bits != 16, false, "Sound '%s' must be 16-bit (bits: %u)", path, bits );
+	ErrorReturnIf( wav.channels != 1 && wav.channels != 2, false, "Sound '%s' must be mono or stereo (channels: %u)", path, wav.channels );
+	ErrorReturnIf( wav.samples == nullptr || wav.frames == 0, false, "Sound '%s' has no samples", path );
+
+	// Success
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Sounds::gather( const char *path, const bool recurse )
+{
+	// Gather & Load Sounds
+	Timer timer;
+	List<FileInfo> files;
+	directory_iterate( files, path, ".sound", recurse );
+	for( FileInfo &fileInfo : files ) { load( fileInfo.path ); }
+
+	// Log
+	if( verbose_output() )
+	{
+		const u32 count = files.size();
+		PrintColor( LOG_CYAN, TAB TAB "%u sound%s found in: %s", count, count == 1 ? "" : "s", path );
+		PrintLnColor( LOG_WHITE, " (%.3f ms)", timer.elapsed_ms() );
+	}
+}
+
+
+void Sounds::load( const char *path )
+{
+	// Open sound file
+	String soundFile;
+	ErrorIf( !soundFile.load( path ), "Unable to load sound file: %s", path );
+	JSON soundJSON { soundFile };
+
+	// Read file (json)
+	String name = soundJSON.GetString( "name" );
+	String wav = soundJSON.GetString( "wav" );
+	ErrorIf( name.length() == 0, "Sound '%s' has an invalid name", path );
+	ErrorIf( wav.length() == 0, "Sound '%s' has an invalid file", path );
+
+	// Register Sound
+	Sound &sound = sounds.add( { } );
+	sound.name = name;
+
+	// Try relative path first, then absolute
+	char pathRelative[PATH_SIZE];
+	path_get_directory( pathRelative, sizeof( pathRelative ), path );
+	strappend( pathRelative, SLASH );
+	strappend( pathRelative, wav.c_str() );
+	FileTime timeWav;
+	sound.path = file_time( pathRelative, &timeWav ) ? pathRelative : wav.c_str();
+	ErrorIf( !file_time( sound.path.c_str(), &timeWav ), "Unable to find .wav for sound %s: %s", name.c_str(), wav.c_str() );
+
+	// Cache (.sound & .wav)
+	Assets::assetFileCount++;
+	if( !Build::cacheDirtyAssets )
+	{
+		FileTime time;
+		file_time( path, &time );
+		Build::cacheDirtyAssets |= file_time_newer( time, Assets::timeCache );
+		Build::cacheDirtyAssets |= file_time_newer( timeWav, Assets::timeCache );
+	}
+}
+
+
+void Sounds::write()
+{
+	Buffer &binary = Assets::binary;
+	String &header = Assets::header;
+	String &source = Assets::source;
+
+	Timer timer;
+
+	// Binary
+	{
+		for( Sound &sound : sounds )
+		{
+			File file;
+			ErrorIf( !file.open( sound.path.c_str() ), "Unable to open .wav for sound %s: %s", sound.name.c_str(), sound.path.c_str() );
+			WavData wav;
+			ErrorIf( !wav_parse( file, wav, sound.path.c_str() ), "Failed to parse sound %s", sound.name.c_str() );
+
+			sound.offset = binary.tell;
+			sound.frames = wav.frames;
+			sound.sampleRate = wav.sampleRate;
+			sound.channels = static_cast<u8>( wav.channels );
+			sound.blockCount = ( wav.frames + SOUND_BLOCK_FRAMES - 1 ) / SOUND_BLOCK_FRAMES;
+			sound.blockSize = static_cast<u32>( adpcm_block_size( SOUND_BLOCK_FRAMES, wav.channels ) );
+
+			// ADPCM blocks (the encoder state carries across blocks; each block header snapshots it)
+			AdpcmState states[2];
+			for( u32 block = 0; block < sound.blockCount; block++ )
+			{
+				const u32 first = block * SOUND_BLOCK_FRAMES;
+				for( u32 channel = 0; channel < sound.channels; channel++ )
+				{
+					AdpcmState &state = states[channel];
+					binary.write( static_cast<i16>( state.predictor ) );
+					binary.write( static_cast<u8>( state.index ) );
+					binary.write( static_cast<u8>( 0 ) );
+
+					for( u32 frame = 0; frame < SOUND_BLOCK_FRAMES; frame += 2 )
+					{
+						// Pad the final block with silence
+						const u32 a = first + frame;
+						const u32 b = first + frame + 1;
+						const i32 sampleA = a < wav.frames ? wav.samples[a * sound.channels + channel] : 0;
+						const i32 sampleB = b < wav.frames ? wav.samples[b * sound.channels + channel] : 0;
+						const u8 low = adpcm_encode( state, sampleA );
+						const u8 high = adpcm_encode( state, sampleB );
+						binary.write( static_cast<u8>( low | ( high << 4 ) ) );
+					}
+				}
+			}
+
+			file.close();
+		}
+	}
+
+	// Header
+	{
+		// Group
+		assets_group( header );
+
+		// Struct
+		assets_struct( header,
+			"DiskSound",
+			"usize offset;",
+			"u32 frames;",
+			"u32 sampleRate;",
+			"u32 blockCount;",
+			"u32 blockSize;",
+			"u8 channels;" );
+
+		// Enums
+		if( sounds.size() > 0 )
+		{
+			header.append( "enum\n{\n" );
+			for( Sound &sound : sounds ) { header.append( "\t" ).append( sound.name ).append( ",\n" ); }
+			header.append( "};\n\n" );
+		}
+
+		// Table
+		header.append( "namespace Assets\n{\n" );
+		header.append( "\tconstexpr u32 soundsCount = " ).append( static_cast<int>( sounds.size() ) ).append( ";\n" );
+		header.append( "\tconstexpr u32 soundBlockFrames = " ).append( static_cast<int>( SOUND_BLOCK_FRAMES ) ).append( ";\n" );
+		header.append( "\textern const DiskSound sounds[];\n" );
+		header.append( "}\n\n" );
+	}
+
+	// Source
+	{
+		// Group
+		assets_group( source );
+		source.append( "namespace Assets\n{\n" );
+
+		// Table (+1: never empty)
+		char buffer[PATH_SIZE];
+		source.append( "\tconst DiskSound sounds[soundsCount + 1] =\n\t{\n" );
+		for( Sound &sound : sounds )
+		{
+			snprintf( buffer, PATH_SIZE, "\t\t{ %llu, %u, %u, %u, %u, %u }, // %s\n",
+				static_cast<unsigned long long>( sound.offset ),
+				sound.frames,
+				sound.sampleRate,
+				sound.blockCount,
+				sound.blockSize,
+				sound.channels,
+				sound.name.c_str() );
+
+			source.append( buffer );
+		}
+		source.append( "\t\t{ 0, 0, 0, 0, 0, 0 },\n" );
+		source.append( "\t};\n" );
+		source.append( "}\n\n" );
+	}
+
+	if( verbose_output() )
+	{
+		const usize count = sounds.size();
+		PrintColor( LOG_CYAN, "\t\tWrote %d sound%s", count, count == 1 ? "" : "s" );
+		PrintLnColor( LOG_WHITE, " (%.3f ms)", timer.elapsed_ms() );
+	}
+}
@@ -1 +1,37 @@
-#pragma once
\ No newline at end of file
+#pragma once
+
+#include <types.hpp>
+
+#include <build/list.hpp>
+#include <build/string.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define SOUND_BLOCK_FRAMES ( 4096 ) // frames per independently decodable ADPCM block (must be even)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct Sound
+{
+	String name;
+	String path; // .wav (16-bit PCM, mono or stereo)
+	usize offset = 0;
+	u32 frames = 0;
+	u32 sampleRate = 0;
+	u32 blockCount = 0;
+	u32 blockSize = 0;
+	u8 channels = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct Sounds
+{
+	List<Sound> sounds;
+
+	void gather( const char *path, const bool recurse = true );
+	void load( const char *path );
+	void write();
+
+	inline Sound &operator[]( const u32 soundID ) { return sounds[soundID]; }
+};
@@ -64,6 +64,7 @@ void Sprites::load( const char *path )
 	ErrorIf( texture.length() == 0, "Sprite '%s' has an invalid texture (required)", path );
 	String atlas = spriteJSON.GetString( "atlas" );
 	ErrorIf( atlas.length() == 0, "Sprite '%s' has an invalid atlas texture (required)", path );
+	String compression = spriteJSON.GetString( "compression" );
 	int count = spriteJSON.GetInt( "count", 1 );
 	ErrorIf( count < 1, "Sprite '%s' has an invalid count", path );
 	int xorigin = spriteJSON.GetInt( "xorigin", 0 );
@@ -93,6 +94,7 @@ void Sprites::load( const char *path )
 
 	// Pack as atlas
 	sprite.textureID = Assets::textures.make_new( atlas );
+	if( compression.length() > 0 ) { Assets::textures[sprite.textureID].set_compression( compression, path ); }
 	sprite.glyphID = GLYPHID_MAX;
 
 	// Split sprite into individual glyphs
@@ -4,6 +4,8 @@
 #include <build/assets.hpp>
 #include <build/list.hpp>
 #include <build/fileio.hpp>
+#include <build/memory.hpp>
+#include <build/blockcompression.hpp>
 
 #include <vendor/math.hpp>
 
@@ -24,6 +26,21 @@ GlyphID Texture::add_glyph( Texture2DBuffer &&textureBuffer )
 }
 
 
+void Texture::set_compression( const String &value, const char *path )
+{
+	static const char *names[TEXTURECOMPRESSION_COUNT] = { "none", "bc1", "bc3", "auto" };
+
+	TextureCompression parsed = TEXTURECOMPRESSION_COUNT;
+	for( u8 i = 0; i < TEXTURECOMPRESSION_COUNT; i++ ) { if( value.equals( names[i] ) ) { parsed = i; } }
+	ErrorIf( parsed == TEXTURECOMPRESSION_COUNT, "%s: invalid compression '%s' (none, bc1, bc3, auto)", path, value.c_str() );
+
+	// Texture groups share one setting
+	ErrorIf( compression != TextureCompression_NONE && compression != parsed,
+		"%s: compression '%s' conflicts with texture '%s' (%s)", path, value.c_str(), name.c_str(), names[compression] );
+	compression = parsed;
+}
+
+
 struct Space
 {
 	Space( int x, int y, int w, int h ) : x(x), y(y), w(w), h(h) { }
@@ -81,11 +98,22 @@ static void quicksort_glyphs( GlyphID *low, GlyphID *high, const bool ascending
 }
 
 
+// Atlas glyph slots start on the coarsest mip grid and pad their glyph by one texel of that level
+static_assert( TEXTURE_ATLAS_MIP_LEVELS >= 1 && TEXTURE_ATLAS_MIP_LEVELS <= 6, "Atlas mip levels must fit a 32x32 page" );
+static constexpr int ATLAS_ALIGN = 1 << ( TEXTURE_ATLAS_MIP_LEVELS - 1 );
+static constexpr int ATLAS_PADDING = ATLAS_ALIGN;
+
+
+static int atlas_slot_size( const int size )
+{
+	return ( size + ATLAS_PADDING * 2 + ATLAS_ALIGN - 1 ) & ~( ATLAS_ALIGN - 1 );
+}
+
+
 void Texture::pack()
 {
 	// Starting size
 	u16 size = 32;
-	u8 padding = 1;
 
 	// Sort Glyphs
 	quicksort_glyphs( &glyphs[0], &glyphs[glyphs.size() - 1], false );
@@ -101,14 +129,15 @@ void Texture::pack()
 		for( GlyphID glyphID : glyphs )
 		{
 			Glyph &glyph = Assets::glyphs[glyphID];
+			const int slotWidth = atlas_slot_size( glyph.textureBuffer.width );
+			const int slotHeight = atlas_slot_size( glyph.textureBuffer.height );
 
 			// Loop over spaces back to front (smallest spaces are at the back of the list)
 			usize index = USIZE_MAX;
 			for( usize i = spaces.size(); i > 0; i-- )
 			{
 				Space &space = spaces[i-1];
-				if( space.w >= glyph.textureBuffer.width + padding * 2 &&
-					space.h >= glyph.textureBuffer.height + padding * 2 )
+				if( space.w >= slotWidth && space.h >= slotHeight )
 				{
 					// Found a suitable space!
 					index = i-1;
@@ -127,8 +156,8 @@ void Texture::pack()
 
 			// Found a space
 			Space &space = spaces[index];
-			glyph.x1 = space.x + padding;
-			glyph.y1 = space.y + padding;
+			glyph.x1 = space.x + ATLAS_PADDING;
+			glyph.y1 = space.y + ATLAS_PADDING;
 			glyph.x2 = glyph.x1 + glyph.textureBuffer.width;
 			glyph.y2 = glyph.y1 + glyph.textureBuffer.height;
 
@@ -138,10 +167,8 @@ void Texture::pack()
 			glyph.v2 = static_cast<u16>( glyph.y2 / static_cast<float>( size ) * 65536.0f );
 
 			// Split space
-			Space hSplit { space.x, space.y + glyph.textureBuffer.height + padding * 2,
-							space.w, space.h - glyph.textureBuffer.height - padding * 2 };
-			Space vSplit { space.x + glyph.textureBuffer.width + padding * 2, space.y,
-							space.w - glyph.textureBuffer.width - padding * 2, glyph.textureBuffer.height + padding * 2 };
+			Space hSplit { space.x, space.y + slotHeight, space.w, space.h - slotHeight };
+			Space vSplit { space.x + slotWidth, space.y, space.w - slotWidth, slotHeight };
 
 			// Remove space (swap back entry with index)
 			spaces.remove_swap( index );
@@ -165,6 +192,167 @@ void Texture::pack()
 success:
 	width = size;
 	height = size;
+	levels = TEXTURE_ATLAS_MIP_LEVELS;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void atlas_extrude( Texture2DBuffer &page, const Glyph &glyph )
+{
+	// Fill the glyph's slot with its clamped edge texels (mips & bilinear filtering then never reach the neighbours)
+	if( glyph.x2 == glyph.x1 || glyph.y2 == glyph.y1 ) { return; }
+	const int x1 = glyph.x1 - ATLAS_PADDING;
+	const int y1 = glyph.y1 - ATLAS_PADDING;
+	const int x2 = x1 + atlas_slot_size( glyph.x2 - glyph.x1 );
+	const int y2 = y1 + atlas_slot_size( glyph.y2 - glyph.y1 );
+
+	for( int y = y1; y < y2; y++ )
+	{
+		const int sy = y < glyph.y1 ? glyph.y1 : ( y >= glyph.y2 ? glyph.y2 - 1 : y );
+		for( int x = x1; x < x2; x++ )
+		{
+			const int sx = x < glyph.x1 ? glyph.x1 : ( x >= glyph.x2 ? glyph.x2 - 1 : x );
+			if( sx == x && sy == y ) { continue; }
+			page.data[y * page.width + x] = page.data[sy * page.width + sx];
+		}
+	}
+}
+
+
+static float srgbToLinear[256];
+
+
+static u8 linear_to_srgb( const float linear )
+{
+	const float srgb = linear <= 0.0031308f ? linear * 12.92f : 1.055f * powf( linear, 1.0f / 2.4f ) - 0.055f;
+	const int value = static_cast<int>( srgb * 255.0f + 0.5f );
+	return static_cast<u8>( value < 0 ? 0 : ( value > 255 ? 255 : value ) );
+}
+
+
+static void texture_downsample( const Texture2DBuffer &source, Texture2DBuffer &destination )
+{
+	// sRGB lookup table
+	if( srgbToLinear[255] == 0.0f )
+	{
+		for( int i = 0; i < 256; i++ )
+		{
+			const float srgb = i / 255.0f;
+			srgbToLinear[i] = srgb <= 0.04045f ? srgb / 12.92f : powf( ( srgb + 0.055f ) / 1.055f, 2.4f );
+		}
+	}
+
+	// 2x2 box filter in linear space; color is weighted by alpha so transparent texels don't darken edges
+	const u16 width = source.width > 1 ? source.width >> 1 : 1;
+	const u16 height = source.height > 1 ? source.height >> 1 : 1;
+	destination.init( width, height );
+
+	for( int y = 0; y < height; y++ )
+	{
+		for( int x = 0; x < width; x++ )
+		{
+			float r = 0.0f, g = 0.0f, b = 0.0f, a = 0.0f;
+			float rAverage = 0.0f, gAverage = 0.0f, bAverage = 0.0f;
+			for( int j = 0; j < 2; j++ )
+			{
+				const int sy = y * 2 + j < source.height ? y * 2 + j : source.height - 1;
+				for( int i = 0; i < 2; i++ )
+				{
+					const int sx = x * 2 + i < source.width ? x * 2 + i : source.width - 1;
+					const rgba &texel = source.data[sy * source.width + sx];
+					const float weight = texel.a / 255.0f;
+					r += srgbToLinear[texel.r] * weight;
+					g += srgbToLinear[texel.g] * weight;
+					b += srgbToLinear[texel.b] * weight;
+					a += weight;
+					rAverage += srgbToLinear[texel.r];
+					gAverage += srgbToLinear[texel.g];
+					bAverage += srgbToLinear[texel.b];
+				}
+			}
+
+			// Fully transparent blocks keep their plain average (bilinear filtering still blends into them)
+			if( a > 0.0f ) { r /= a; g /= a; b /= a; } else { r = rAverage * 0.25f; g = gAverage * 0.25f; b = bAverage * 0.25f; }
+			destination.data[y * width + x] = { linear_to_srgb( r ), linear_to_srgb( g ), linear_to_srgb( b ),
+				static_cast<u8>( a * 0.25f * 255.0f + 0.5f ) };
+		}
+	}
+}
+
+
+static TextureCompression texture_resolve_compression( const Texture &texture, const Texture2DBuffer &textureBuffer )
+{
+	// Block compression needs level 0 on the 4x4 grid (D3D11)
+	const bool aligned = ( textureBuffer.width % 4 ) == 0 && ( textureBuffer.height % 4 ) == 0;
+	if( texture.compression == TextureCompression_BC1 || texture.compression == TextureCompression_BC3 )
+	{
+		ErrorIf( !aligned, "Texture '%s' (%ux%u) must be a multiple of 4x4 for block compression",
+			texture.name.c_str(), textureBuffer.width, textureBuffer.height );
+		return texture.compression;
+	}
+
+	if( texture.compression != TextureCompression_AUTO || !aligned ) { return TextureCompression_NONE; }
+
+	// Alpha analysis
+	const usize count = static_cast<usize>( textureBuffer.width ) * static_cast<usize>( textureBuffer.height );
+	for( usize i = 0; i < count; i++ )
+	{
+		if( textureBuffer.data[i].a != 255 ) { return TextureCompression_BC3; }
+	}
+	return TextureCompression_BC1;
+}
+
+
+static usize texture_write_level( Buffer &binary, const Texture2DBuffer &level, const TextureCompression compression, byte *scratch )
+{
+	if( compression == TextureCompression_NONE )
+	{
+		binary.write( level.data, level.width * level.height * sizeof( rgba ) );
+		return level.width * level.height * sizeof( rgba );
+	}
+
+	const bool alpha = ( compression == TextureCompression_BC3 );
+	const usize size = bc_size_bytes( level.width, level.height, alpha );
+	bc_encode( level, scratch, alpha );
+	binary.write( scratch, size );
+	return size;
+}
+
+
+static usize texture_write_levels( Buffer &binary, Texture &texture, Texture2DBuffer &textureBuffer )
+{
+	texture.compression = texture_resolve_compression( texture, textureBuffer );
+	byte *scratch = nullptr;
+	if( texture.compression != TextureCompression_NONE )
+	{
+		scratch = reinterpret_cast<byte *>( memory_alloc( bc_size_bytes( textureBuffer.width, textureBuffer.height, true ) ) );
+	}
+
+	// Level 0 followed by each successive half-resolution level (mips filter the uncompressed level above)
+	usize sizeBytes = texture_write_level( binary, textureBuffer, texture.compression, scratch );
+
+	Texture2DBuffer level;
+	Texture2DBuffer previous;
+	for( u16 i = 1; i < texture.levels; i++ )
+	{
+		texture_downsample( i == 1 ? textureBuffer : previous, level );
+		sizeBytes += texture_write_level( binary, level, texture.compression, scratch );
+		previous = static_cast<Texture2DBuffer &&>( level );
+	}
+
+	// Round-trip quality
+	if( texture.compression != TextureCompression_NONE && verbose_output() )
+	{
+		const bool alpha = ( texture.compression == TextureCompression_BC3 );
+		Texture2DBuffer decoded;
+		bc_encode( textureBuffer, scratch, alpha );
+		bc_decode( scratch, textureBuffer.width, textureBuffer.height, alpha, decoded );
+		PrintLnColor( LOG_WHITE, "\t\t\t%s: BC%d (PSNR %.2f dB)", texture.name.c_str(), alpha ? 3 : 1,
+			bc_psnr( textureBuffer, decoded, alpha ) );
+	}
+
+	if( scratch != nullptr ) { memory_free( scratch ); }
+	return sizeBytes;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -226,10 +414,11 @@ void Textures::write()
 					textureBuffer.splice( glyph.textureBuffer, 0, 0, glyph.textureBuffer.width, glyph.textureBuffer.height, glyph.x1, glyph.y1 );
 				}
 
-				// Write Binary
+				for( GlyphID glyphID : texture.glyphs ) { atlas_extrude( textureBuffer, Assets::glyphs[glyphID] ); }
+
+				// Write Binary (mip chain)
 				texture.offset = binary.tell;
-				binary.write( textureBuffer.data, texture.width * texture.height * sizeof( rgba ) );
-				sizeBytes += texture.width * texture.height * sizeof( rgba );
+				sizeBytes += texture_write_levels( binary, texture, textureBuffer );
 
 				char path[PATH_SIZE];
 				strjoin( path, Build::pathOutput, SLASH "generated" SLASH, ( texture.name + "_atlas.png" ).c_str() );
@@ -242,10 +431,16 @@ void Textures::write()
 				texture.width = glyph.textureBuffer.width;
 				texture.height = glyph.textureBuffer.height;
 
-				// Write Binary
+				// Full mip chain (down to 1x1)
+				texture.levels = 1;
+				for( u16 size = texture.width > texture.height ? texture.width : texture.height; size > 1; size >>= 1 )
+				{
+					texture.levels++;
+				}
+
+				// Write Binary (mip chain)
 				texture.offset = binary.tell;
-				binary.write( glyph.textureBuffer.data, texture.width * texture.height * sizeof( rgba ) );
-				sizeBytes += texture.width * texture.height * sizeof( rgba );
+				sizeBytes += texture_write_levels( binary, texture, glyph.textureBuffer );
 
 				#if 0
 					char path[PATH_SIZE];
@@ -270,7 +465,9 @@ void Textures::write()
 			"DiskTexture",
 			"u32 offset;",
 			"u16 width;",
-			"u16 height;" );
+			"u16 height;",
+			"u16 levels;",
+			"u8 compression;" );
 
 		// Table
 		header.append( "namespace Assets\n{\n" );
@@ -290,10 +487,12 @@ void Textures::write()
 		char buffer[PATH_SIZE];
 		for( Texture &texture : textures )
 		{
-			snprintf( buffer, PATH_SIZE, "\t\t{ %llu, %u, %u },\n",
+			snprintf( buffer, PATH_SIZE, "\t\t{ %llu, %u, %u, %u, %u },\n",
 				texture.offset,
 				texture.width,
-				texture.height );
+				texture.height,
+				texture.levels,
+				texture.compression );
 
 			source.append( buffer );
 		}
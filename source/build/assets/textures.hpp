@@ -11,6 +11,25 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Mip levels stored per atlas page (level 0 included). Glyphs are packed on a 2^(levels - 1) grid with as much
+// edge-extruded padding, so every level keeps at least one texel of padding and never filters across glyphs.
+// Independent textures store their full chain down to 1x1.
+#define TEXTURE_ATLAS_MIP_LEVELS ( 4 )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Set per texture group by the "compression" key of .sprite / .material files ("none", "bc1", "bc3", "auto")
+enum_type( TextureCompression, u8 )
+{
+	TextureCompression_NONE = 0, // RGBA8
+	TextureCompression_BC1,      // Opaque (alpha is discarded)
+	TextureCompression_BC3,      // Interpolated alpha
+	TextureCompression_AUTO,     // BC1 if every texel is opaque, otherwise BC3 (falls back to NONE off the 4x4 grid)
+	TEXTURECOMPRESSION_COUNT,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 struct Texture
 {
 	Texture( String name ) : name( name ) { }
@@ -19,10 +38,13 @@ struct Texture
 	usize offset;
 	u16 width = 0;
 	u16 height = 0;
+	u16 levels = 1;
+	TextureCompression compression = TextureCompression_NONE;
 
 	bool atlasTexture = true;
 	List<GlyphID> glyphs;
 	GlyphID add_glyph( Texture2DBuffer &&textureBuffer );
+	void set_compression( const String &value, const char *path );
 	void pack();
 };
 
@@ -0,0 +1,494 @@
+#include <build/blockcompression.hpp>
+
+#include <debug.hpp>
+
+#include <vendor/math.hpp>
+
+#if PIPELINE_OS_WINDOWS
+	#include <vendor/windows.hpp>
+#else
+	#include <vendor/pthread.hpp>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static u16 rgb565_pack( const float r, const float g, const float b )
+{
+	const int r5 = static_cast<int>( r * ( 31.0f / 255.0f ) + 0.5f );
+	const int g6 = static_cast<int>( g * ( 63.0f / 255.0f ) + 0.5f );
+	const int b5 = static_cast<int>( b * ( 31.0f / 255.0f ) + 0.5f );
+	return static_cast<u16>( ( ( r5 < 0 ? 0 : ( r5 > 31 ? 31 : r5 ) ) << 11 ) |
+	                         ( ( g6 < 0 ? 0 : ( g6 > 63 ? 63 : g6 ) ) << 5 ) |
+	                         ( ( b5 < 0 ? 0 : ( b5 > 31 ? 31 : b5 ) ) ) );
+}
+
+
+static rgba rgb565_unpack( const u16 color )
+{
+	const u8 r5 = ( color >> 11 ) & 31;
+	const u8 g6 = ( color >> 5 ) & 63;
+	const u8 b5 = color & 31;
+	return { static_cast<u8>( ( r5 << 3 ) | ( r5 >> 2 ) ), static_cast<u8>( ( g6 << 2 ) | ( g6 >> 4 ) ),
+	         static_cast<u8>( ( b5 << 3 ) | ( b5 >> 2 ) ), 255 };
+}
+
+
+static void bc1_palette( const u16 color0, const u16 color1, const bool opaque, rgba *palette )
+{
+	const rgba c0 = rgb565_unpack( color0 );
+	const rgba c1 = rgb565_unpack( color1 );
+	palette[0] = c0;
+	palette[1] = c1;
+
+	// 4-color mode (BC3 color blocks are always 4-color)
+	if( color0 > color1 || opaque )
+	{
+		palette[2] = { static_cast<u8>( ( 2 * c0.r + c1.r + 1 ) / 3 ), static_cast<u8>( ( 2 * c0.g + c1.g + 1 ) / 3 ),
+		               static_cast<u8>( ( 2 * c0.b + c1.b + 1 ) / 3 ), 255 };
+		palette[3] = { static_cast<u8>( ( c0.r + 2 * c1.r + 1 ) / 3 ), static_cast<u8>( ( c0.g + 2 * c1.g + 1 ) / 3 ),
+		               static_cast<u8>( ( c0.b + 2 * c1.b + 1 ) / 3 ), 255 };
+	}
+	// 3-color mode + transparent black
+	else
+	{
+		palette[2] = { static_cast<u8>( ( c0.r + c1.r + 1 ) / 2 ), static_cast<u8>( ( c0.g + c1.g + 1 ) / 2 ),
+		               static_cast<u8>( ( c0.b + c1.b + 1 ) / 2 ), 255 };
+		palette[3] = { 0, 0, 0, 0 };
+	}
+}
+
+
+static void bc3_alpha_palette( const u8 alpha0, const u8 alpha1, u8 *palette )
+{
+	palette[0] = alpha0;
+	palette[1] = alpha1;
+
+	// 8-alpha mode
+	if( alpha0 > alpha1 )
+	{
+		for( int i = 1; i < 7; i++ ) { palette[i + 1] = static_cast<u8>( ( ( 7 - i ) * alpha0 + i * alpha1 + 3 ) / 7 ); }
+	}
+	// 6-alpha mode + explicit 0 & 255
+	else
+	{
+		for( int i = 1; i < 5; i++ ) { palette[i + 1] = static_cast<u8>( ( ( 5 - i ) * alpha0 + i * alpha1 + 2 ) / 5 ); }
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static int color_distance( const rgba &a, const rgba &b )
+{
+	const int r = a.r - b.r;
+	const int g = a.g - b.g;
+	const int b_ = a.b - b.b;
+	return r * r + g * g + b_ * b_;
+}
+
+
+static u32 bc1_fit_indices( const rgba *texels, const bool *mask, const u16 color0, const u16 color1, u32 &indices )
+{
+	// Nearest palette entry per texel; returns the squared error over masked texels
+	rgba palette[4];
+	bc1_palette( color0, color1, true, palette );
+
+	u32 error = 0;
+	indices = 0;
+	for( int i = 0; i < 16; i++ )
+	{
+		int best = 0;
+		int bestDistance = color_distance( texels[i], palette[0] );
+		for( int p = 1; p < 4; p++ )
+		{
+			const int distance = color_distance( texels[i], palette[p] );
+			if( distance < bestDistance ) { best = p; bestDistance = distance; }
+		}
+
+		indices |= static_cast<u32>( best ) << ( i * 2 );
+		if( mask[i] ) { error += static_cast<u32>( bestDistance ); }
+	}
+
+	return error;
+}
+
+
+static bool bc1_refine( const rgba *texels, const bool *mask, const u32 indices, u16 &color0, u16 &color1 )
+{
+	// Least-squares endpoints for fixed indices (weights of color0: 1, 0, 2/3, 1/3)
+	static const float weights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+	float alpha2 = 0.0f, beta2 = 0.0f, alphaBeta = 0.0f;
+	float alphaX[3] = { 0.0f, 0.0f, 0.0f };
+	float betaX[3] = { 0.0f, 0.0f, 0.0f };
+
+	for( int i = 0; i < 16; i++ )
+	{
+		if( !mask[i] ) { continue; }
+		const float a = weights[( indices >> ( i * 2 ) ) & 3];
+		const float b = 1.0f - a;
+		const float x[3] = { static_cast<float>( texels[i].r ), static_cast<float>( texels[i].g ), static_cast<float>( texels[i].b ) };
+		alpha2 += a * a;
+		beta2 += b * b;
+		alphaBeta += a * b;
+		for( int c = 0; c < 3; c++ ) { alphaX[c] += a * x[c]; betaX[c] += b * x[c]; }
+	}
+
+	const float determinant = alpha2 * beta2 - alphaBeta * alphaBeta;
+	if( abs( determinant ) < 1e-6f ) { return false; }
+	const float inverse = 1.0f / determinant;
+
+	float e0[3], e1[3];
+	for( int c = 0; c < 3; c++ )
+	{
+		e0[c] = ( alphaX[c] * beta2 - betaX[c] * alphaBeta ) * inverse;
+		e1[c] = ( betaX[c] * alpha2 - alphaX[c] * alphaBeta ) * inverse;
+	}
+
+	color0 = rgb565_pack( e0[0], e0[1], e0[2] );
+	color1 = rgb565_pack( e1[0], e1[1], e1[2] );
+	return true;
+}
+
+
+static void bc_encode_color( const rgba *texels, byte *block, const bool ignoreTransparent )
+{
+	// Texels that contribute to the fit (BC3 skips fully transparent texels -- their color is never seen)
+	bool mask[16];
+	int count = 0;
+	for( int i = 0; i < 16; i++ ) { mask[i] = !ignoreTransparent || texels[i].a > 0; count += mask[i]; }
+	if( count == 0 ) { for( int i = 0; i < 16; i++ ) { mask[i] = true; } count = 16; }
+
+	// Mean & covariance
+	float mean[3] = { 0.0f, 0.0f, 0.0f };
+	for( int i = 0; i < 16; i++ )
+	{
+		if( !mask[i] ) { continue; }
+		mean[0] += texels[i].r; mean[1] += texels[i].g; mean[2] += texels[i].b;
+	}
+	for( int c = 0; c < 3; c++ ) { mean[c] /= count; }
+
+	float covariance[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+	for( int i = 0; i < 16; i++ )
+	{
+		if( !mask[i] ) { continue; }
+		const float r = texels[i].r - mean[0];
+		const float g = texels[i].g - mean[1];
+		const float b = texels[i].b - mean[2];
+		covariance[0] += r * r; covariance[1] += r * g; covariance[2] += r * b;
+		covariance[3] += g * g; covariance[4] += g * b; covariance[5] += b * b;
+	}
+
+	// Principal axis (power iteration, seeded with the covariance column of the widest channel)
+	const int seed = covariance[0] >= covariance[3] ? ( covariance[0] >= covariance[5] ? 0 : 2 ) : ( covariance[3] >= covariance[5] ? 1 : 2 );
+	float axis[3] =
+	{
+		seed == 0 ? covariance[0] : ( seed == 1 ? covariance[1] : covariance[2] ),
+		seed == 0 ? covariance[1] : ( seed == 1 ? covariance[3] : covariance[4] ),
+		seed == 0 ? covariance[2] : ( seed == 1 ? covariance[4] : covariance[5] ),
+	};
+	for( int iteration = 0; iteration < 8; iteration++ )
+	{
+		const float x = covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2];
+		const float y = covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2];
+		const float z = covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2];
+		const float length = sqrtf( x * x + y * y + z * z );
+		if( length < 1e-6f ) { break; }
+		axis[0] = x / length; axis[1] = y / length; axis[2] = z / length;
+	}
+
+	// Extents along the axis (inset by 1/16 to favor the interpolated entries)
+	float tMin = 0.0f, tMax = 0.0f;
+	for( int i = 0; i < 16; i++ )
+	{
+		if( !mask[i] ) { continue; }
+		const float t = ( texels[i].r - mean[0] ) * axis[0] + ( texels[i].g - mean[1] ) * axis[1] + ( texels[i].b - mean[2] ) * axis[2];
+		tMin = t < tMin ? t : tMin;
+		tMax = t > tMax ? t : tMax;
+	}
+	const float inset = ( tMax - tMin ) / 16.0f;
+	tMin += inset;
+	tMax -= inset;
+
+	u16 color0 = rgb565_pack( mean[0] + axis[0] * tMax, mean[1] + axis[1] * tMax, mean[2] + axis[2] * tMax );
+	u16 color1 = rgb565_pack( mean[0] + axis[0] * tMin, mean[1] + axis[1] * tMin, mean[2] + axis[2] * tMin );
+	u32 indices;
+	u32 error = bc1_fit_indices( texels, mask, color0, color1, indices );
+
+	// Refine endpoints
+	for( int iteration = 0; iteration < 2 && error > 0; iteration++ )
+	{
+		u16 refined0, refined1;
+		if( !bc1_refine( texels, mask, indices, refined0, refined1 ) ) { break; }
+		u32 refinedIndices;
+		const u32 refinedError = bc1_fit_indices( texels, mask, refined0, refined1, refinedIndices );
+		if( refinedError >= error ) { break; }
+		color0 = refined0;
+		color1 = refined1;
+		indices = refinedIndices;
+		error = refinedError;
+	}
+
+	// 4-color mode requires color0 > color1 (swap endpoints & remap indices: 0 <-> 1, 2 <-> 3)
+	if( color0 < color1 )
+	{
+		const u16 swap = color0; color0 = color1; color1 = swap;
+		indices ^= 0x55555555;
+	}
+	else if( color0 == color1 )
+	{
+		indices = 0;
+	}
+
+	block[0] = static_cast<byte>( color0 );
+	block[1] = static_cast<byte>( color0 >> 8 );
+	block[2] = static_cast<byte>( color1 );
+	block[3] = static_cast<byte>( color1 >> 8 );
+	for( int i = 0; i < 4; i++ ) { block[4 + i] = static_cast<byte>( indices >> ( i * 8 ) ); }
+}
+
+
+static u32 bc3_fit_alpha( const rgba *texels, const u8 alpha0, const u8 alpha1, u64 &indices )
+{
+	u8 palette[8];
+	bc3_alpha_palette( alpha0, alpha1, palette );
+
+	u32 error = 0;
+	indices = 0;
+	for( int i = 0; i < 16; i++ )
+	{
+		int best = 0;
+		int bestDistance = 256 * 256;
+		for( int p = 0; p < 8; p++ )
+		{
+			const int distance = ( texels[i].a - palette[p] ) * ( texels[i].a - palette[p] );
+			if( distance < bestDistance ) { best = p; bestDistance = distance; }
+		}
+
+		indices |= static_cast<u64>( best ) << ( i * 3 );
+		error += static_cast<u32>( bestDistance );
+	}
+
+	return error;
+}
+
+
+static void bc3_encode_alpha( const rgba *texels, byte *block )
+{
+	// Alpha range (including & excluding the values 6-alpha mode stores explicitly)
+	u8 alphaMin = 255, alphaMax = 0;
+	u8 innerMin = 255, innerMax = 0;
+	for( int i = 0; i < 16; i++ )
+	{
+		const u8 alpha = texels[i].a;
+		alphaMin = alpha < alphaMin ? alpha : alphaMin;
+		alphaMax = alpha > alphaMax ? alpha : alphaMax;
+		if( alpha == 0 || alpha == 255 ) { continue; }
+		innerMin = alpha < innerMin ? alpha : innerMin;
+		innerMax = alpha > innerMax ? alpha : innerMax;
+	}
+	if( innerMin > innerMax ) { innerMin = 0; innerMax = 255; }
+
+	// 8-alpha mode (alpha0 > alpha1) vs. 6-alpha mode (alpha0 <= alpha1)
+	u8 alpha0 = alphaMax, alpha1 = alphaMin;
+	u64 indices;
+	const u32 error = bc3_fit_alpha( texels, alpha0, alpha1, indices );
+	if( error > 0 )
+	{
+		u64 indicesInner;
+		const u32 errorInner = bc3_fit_alpha( texels, innerMin, innerMax, indicesInner );
+		if( errorInner < error ) { alpha0 = innerMin; alpha1 = innerMax; indices = indicesInner; }
+	}
+
+	block[0] = alpha0;
+	block[1] = alpha1;
+	for( int i = 0; i < 6; i++ ) { block[2 + i] = static_cast<byte>( indices >> ( i * 8 ) ); }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void bc1_encode_block( const rgba *texels, byte *block )
+{
+	bc_encode_color( texels, block, false );
+}
+
+
+void bc3_encode_block( const rgba *texels, byte *block )
+{
+	bc3_encode_alpha( texels, block );
+	bc_encode_color( texels, block + 8, true );
+}
+
+
+static void bc_decode_color( const byte *block, rgba *texels, const bool opaque )
+{
+	const u16 color0 = static_cast<u16>( block[0] | ( block[1] << 8 ) );
+	const u16 color1 = static_cast<u16>( block[2] | ( block[3] << 8 ) );
+	const u32 indices = static_cast<u32>( block[4] | ( block[5] << 8 ) | ( block[6] << 16 ) | ( block[7] << 24 ) );
+
+	rgba palette[4];
+	bc1_palette( color0, color1, opaque, palette );
+	for( int i = 0; i < 16; i++ ) { texels[i] = palette[( indices >> ( i * 2 ) ) & 3]; }
+}
+
+
+void bc1_decode_block( const byte *block, rgba *texels )
+{
+	bc_decode_color( block, texels, false );
+}
+
+
+void bc3_decode_block( const byte *block, rgba *texels )
+{
+	bc_decode_color( block + 8, texels, true );
+
+	u8 palette[8];
+	bc3_alpha_palette( block[0], block[1], palette );
+	u64 indices = 0;
+	for( int i = 0; i < 6; i++ ) { indices |= static_cast<u64>( block[2 + i] ) << ( i * 8 ); }
+	for( int i = 0; i < 16; i++ ) { texels[i].a = palette[( indices >> ( i * 3 ) ) & 7]; }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+usize bc_size_bytes( const u16 width, const u16 height, const bool alpha )
+{
+	const usize blocks = static_cast<usize>( ( width + 3 ) / 4 ) * static_cast<usize>( ( height + 3 ) / 4 );
+	return blocks * ( alpha ? BC3_BLOCK_SIZE : BC1_BLOCK_SIZE );
+}
+
+
+struct BlockCompressionJob
+{
+	const Texture2DBuffer *texture;
+	byte *output;
+	u32 rowFirst;
+	u32 rowLast;
+	bool alpha;
+};
+
+
+static void bc_encode_rows( const BlockCompressionJob &job )
+{
+	const Texture2DBuffer &texture = *job.texture;
+	const u32 blocksX = ( texture.width + 3 ) / 4;
+	const usize blockSize = job.alpha ? BC3_BLOCK_SIZE : BC1_BLOCK_SIZE;
+
+	rgba texels[16];
+
+	for( u32 blockY = job.rowFirst; blockY < job.rowLast; blockY++ )
+	{
+		for( u32 blockX = 0; blockX < blocksX; blockX++ )
+		{
+			// Gather 4x4 texels (edge blocks clamp)
+			for( u32 y = 0; y < 4; y++ )
+			{
+				const u32 texelY = blockY * 4 + y < texture.height ? blockY * 4 + y : texture.height - 1;
+				for( u32 x = 0; x < 4; x++ )
+				{
+					const u32 texelX = blockX * 4 + x < texture.width ? blockX * 4 + x : texture.width - 1;
+					texels[y * 4 + x] = texture.data[texelY * texture.width + texelX];
+				}
+			}
+
+			byte *block = job.output + ( blockY * blocksX + blockX ) * blockSize;
+			if( job.alpha ) { bc3_encode_block( texels, block ); } else { bc1_encode_block( texels, block ); }
+		}
+	}
+}
+
+
+#if PIPELINE_OS_WINDOWS
+static DWORD STD_CALL bc_encode_thread( void *job )
+{
+	bc_encode_rows( *reinterpret_cast<BlockCompressionJob *>( job ) );
+	return 0;
+}
+#else
+static void *bc_encode_thread( void *job )
+{
+	bc_encode_rows( *reinterpret_cast<BlockCompressionJob *>( job ) );
+	return nullptr;
+}
+#endif
+
+
+void bc_encode( const Texture2DBuffer &texture, byte *output, const bool alpha )
+{
+	Assert( texture.data != nullptr );
+	const u32 blocksY = ( texture.height + 3 ) / 4;
+
+	// Split block rows across threads (small images encode inline)
+	const u32 threads = blocksY >= BLOCK_COMPRESSION_THREADS * 4 ? BLOCK_COMPRESSION_THREADS : 1;
+	BlockCompressionJob jobs[BLOCK_COMPRESSION_THREADS];
+	for( u32 i = 0; i < threads; i++ )
+	{
+		jobs[i] = { &texture, output, blocksY * i / threads, blocksY * ( i + 1 ) / threads, alpha };
+	}
+
+	if( threads == 1 ) { bc_encode_rows( jobs[0] ); return; }
+
+#if PIPELINE_OS_WINDOWS
+	HANDLE handles[BLOCK_COMPRESSION_THREADS];
+	for( u32 i = 0; i < threads; i++ )
+	{
+		handles[i] = CreateThread( nullptr, 0, bc_encode_thread, &jobs[i], 0, nullptr );
+		ErrorIf( handles[i] == nullptr, "Failed to create block compression thread" );
+	}
+	for( u32 i = 0; i < threads; i++ ) { WaitForSingleObject( handles[i], INFINITE ); CloseHandle( handles[i] ); }
+#else
+	pthread_t handles[BLOCK_COMPRESSION_THREADS];
+	for( u32 i = 0; i < threads; i++ )
+	{
+		ErrorIf( pthread_create( &handles[i], nullptr, bc_encode_thread, &jobs[i] ) != 0, "Failed to create block compression thread" );
+	}
+	for( u32 i = 0; i < threads; i++ ) { pthread_join( handles[i], nullptr ); }
+#endif
+}
+
+
+void bc_decode( const byte *data, const u16 width, const u16 height, const bool alpha, Texture2DBuffer &texture )
+{
+	texture.init( width, height );
+	const u32 blocksX = ( width + 3 ) / 4;
+	const u32 blocksY = ( height + 3 ) / 4;
+	const usize blockSize = alpha ? BC3_BLOCK_SIZE : BC1_BLOCK_SIZE;
+
+	rgba texels[16];
+
+	for( u32 blockY = 0; blockY < blocksY; blockY++ )
+	{
+		for( u32 blockX = 0; blockX < blocksX; blockX++ )
+		{
+			const byte *block = data + ( blockY * blocksX + blockX ) * blockSize;
+			if( alpha ) { bc3_decode_block( block, texels ); } else { bc1_decode_block( block, texels ); }
+
+			for( u32 y = 0; y < 4 && blockY * 4 + y < height; y++ )
+			{
+				for( u32 x = 0; x < 4 && blockX * 4 + x < width; x++ )
+				{
+					texture.data[( blockY * 4 + y ) * width + blockX * 4 + x] = texels[y * 4 + x];
+				}
+			}
+		}
+	}
+}
+
+
+double bc_psnr( const Texture2DBuffer &a, const Texture2DBuffer &b, const bool alpha )
+{
+	Assert( a.width == b.width && a.height == b.height );
+	const usize count = static_cast<usize>( a.width ) * static_cast<usize>( a.height );
+
+	double error = 0.0;
+	double samples = 0.0;
+	for( usize i = 0; i < count; i++ )
+	{
+		// Color under fully transparent texels ('a') is never seen (BC3 doesn't encode it)
+		if( !alpha || a.data[i].a > 0 ) { error += color_distance( a.data[i], b.data[i] ); samples += 3.0; }
+		if( alpha ) { const int d = a.data[i].a - b.data[i].a; error += d * d; samples += 1.0; }
+	}
+
+	const double mse = error / samples;
+	return mse <= 0.0 ? 99.0 : 10.0 * log10( 255.0 * 255.0 / mse );
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <types.hpp>
+
+#include <build/color.hpp>
+#include <build/textureio.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// BC1 (DXT1) & BC3 (DXT5) block compression
+//
+// Textures are split into 4x4 texel blocks (edge blocks clamp). BC1 stores two RGB565 endpoints and 2-bit indices
+// (8 bytes per block, opaque); BC3 prefixes each BC1 color block with two 8-bit alpha endpoints and 3-bit indices
+// (16 bytes per block). Blocks are encoded independently into fixed output slots, so the output is identical
+// regardless of how the rows are split across BLOCK_COMPRESSION_THREADS.
+
+#define BLOCK_COMPRESSION_THREADS ( 8 )
+
+#define BC1_BLOCK_SIZE ( 8 )
+#define BC3_BLOCK_SIZE ( 16 )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+extern void bc1_encode_block( const rgba *texels, byte *block );
+extern void bc3_encode_block( const rgba *texels, byte *block );
+extern void bc1_decode_block( const byte *block, rgba *texels );
+extern void bc3_decode_block( const byte *block, rgba *texels );
+
+// Size of a 'width' x 'height' image in BC1 ('alpha' false) or BC3 ('alpha' true)
+extern usize bc_size_bytes( const u16 width, const u16 height, const bool alpha );
+
+// 'output' must hold bc_size_bytes() bytes
+extern void bc_encode( const Texture2DBuffer &texture, byte *output, const bool alpha );
+
+// Decodes into 'texture' (initialized to 'width' x 'height')
+extern void bc_decode( const byte *data, const u16 width, const u16 height, const bool alpha, Texture2DBuffer &texture );
+
+// Peak signal-to-noise ratio (dB) over RGB (and A if 'alpha', skipping the color of texels transparent in 'a');
+// identical textures return 99.0
+extern double bc_psnr( const Texture2DBuffer &a, const Texture2DBuffer &b, const bool alpha );
@@ -415,7 +415,8 @@ void BuilderCore::assets_gather()
 	Assets::meshes.gather( Build::pathProject );
 
 	// Gather Sounds
-	// ...
+	Assets::sounds.gather( Build::pathEngine );
+	Assets::sounds.gather( Build::pathProject );
 }
 
 
@@ -457,6 +458,9 @@ void BuilderCore::assets_build()
 
 	// Write Meshes
 	Assets::meshes.write();
+
+	// Write Sounds
+	Assets::sounds.write();
 }
 
 
@@ -613,6 +617,7 @@ void BuilderCore::compile_engine()
 			// Audio | -r source/manta/backend/audio/*.cpp
 			strjoin( path, Build::pathEngine, SLASH "manta" SLASH "backend" SLASH "audio" SLASH, BACKEND_AUDIO );
 			ErrorIf( Build::compile_add_sources( path, group, true ) == 0, "No backend found for 'audio' (%s)", path );
+			if( AUDIO_ALSA ) { Build::compile_add_library( "asound" ); }
 
 			// Filesystem | -r source/manta/backend/filesystem/*.cpp
 			strjoin( path, Build::pathEngine, SLASH "manta" SLASH "backend" SLASH "filesystem" SLASH, BACKEND_FILESYSTEM );
@@ -621,6 +626,7 @@ void BuilderCore::compile_engine()
 			// Network | -r source/manta/backend/network/*.cpp
 			strjoin( path, Build::pathEngine, SLASH "manta" SLASH "backend" SLASH "network" SLASH, BACKEND_NETWORK );
 			ErrorIf( Build::compile_add_sources( path, group, true ) == 0, "No backend found for 'network' (%s)", path );
+			if( OS_WINDOWS ) { Build::compile_add_library( "ws2_32" ); }
 
 			// Grahpics | -r source/manta/backend/gfx/*.cpp
 			strjoin( path, Build::pathEngine, SLASH "manta" SLASH "backend" SLASH "gfx" SLASH, BACKEND_GRAPHICS );
@@ -667,6 +673,7 @@ void BuilderCore::compile_engine()
 			// Thread | -r source/manta/backend/thread/*.cpp
 			strjoin( path, Build::pathEngine, SLASH "manta" SLASH "backend" SLASH "thread" SLASH, BACKEND_THREAD );
 			ErrorIf( Build::compile_add_sources( path, group, true ) == 0, "No backend found for 'thread' (%s)", path );
+			if( OS_LINUX ) { Build::compile_add_library( "pthread" ); }
 
 			// Time | -r source/manta/backend/time/*.cpp
 			strjoin( path, Build::pathEngine, SLASH "manta" SLASH "backend" SLASH "time" SLASH, BACKEND_TIMER );
@@ -6,6 +6,7 @@
 
 struct rgba
 {
+	rgba() : r(0), g(0), b(0), a(0) { }
 	rgba( u8 r, u8 g, u8 b, u8 a ) : r(r), g(g), b(b), a(a) { }
 	inline bool operator==( const rgba &other ) const { return r == other.r && g == other.g && b == other.b && a == other.a; }
 
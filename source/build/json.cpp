@@ -1,338 +1,354 @@
 #include <build/json.hpp>
 
+#include <build/memory.hpp>
+
 #include <vendor/string.hpp>
 #include <vendor/stdlib.hpp>
+#include <vendor/new.hpp>
 
 #include <debug.hpp>
 #include <types.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-static usize find_element_key( const String &buffer, const char *key, usize start = 0, usize end = USIZE_MAX )
+static usize skip_whitespace( const String &buffer, usize i )
 {
-	bool inQuotes = false;
-	int depthBraces = 0;
-	int depthBrackets = 0;
-
-	for( usize i = start; i < end; i++ )
-	{
-		// Length check / null terminator
-		if( i >= buffer.length() || buffer[i] == '\0' ) { break; }
-
-		// Find Key / Skip Quotes
-		if( depthBraces == 0 && depthBrackets == 0 )
-		{
-			if( buffer[i] == '"' && ( i == 0 || buffer[i-1] != '\\' ) )
-			{
-				if( inQuotes ) { inQuotes = false; continue; }
-				if( buffer.contains_at( key, i + 1 ) && buffer.contains_at( "\":", i + 1 + strlen( key ) ) ) { return i + strlen( key ) + 3; }
-				inQuotes = true;
-			}
-			if( inQuotes ) { continue; }
-		}
-
-		// Process Braces/Brackets
-		if( buffer[i] == '}' ) { if( depthBraces > 0 ) { depthBraces--; } else { break; } }
-		if( buffer[i] == ']' ) { if( depthBrackets > 0 ) { depthBrackets--; } else { break; } }
-		if( buffer[i] == '{' ) { depthBraces++; continue; }
-		if( buffer[i] == '[' ) { depthBrackets++; continue; }
-	}
-
-	// Failure
-	return USIZE_MAX;
+	while( i < buffer.length() && char_whitespace( buffer[i], true ) ) { i++; }
+	return i;
 }
 
-static usize find_element_index( const String &buffer, const usize index, usize start = 0, usize end = USIZE_MAX )
-{
-	bool inQuotes = false;
-	int depthBraces = 0;
-	int depthBrackets = 0;
 
-	usize last = start;
-	usize count = 0;
-	for( usize i = start; i < end; i++ )
+static usize skip_string( const String &buffer, usize i )
+{
+	// 'i' is the opening quote -- returns the closing quote
+	for( i++; i < buffer.length(); i++ )
 	{
-		// Length check / null terminator
-		if( i >= buffer.length() || buffer[i] == '\0' ) { break; }
-
-		// Skip quotes
-		if( buffer[i] == '"' && ( i == 0 || buffer[i-1] != '\\' ) ) { inQuotes = !inQuotes; }
-		if( inQuotes ) { continue; }
-
-		// Process Braces/Brackets
-		if( buffer[i] == '{' ) { depthBraces++; continue; }
-		if( buffer[i] == '[' ) { depthBrackets++; continue; }
-		if( buffer[i] == '}' ) { if( depthBraces > 0 ) { depthBraces--; } else { break; } }
-		if( buffer[i] == ']' ) { if( depthBrackets > 0 ) { depthBrackets--; } else { break; } }
-		if( depthBraces > 0 || depthBrackets > 0 ) { continue; }
-
-		// Process ',' delimiter
-		if( buffer[i] == ',' )
-		{
-			if( count == index ) { return last; }
-			last = i + 1;
-			count++;
-		}
+		if( buffer[i] == '\\' ) { i++; continue; }
+		if( buffer[i] == '"' ) { return i; }
 	}
 
-	// Failure
-	return count == index ? last : USIZE_MAX;
+	AssertMsg( false, "JSON has an unterminated string\n\nJSON:\n%s", buffer.c_str() );
+	return buffer.length();
 }
 
-static usize find_element_delimiter( const String &buffer, usize start = 0, usize end = USIZE_MAX )
-{
-	bool inQuotes = false;
-	int depthBraces = 0;
-	int depthBrackets = 0;
 
-	for( usize i = start; i < end; i++ )
+static usize skip_primitive( const String &buffer, usize i )
+{
+	while( i < buffer.length() )
 	{
-		// Length check / null terminator
-		if( i >= buffer.length() || buffer[i] == '\0' ) { return i; }
-
-		// Skip quotes
-		if( buffer[i] == '"' && ( i == 0 || buffer[i-1] != '\\' ) ) { inQuotes = !inQuotes; }
-		if( inQuotes ) { continue; }
-
-		// Process Braces/Brackets
-		if( buffer[i] == '{' ) { depthBraces++; continue; }
-		if( buffer[i] == '[' ) { depthBrackets++; continue; }
-		if( buffer[i] == '}' ) { if( depthBraces > 0 ) { depthBraces--; } else { return i; } }
-		if( buffer[i] == ']' ) { if( depthBrackets > 0 ) { depthBrackets--; } else { return i; } }
-		if( depthBraces > 0 || depthBrackets > 0 ) { continue; }
-
-		// Process ',' delimiter
-		if( buffer[i] == ',' ) { return i; }
+		const char c = buffer[i];
+		if( c == ',' || c == '}' || c == ']' || char_whitespace( c, true ) ) { break; }
+		i++;
 	}
-
-	// Failure
-	return end;
+	return i;
 }
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-JSON::JSON( String &string )
+static void mergesort_keys( JSONKey *keys, JSONKey *scratch, const u32 count )
 {
-	// Strip Whitespace
-	bool inQuotes = false;
-	for( usize i = string.length(); i > 0; i-- )
+	// Bottom-up & stable: keys with equal hashes stay in document order (sequential keys such as "asset_0",
+	// "asset_1", ... hash to nearly sorted runs, which would degrade a quicksort)
+	JSONKey *src = keys;
+	JSONKey *dst = scratch;
+	for( u32 width = 1; width < count; width *= 2 )
 	{
-		if( string[i-1] == '"' && ( i <= 1 || string[i-2] != '\\' ) ) { inQuotes = !inQuotes; continue; }
-		if( !inQuotes && char_whitespace( string[i-1], true ) ) { string.remove( i - 1, 1 ); continue; }
+		for( u32 low = 0; low < count; low += 2 * width )
+		{
+			const u32 mid = low + width < count ? low + width : count;
+			const u32 high = low + 2 * width < count ? low + 2 * width : count;
+			u32 a = low;
+			u32 b = mid;
+			u32 out = low;
+			while( a < mid && b < high ) { dst[out++] = src[b].hash < src[a].hash ? src[b++] : src[a++]; }
+			while( a < mid ) { dst[out++] = src[a++]; }
+			while( b < high ) { dst[out++] = src[b++]; }
+		}
+
+		JSONKey *temp = src;
+		src = dst; dst = temp;
 	}
 
-	this->start = 1;
-	AssertMsg( string[0] == '{', "JSON has invalid root scope (no open {)\n\nJSON:\n%s", string.c_str() );
-	this->end = string.length() - 1;
-	AssertMsg( string[this->end] == '}', "JSON has invalid root scope (no closing })\n\nJSON:\n%s", string.c_str() );
-	this->string = &string;
+	if( src != keys ) { memory_copy( keys, src, count * sizeof( JSONKey ) ); }
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-JSON::JSONElement JSON::FindElementKey( const char *key )
+static void json_tokenize( JSONDocument &document )
 {
-	// Locate Start
-	const usize indexStart = find_element_key( *string, key, start, end );
-	if( indexStart > end ) { return { 0, 0 }; }
+	// Stage 1: one pass over the text, emitting a node per value in document order. Containers stay open on the
+	// stack until their closing brace/bracket, at which point 'end' & 'next' are known.
+	const String &buffer = *document.string;
+	List<u32> stack;
 
-	// Locate End
-	const usize indexEnd = find_element_delimiter( *string, indexStart, end );
-	if( indexEnd > end || indexEnd <= indexStart ) { return { 0, 0 }; }
+	usize i = skip_whitespace( buffer, 0 );
+	AssertMsg( i < buffer.length() && buffer[i] == '{', "JSON has invalid root scope (no open {)\n\nJSON:\n%s", buffer.c_str() );
 
-	// Success
-	return { indexStart, indexEnd };
-}
+	for( ;; )
+	{
+		i = skip_whitespace( buffer, i );
+		AssertMsg( i < buffer.length() || stack.size() == 0,
+			"JSON has invalid root scope (no closing })\n\nJSON:\n%s", buffer.c_str() );
+		if( i >= buffer.length() ) { break; }
+		char c = buffer[i];
+
+		// Close Scope
+		if( c == '}' || c == ']' )
+		{
+			AssertMsg( stack.size() > 0, "JSON has an unmatched '%c'\n\nJSON:\n%s", c, buffer.c_str() );
+			JSONNode &scope = document.nodes[stack[stack.size() - 1]];
+			AssertMsg( ( c == '}' ) == ( scope.type == JSONNodeType_OBJECT ), "JSON has a mismatched '%c'\n\nJSON:\n%s",
+				c, buffer.c_str() );
+			scope.end = i + 1;
+			scope.next = static_cast<u32>( document.nodes.size() );
+			stack.remove( stack.size() - 1 );
+			i++;
+			continue;
+		}
 
+		// Delimiter
+		if( c == ',' ) { i++; continue; }
 
-JSON::JSONElement JSON::FindElementIndex( const usize index )
-{
-	// Locate Start
-	const usize indexStart = find_element_index( *string, index, start, end );
-	if( indexStart > end ) { return { 0, 0 }; }
+		// Node
+		JSONNode node { };
 
-	// Locate End
-	const usize indexEnd = find_element_delimiter( *string, indexStart, end );
-	if( indexEnd > end || indexEnd <= indexStart ) { return { 0, 0 }; }
+		// Key
+		if( stack.size() > 0 && document.nodes[stack[stack.size() - 1]].type == JSONNodeType_OBJECT )
+		{
+			AssertMsg( c == '"', "JSON has an invalid key at %llu\n\nJSON:\n%s",
+				static_cast<unsigned long long>( i ), buffer.c_str() );
+			const usize keyEnd = skip_string( buffer, i );
+			node.keyStart = i + 1;
+			node.keyEnd = keyEnd;
+			node.keyHash = hash( buffer.get_pointer( node.keyStart ), static_cast<int>( node.keyEnd - node.keyStart ) );
+
+			i = skip_whitespace( buffer, keyEnd + 1 );
+			AssertMsg( i < buffer.length() && buffer[i] == ':', "JSON has a key without a value at %llu\n\nJSON:\n%s",
+				static_cast<unsigned long long>( i ), buffer.c_str() );
+			i = skip_whitespace( buffer, i + 1 );
+			AssertMsg( i < buffer.length(), "JSON has a key without a value\n\nJSON:\n%s", buffer.c_str() );
+			c = buffer[i];
+		}
+		else
+		{
+			AssertMsg( stack.size() > 0 || document.nodes.size() == 0, "JSON has content after the root scope\n\nJSON:\n%s", buffer.c_str() );
+		}
 
-	// Success
-	return { indexStart, indexEnd };
+		// Value
+		const u32 index = static_cast<u32>( document.nodes.size() );
+		node.start = i;
+		if( c == '{' || c == '[' )
+		{
+			node.type = c == '{' ? JSONNodeType_OBJECT : JSONNodeType_ARRAY;
+			node.end = i;
+			node.next = JSON_NODE_NULL;
+			stack.add( index );
+			i++;
+		}
+		else if( c == '"' )
+		{
+			node.type = JSONNodeType_STRING;
+			node.end = skip_string( buffer, i ) + 1;
+			node.next = index + 1;
+			i = node.end;
+		}
+		else
+		{
+			node.type = JSONNodeType_PRIMITIVE;
+			node.end = skip_primitive( buffer, i );
+			node.next = index + 1;
+			AssertMsg( node.end > node.start, "JSON has an invalid value at %llu\n\nJSON:\n%s",
+				static_cast<unsigned long long>( i ), buffer.c_str() );
+			i = node.end;
+		}
+		document.nodes.add( node );
+	}
 }
 
 
-usize JSON::Count()
+static void json_index( JSONDocument &document )
 {
-	// Early out if empty
-	if( end - start <= 1 ) { return 0; }
-
-	bool inQuotes = false;
-	int depthBraces = 0;
-	int depthBrackets = 0;
-	usize count = 1;
-	for( usize i = start; i < end; i++ )
+	// Stage 2: lay out each container's children contiguously (walking siblings via 'next') and sort object keys
+	// by hash for binary searched lookups
+	const u32 count = static_cast<u32>( document.nodes.size() );
+	u32 countMax = 0;
+	for( u32 index = 0; index < count; index++ )
 	{
-		// Length check / null terminator
-		if( i >= string->length() || (*string)[i] == '\0' ) { break; }
-
-		// Skip quotes
-		if( (*string)[i] == '"' && ( i == 0 || (*string)[i-1] != '\\' ) ) { inQuotes = !inQuotes; }
-		if( inQuotes ) { continue; }
-
-		// Process Braces/Brackets
-		if( (*string)[i] == '{' ) { depthBraces++; continue; }
-		if( (*string)[i] == '[' ) { depthBrackets++; continue; }
-		if( (*string)[i] == '}' ) { if( depthBraces > 0 ) { depthBraces--; } else { break; } }
-		if( (*string)[i] == ']' ) { if( depthBrackets > 0 ) { depthBrackets--; } else { break; } }
-		if( depthBraces > 0 || depthBrackets > 0 ) { continue; }
-
-		// Process ',' delimiter
-		if( (*string)[i] == ',' ) { count++; }
+		JSONNode &node = document.nodes[index];
+		if( node.type != JSONNodeType_OBJECT && node.type != JSONNodeType_ARRAY ) { continue; }
+
+		node.first = static_cast<u32>( document.elements.size() );
+		node.keys = static_cast<u32>( document.keys.size() );
+		for( u32 child = index + 1; child < node.next; child = document.nodes[child].next )
+		{
+			if( node.type == JSONNodeType_OBJECT ) { document.keys.add( { document.nodes[child].keyHash, child } ); }
+			document.elements.add( child );
+			node.count++;
+		}
+
+		if( node.type == JSONNodeType_OBJECT && node.count > countMax ) { countMax = node.count; }
 	}
 
-	// Failure
-	return count;
+	// Sort Keys
+	if( countMax <= 1 ) { return; }
+	JSONKey *scratch = reinterpret_cast<JSONKey *>( memory_alloc( countMax * sizeof( JSONKey ) ) );
+	ErrorIf( scratch == nullptr, "Failed to allocate memory for JSON keys" );
+	for( u32 index = 0; index < count; index++ )
+	{
+		JSONNode &node = document.nodes[index];
+		if( node.type != JSONNodeType_OBJECT || node.count <= 1 ) { continue; }
+		mergesort_keys( &document.keys[node.keys], scratch, node.count );
+	}
+	memory_free( scratch );
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-JSON JSON::Object( const char *key )
+JSON::JSON( String &string )
 {
-	// Find Element
-	JSONElement element = FindElementKey( key );
-	if( !element ) { return { string, 0, 0 }; }
+	document = reinterpret_cast<JSONDocument *>( memory_alloc( sizeof( JSONDocument ) ) );
+	ErrorIf( document == nullptr, "Failed to allocate memory for JSON document" );
+	new ( document ) JSONDocument();
+	document->string = &string;
+	document->references = 1;
+
+	json_tokenize( *document );
+	json_index( *document );
+	node = 0;
+}
 
-	// Get Object
-	if( (*string)[element.start] != '{' ) { return { string, 0, 0 }; }
-	if( (*string)[element.end-1] != '}' ) { return { string, 0, 0 }; }
 
-	return { string, element.start + 1, element.end - 1 };
+JSON::JSON( JSONDocument *document, const u32 node ) : document( document ), node( node )
+{
+	document->references++;
 }
 
 
-JSON JSON::ObjectAt( const usize index )
+JSON::JSON( const JSON &other ) : document( other.document ), node( other.node )
 {
-	// Find Element
-	JSONElement element = FindElementIndex( index );
-	if( !element ) { return { string, 0, 0 }; }
+	document->references++;
+}
 
-	// Get Object
-	if( (*string)[element.start] != '{' ) { return { string, 0, 0 }; }
-	if( (*string)[element.end-1] != '}' ) { return { string, 0, 0 }; }
 
-	return { string, element.start + 1, element.end - 1 };
+JSON::~JSON()
+{
+	if( --document->references > 0 ) { return; }
+	document->~JSONDocument();
+	memory_free( document );
 }
 
-JSON JSON::Array( const char *key )
+
+JSON &JSON::operator=( const JSON &other )
 {
-	// Find Element
-	JSONElement element = FindElementKey( key );
-	if( !element ) { return { string, 0, 0 }; }
-
-	// Get Array
-	if( (*string)[element.start] != '[' ) { return { string, 0, 0 }; }
-	if( (*string)[element.end-1] != ']' ) { return { string, 0, 0 }; }
-	return { string, element.start + 1, element.end - 1 };
+	JSON copy { other };
+	JSONDocument *const documentOld = document;
+	document = copy.document;
+	node = copy.node;
+	copy.document = documentOld;
+	return *this;
 }
 
 
-JSON JSON::ArrayAt( const usize index )
+u32 JSON::FindNodeKey( const char *key )
 {
-	// Find Element
-	JSONElement element = FindElementIndex( index );
-	if( !element ) { return { string, 0, 0 }; }
-
-	// Get Array
-	if( (*string)[element.start] != '[' ) { return { string, 0, 0 }; }
-	if( (*string)[element.end-1] != ']' ) { return { string, 0, 0 }; }
-	return { string, element.start + 1, element.end - 1 };
+	if( node == JSON_NODE_NULL ) { return JSON_NODE_NULL; }
+	const JSONNode &scope = document->nodes[node];
+	if( scope.type != JSONNodeType_OBJECT ) { return JSON_NODE_NULL; }
+
+	// Binary search the first key with a matching hash
+	const usize length = strlen( key );
+	const u32 keyHash = hash( key, static_cast<int>( length ) );
+	u32 low = scope.keys;
+	u32 high = scope.keys + scope.count;
+	while( low < high )
+	{
+		const u32 mid = low + ( high - low ) / 2;
+		if( document->keys[mid].hash < keyHash ) { low = mid + 1; } else { high = mid; }
+	}
+
+	// Compare key text (hash collisions)
+	const String &buffer = *document->string;
+	for( u32 i = low; i < scope.keys + scope.count && document->keys[i].hash == keyHash; i++ )
+	{
+		const JSONNode &child = document->nodes[document->keys[i].node];
+		if( child.keyEnd - child.keyStart != length ) { continue; }
+		if( strncmp( buffer.get_pointer( child.keyStart ), key, length ) == 0 ) { return document->keys[i].node; }
+	}
+
+	// Failure
+	return JSON_NODE_NULL;
 }
 
 
-String JSON::GetString( const char *key, const char *defaultValue )
+u32 JSON::FindNodeIndex( const usize index )
 {
-	// Find Element
-	JSONElement element = FindElementKey( key );
-	if( !element ) { return defaultValue; }
-
-	// Get String
-	if( (*string)[element.start] != '"' ) { return defaultValue; }
-	if( (*string)[element.end-1] != '"' ) { return defaultValue; }
-	return string->substr( element.start + 1, element.end - 1 ).replace( "\\\"", "\"" ).replace( "\\n", "\n" ).replace( "\\t", "\t" );
+	if( node == JSON_NODE_NULL ) { return JSON_NODE_NULL; }
+	const JSONNode &scope = document->nodes[node];
+	if( index >= scope.count ) { return JSON_NODE_NULL; }
+	return document->elements[scope.first + index];
 }
 
 
-String JSON::GetStringAt( const usize index, const char *defaultValue )
+JSON JSON::Container( const u32 child, const JSONNodeType type )
 {
-	// Find Element
-	JSONElement element = FindElementIndex( index );
-	if( !element ) { return defaultValue; }
-
-	// Get String
-	if( (*string)[element.start] != '"' ) { return defaultValue; }
-	if( (*string)[element.end-1] != '"' ) { return defaultValue; }
-	return string->substr( element.start + 1, element.end - 1 ).replace( "\\\"", "\"" ).replace( "\\n", "\n" ).replace( "\\t", "\t" );
+	if( child == JSON_NODE_NULL || document->nodes[child].type != type ) { return { document, JSON_NODE_NULL }; }
+	return { document, child };
 }
 
 
-double JSON::GetDouble( const char *key, const double defaultValue )
+String JSON::GetValueString( const u32 child, const char *defaultValue )
 {
-	// Find Element
-	JSONElement element = FindElementKey( key );
-	if( !element ) { return defaultValue; }
-
-	// Return Double
-	return atof( string->substr( element.start, element.end ).c_str() );
+	if( child == JSON_NODE_NULL ) { return defaultValue; }
+	const JSONNode &value = document->nodes[child];
+	if( value.type != JSONNodeType_STRING ) { return defaultValue; }
+	return document->string->substr( value.start + 1, value.end - 1 ).replace( "\\\"", "\"" ).replace( "\\n", "\n" ).replace( "\\t", "\t" );
 }
 
 
-double JSON::GetDoubleAt( const usize index, const double defaultValue )
+double JSON::GetValueDouble( const u32 child, const double defaultValue )
 {
-	// Find Element
-	JSONElement element = FindElementIndex( index );
-	if( !element ) { return defaultValue; }
-
-	// Return Double
-	return atof( string->substr( element.start, element.end ).c_str() );
+	if( child == JSON_NODE_NULL ) { return defaultValue; }
+	const JSONNode &value = document->nodes[child];
+	return atof( document->string->substr( value.start, value.end ).c_str() );
 }
 
 
-int JSON::GetInt( const char *key, const int defaultValue )
+int JSON::GetValueInt( const u32 child, const int defaultValue )
 {
-	// Find Element
-	JSONElement element = FindElementKey( key );
-	if( !element ) { return defaultValue; }
-
-	// Return Integer
-	return atoi( string->substr( element.start, element.end ).c_str() );
+	if( child == JSON_NODE_NULL ) { return defaultValue; }
+	const JSONNode &value = document->nodes[child];
+	return atoi( document->string->substr( value.start, value.end ).c_str() );
 }
 
 
-int JSON::GetIntAt( const usize index, const int defaultValue )
+bool JSON::GetValueBool( const u32 child, const bool defaultValue )
 {
-	// Find Element
-	JSONElement element = FindElementIndex( index );
-	if( !element ) { return defaultValue; }
-
-	// Return Integer
-	return atoi( string->substr( element.start, element.end ).c_str() );
+	if( child == JSON_NODE_NULL ) { return defaultValue; }
+	const JSONNode &value = document->nodes[child];
+	return document->string->contains_at( "true", value.start ) || document->string->contains_at( "1", value.start );
 }
 
 
-bool JSON::GetBool( const char *key, const bool defaultValue )
+usize JSON::Count()
 {
-	// Find Element
-	JSONElement element = FindElementKey( key );
-	if( !element ) { return defaultValue; }
-
-	// Return Boolean
-	return string->contains_at( "true", element.start ) || string->contains_at( "1", element.start );
+	if( node == JSON_NODE_NULL ) { return 0; }
+	return document->nodes[node].count;
 }
 
 
-bool JSON::GetBoolAt( const usize index, const bool defaultValue )
-{
-	// Find Element
-	JSONElement element = FindElementIndex( index );
-	if( !element ) { return defaultValue; }
+JSON JSON::Object( const char *key ) { return Container( FindNodeKey( key ), JSONNodeType_OBJECT ); }
+JSON JSON::ObjectAt( const usize index ) { return Container( FindNodeIndex( index ), JSONNodeType_OBJECT ); }
+
+JSON JSON::Array( const char *key ) { return Container( FindNodeKey( key ), JSONNodeType_ARRAY ); }
+JSON JSON::ArrayAt( const usize index ) { return Container( FindNodeIndex( index ), JSONNodeType_ARRAY ); }
+
+String JSON::GetString( const char *key, const char *defaultValue ) { return GetValueString( FindNodeKey( key ), defaultValue ); }
+String JSON::GetStringAt( const usize index, const char *defaultValue ) { return GetValueString( FindNodeIndex( index ), defaultValue ); }
+
+double JSON::GetDouble( const char *key, const double defaultValue ) { return GetValueDouble( FindNodeKey( key ), defaultValue ); }
+double JSON::GetDoubleAt( const usize index, const double defaultValue ) { return GetValueDouble( FindNodeIndex( index ), defaultValue ); }
+
+int JSON::GetInt( const char *key, const int defaultValue ) { return GetValueInt( FindNodeKey( key ), defaultValue ); }
+int JSON::GetIntAt( const usize index, const int defaultValue ) { return GetValueInt( FindNodeIndex( index ), defaultValue ); }
 
-	// Return Boolean
-	return string->contains_at( "true", element.start ) || string->contains_at( "1", element.start );
-}
\ No newline at end of file
+bool JSON::GetBool( const char *key, const bool defaultValue ) { return GetValueBool( FindNodeKey( key ), defaultValue ); }
+bool JSON::GetBoolAt( const usize index, const bool defaultValue ) { return GetValueBool( FindNodeIndex( index ), defaultValue ); }
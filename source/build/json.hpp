@@ -1,16 +1,74 @@
 #pragma once
 
 #include <build/string.hpp>
+#include <build/list.hpp>
 
 #include <debug.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// JSON reader
+//
+// The constructor tokenizes the document in a single pass into a flat tape of nodes (one per value, with the text
+// range of the value and its key), then indexes every object & array: children are laid out contiguously so *At()
+// lookups are O(1), and object keys are sorted by hash so key lookups are a binary search. The first occurrence of a
+// duplicate key wins. Trailing commas are tolerated.
+//
+// Objects & arrays returned by Object() / Array() share the parsed document (reference counted), so temporaries such
+// as JSON( string ).Object( "a" ).Object( "b" ) are safe. The source string must outlive every JSON made from it.
+
+#define JSON_NODE_NULL ( U32_MAX )
+
+enum_type( JSONNodeType, u8 )
+{
+	JSONNodeType_OBJECT,
+	JSONNodeType_ARRAY,
+	JSONNodeType_STRING,
+	JSONNodeType_PRIMITIVE, // Numbers, true, false, null
+};
+
+
+struct JSONNode
+{
+	usize start;     // value text [start, end) (strings include their quotes)
+	usize end;
+	usize keyStart;  // key text [keyStart, keyEnd) (object members, excluding quotes)
+	usize keyEnd;
+	u32 keyHash;
+	u32 next;        // tape index following this node's subtree
+	u32 first;       // objects & arrays: offset into JSONDocument::elements
+	u32 keys;        // objects: offset into JSONDocument::keys
+	u32 count;
+	JSONNodeType type;
+};
+
+
+struct JSONKey
+{
+	u32 hash;
+	u32 node;
+};
+
+
+struct JSONDocument
+{
+	String *string = nullptr;
+	List<JSONNode> nodes;
+	List<u32> elements;
+	List<JSONKey> keys;
+	u32 references = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 class JSON
 {
 public:
 	JSON( String &string );
-	JSON( String *string, usize start = U64_MAX, usize end = U64_MAX ) : string( string ), start( start ), end( end ) { }
+	JSON( const JSON &other );
+	~JSON();
+
+	JSON &operator=( const JSON &other );
 
 	JSON Object( const char *key );
 	JSON ObjectAt( const usize index );
@@ -35,21 +93,21 @@ public:
 	bool GetBool( const char *key, const bool defaultValue = false );
 	bool GetBoolAt( const usize index, const bool defaultValue = false );
 
-	explicit operator bool() const { return start < end; }
+	// False for missing or empty objects & arrays
+	explicit operator bool() const { return node != JSON_NODE_NULL && document->nodes.at( node ).count > 0; }
 
-//private:
-	struct JSONElement
-	{
-		JSONElement( usize start, usize end ) : start( start ), end( end ) { }
-		usize start = 0;
-		usize end = 0;
-		explicit operator bool() const { return start < end; }
-	};
+private:
+	JSON( JSONDocument *document, const u32 node );
 
-	JSONElement FindElementKey( const char *key );
-	JSONElement FindElementIndex( const usize index );
+	u32 FindNodeKey( const char *key );
+	u32 FindNodeIndex( const usize index );
+	JSON Container( const u32 child, const JSONNodeType type );
 
-	String *string;
-	usize start;
-	usize end;
-};
\ No newline at end of file
+	String GetValueString( const u32 child, const char *defaultValue );
+	double GetValueDouble( const u32 child, const double defaultValue );
+	int GetValueInt( const u32 child, const int defaultValue );
+	bool GetValueBool( const u32 child, const bool defaultValue );
+
+	JSONDocument *document;
+	u32 node;
+};
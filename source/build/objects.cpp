@@ -72,6 +72,7 @@ const char *g_KEYWORDS[] =
 	"PRIVATE",               // KeywordID_PRIVATE
 	"PUBLIC",                // KeywordID_PUBLIC
 	"GLOBAL",                // KeywordID_GLOBAL
+	"HOT",                   // KeywordID_HOT
 };
 static_assert( ARRAY_LENGTH( g_KEYWORDS ) == KEYWORD_COUNT, "Verify g_KEYWORDS matches KeywordID enum" );
 
@@ -125,6 +126,7 @@ KeywordRequirements g_KEYWORD_REQUIREMENTS[] =
 	{ false,   -1 }, // KeywordID_PRIVATE
 	{ false,   -1 }, // KeywordID_PUBLIC
 	{ false,   -1 }, // KeywordID_GLOBAL
+	{ false,   -1 }, // KeywordID_HOT
 };
 static_assert( ARRAY_LENGTH( g_KEYWORD_REQUIREMENTS ) == KEYWORD_COUNT, "Verify g_KEYWORD_REQUIREMENTS matches KeywordID enum" );
 
@@ -152,11 +154,11 @@ const char *g_EVENT_FUNCTIONS[][EVENT_FUNCTION_DEFINITION_COUNT] =
 	{ "event_partition",       "void",                   "",                        "( void *ptr )",          "( ptr )"    }, // KeywordID_EVENT_PARTITION
 	{ "event_ui_mask",         "int",                    "",                        "( void *ptr )",          "( ptr )"    }, // KeywordID_EVENT_UI_MASK
 
-	{ "event_save",            "bool",                   "",                        "( byte *buffer )",       "( buffer )" }, // KeywordID_EVENT_SAVE
-	{ "event_load",            "bool",                   "",                        "( byte *buffer )",       "( buffer )" }, // KeywordID_EVENT_LOAD
+	{ "event_save",            "void",                   "",                        "( byte *buffer )",       "( buffer )" }, // KeywordID_EVENT_SAVE
+	{ "event_load",            "void",                   "",                        "( byte *buffer )",       "( buffer )" }, // KeywordID_EVENT_LOAD
 
-	{ "event_network_send",    "bool",                   "",                        "( byte *buffer )",       "( buffer )" }, // KeywordID_EVENT_NETWORK_SEND
-	{ "event_network_receive", "bool",                   "",                        "( byte *buffer )",       "( buffer )" }, // KeywordID_EVENT_NETWORK_RECEIVE
+	{ "event_network_send",    "void",                   "",                        "( byte *buffer )",       "( buffer )" }, // KeywordID_EVENT_NETWORK_SEND
+	{ "event_network_receive", "void",                   "",                        "( byte *buffer )",       "( buffer )" }, // KeywordID_EVENT_NETWORK_RECEIVE
 };
 static_assert( ARRAY_LENGTH( g_EVENT_FUNCTIONS ) == EVENT_COUNT, "Verify g_EVENT_FUNCTIONS matches EventID enum" );
 
@@ -208,6 +210,13 @@ static bool char_is_keyword_delimiter( char c )
 }
 
 
+static void inheritance_chain( ObjectFile *object, List<ObjectFile *> &outChain )
+{
+	// Root-most ancestor first, 'object' last
+	for( ; object != nullptr; object = object->parent ) { outChain.insert( 0, object ); }
+}
+
+
 static int line_at( const String &buffer, const usize position )
 {
 	int line = 1;
@@ -434,6 +443,13 @@ void ObjectFile::parse_keywords_code( const String &buffer )
 				keyword_PRIVATE_PUBLIC_GLOBAL( buffer, keyword );
 			}
 			break;
+
+			// HOT
+			case KeywordID_HOT:
+			{
+				keyword_HOT( buffer, keyword );
+			}
+			break;
 		}
 	}
 }
@@ -553,6 +569,29 @@ void ObjectFile::keyword_EVENT_NULL( const String &buffer, Keyword &keyword )
 }
 
 
+static bool variable_net_name( const String &expression, String &name )
+{
+	// Returns the variable name of a PUBLIC declaration if it can be replicated by value
+	// Pointers, references, const/static data and multiple declarators are skipped
+	const usize declaratorEnd = min( expression.length() - 1, min( expression.find( "=" ), expression.find( "{" ) ) );
+	String declarator = expression.substr( 0, declaratorEnd ).trim();
+	if( declarator.find( "*" ) != USIZE_MAX || declarator.find( "&" ) != USIZE_MAX || declarator.find( "," ) != USIZE_MAX ) { return false; }
+	if( declarator.contains_at( "const ", 0 ) || declarator.contains_at( "constexpr ", 0 ) ||
+	    declarator.contains_at( "static ", 0 ) || declarator.find( " const " ) != USIZE_MAX ) { return false; }
+
+	// Strip array extents (e.g. "int array[128]")
+	const usize extents = declarator.find( "[" );
+	if( extents != USIZE_MAX ) { declarator = declarator.substr( 0, extents ).trim(); }
+
+	// Name
+	usize nameStart = declarator.length();
+	while( nameStart > 0 && !char_is_keyword_delimiter( declarator[nameStart - 1] ) ) { nameStart--; }
+	if( nameStart == 0 || nameStart == declarator.length() ) { return false; }
+	name = declarator.substr( nameStart ).trim();
+	return true;
+}
+
+
 void ObjectFile::keyword_PRIVATE_PUBLIC_GLOBAL( const String &buffer, Keyword &keyword )
 {
 	usize start = keyword.start;
@@ -638,6 +677,13 @@ void ObjectFile::keyword_PRIVATE_PUBLIC_GLOBAL( const String &buffer, Keyword &k
 			// Copy expression
 			String expression = buffer.substr( start, end ).trim();
 
+			// Replicated data (NETWORKED) -- OBJECT_BASE 'id' is owned by each ObjectContext
+			String name;
+			if( keyword.id == KeywordID_PUBLIC && isVariable && this->name != "OBJECT_BASE" && variable_net_name( expression, name ) )
+			{
+				netVariableName.add( static_cast<String &&>( name ) );
+			}
+
 			// Format expression
 			expression.replace( "\n", "\n\t" );
 
@@ -740,6 +786,35 @@ void ObjectFile::keyword_PRIVATE_PUBLIC_GLOBAL( const String &buffer, Keyword &k
 }
 
 
+void ObjectFile::keyword_HOT( const String &buffer, Keyword &keyword )
+{
+	// HOT data is public and stored in per-bucket field arrays rather than in the object (see manta/objects.hpp)
+	const usize end = buffer.find( ";", keyword.start, keyword.end );
+	ErrorIf( end == USIZE_MAX, "Invalid %s declaration: missing terminating semicolon (line: %d)",
+		g_KEYWORDS[keyword.id], line_at( buffer, keyword.start ) );
+	String expression = buffer.substr( keyword.start, end + 1 ).trim();
+
+	// Declarator (e.g. "float x" in "float x = 0.0f;")
+	const usize declaratorEnd = min( expression.length() - 1, min( expression.find( "=" ), expression.find( "{" ) ) );
+	String declarator = expression.substr( 0, declaratorEnd ).trim();
+	ErrorIf( declarator.find( "[" ) != USIZE_MAX || declarator.find( "&" ) != USIZE_MAX,
+		"%s does not support array or reference types (line: %d)", g_KEYWORDS[keyword.id], line_at( buffer, keyword.start ) );
+
+	// Split type & name
+	usize nameStart = declarator.length();
+	while( nameStart > 0 && !char_is_keyword_delimiter( declarator[nameStart - 1] ) ) { nameStart--; }
+	String name = declarator.substr( nameStart ).trim();
+	String typeName = declarator.substr( 0, nameStart ).trim();
+	ErrorIf( name.length() == 0 || typeName.length() == 0, "Invalid %s declaration: expected '%s <type> <name>;' (line: %d)",
+		g_KEYWORDS[keyword.id], g_KEYWORDS[keyword.id], line_at( buffer, keyword.start ) );
+
+	// Register field
+	hotVariableHeader.add( static_cast<String &&>( expression ) );
+	hotVariableType.add( static_cast<String &&>( typeName ) );
+	hotVariableName.add( static_cast<String &&>( name ) );
+}
+
+
 String ObjectFile::keyword_PARENTHESES_string( const String &buffer, Keyword &keyword, const bool requireParentheses )
 {
 	// Find parentheses
@@ -854,6 +929,20 @@ void ObjectFile::write_header()
 
 	// OBJECT_DECLARATION_BEGIN
 	output.append( "__INTERNAL_OBJECT_DEFINITION_BEGIN()\n" );
+
+	// HOT record (inherited fields first, so parent field offsets match)
+	if( hot_variable_count() > 0 )
+	{
+		output.append( "struct " ).append( name ).append( "_hot_t\n{\n" );
+		List<ObjectFile *> chain;
+		inheritance_chain( this, chain );
+		for( ObjectFile *object : chain )
+		{
+			for( String &str : object->hotVariableHeader ) { output.append( "\t" ).append( str ).append( "\n" ); }
+		}
+		output.append( "};\n\n" );
+	}
+
 	output.append( "class " );
 	output.append( type );
 	if( parent != nullptr )
@@ -892,6 +981,19 @@ void ObjectFile::write_header()
 				output.append( "\n" );
 			}
 
+			// Hot Variables
+			if( hotVariableHeader.size() > 0 )
+			{
+				output.append( "\t// HOT DATA\n" );
+				const usize inherited = hot_variable_count() - hotVariableHeader.size();
+				for( usize i = 0; i < hotVariableHeader.size(); i++ )
+				{
+					output.append( "\tObjectHotField<" ).append( name ).append( ", " ).append( static_cast<u64>( inherited + i ) );
+					output.append( ", " ).append( hotVariableType[i] ).append( "> " ).append( hotVariableName[i] ).append( ";\n" );
+				}
+				output.append( "\n" );
+			}
+
 			// Public Functions
 			if( publicFunctionHeader.size() > 0 )
 			{
@@ -945,11 +1047,19 @@ void ObjectFile::write_header()
 	if( constructorHeader.size() > 0 )
 	{
 		output.append( "template <typename... Args> struct iObjects::object_constructor<" ).append( name ).append( ", Args...>\n{\n" );
-		output.append( "\tstatic void construct( Args... args )\n\t{\n" );
+		output.append( "\tstatic void construct( const Args &... args )\n\t{\n" );
+		if( hot_variable_count() > 0 )
+		{
+			output.append( "\t\tnew ( iObjects::OBJECT_CTOR_HOT_MANUAL_BUFFER + iObjects::OBJECT_CTOR_HOT_OFFSET[" );
+			output.append( name ).append( "] ) iObjects::" ).append( name ).append( "_hot_t();\n" );
+		}
 		output.append( "\t\tnew ( iObjects::OBJECT_CTOR_MANUAL_BUFFER + iObjects::OBJECT_CTOR_BUFFER_OFFSET[" );
 		output.append( name ).append( "] ) iObjects::" ).append( type ).append( "( args... );\n\t}\n};\n\n" );
 	}
 
+	// HOT field metadata & ObjectFields
+	write_header_hot();
+
 	// ObjectHandle
 	output.append( "template <> struct ObjectHandle<" ).append( name ).append( ">\n{\n" );
 	output.append( "\tiObjects::" ).append( type ).append( " *data = nullptr;\n" );
@@ -968,6 +1078,138 @@ void ObjectFile::write_header()
 }
 
 
+usize ObjectFile::hot_variable_count()
+{
+	usize count = 0;
+	for( ObjectFile *object = this; object != nullptr; object = object->parent ) { count += object->hotVariableHeader.size(); }
+	return count;
+}
+
+
+void ObjectFile::write_header_hot()
+{
+	const usize count = hot_variable_count();
+	if( count == 0 ) { return; }
+	String &output = Objects::header;
+
+	List<ObjectFile *> chain;
+	inheritance_chain( this, chain );
+
+	// object_hot<N>
+	output.append( "template <> struct iObjects::object_hot<" ).append( name ).append( ">\n{\n" );
+	output.append( "\tstatic iObjects::HotFieldInfo fields[" ).append( static_cast<u64>( count ) ).append( "]; // resolved in iObjects::init()\n" );
+	output.append( "};\n\n" );
+
+	// ObjectFields<N>
+	output.append( "template <> struct ObjectFields<" ).append( name ).append( ">\n{\n" );
+	for( ObjectFile *object : chain )
+	{
+		for( usize i = 0; i < object->hotVariableName.size(); i++ )
+		{
+			output.append( "\t" ).append( object->hotVariableType[i] ).append( " *" ).append( object->hotVariableName[i] ).append( ";\n" );
+		}
+	}
+	output.append( "\tu16 bottom; // lowest live index\n" );
+	output.append( "\tu16 top;    // highest live index + 1\n\n" );
+
+	output.append( "\tObjectFields( byte *arrays, const u16 capacity, const u16 bottom, const u16 top ) : bottom { bottom }, top { top }\n\t{\n" );
+	output.append( "\t\tconst iObjects::HotFieldInfo *fields = iObjects::object_hot<" ).append( name ).append( ">::fields;\n" );
+	usize field = 0;
+	for( ObjectFile *object : chain )
+	{
+		for( usize i = 0; i < object->hotVariableName.size(); i++, field++ )
+		{
+			output.append( "\t\t" ).append( object->hotVariableName[i] ).append( " = reinterpret_cast<" );
+			output.append( object->hotVariableType[i] ).append( " *>( arrays + capacity * fields[" );
+			output.append( static_cast<u64>( field ) ).append( "].recordOffset );\n" );
+		}
+	}
+	output.append( "\t}\n};\n\n" );
+}
+
+
+void ObjectFile::write_source_hot_init()
+{
+	const usize count = hot_variable_count();
+	if( count == 0 ) { return; }
+	String &output = Objects::source;
+
+	output.append( "\t{\n" );
+	output.append( "\t\tiObjects::" ).append( type ).append( " *object = reinterpret_cast<iObjects::" ).append( type );
+	output.append( " *>( iObjects::OBJECT_CTOR_DEFAULT_BUFFER + iObjects::OBJECT_CTOR_BUFFER_OFFSET[" ).append( name ).append( "] );\n" );
+	output.append( "\t\tiObjects::" ).append( name ).append( "_hot_t *record = new ( iObjects::OBJECT_CTOR_HOT_DEFAULT_BUFFER + " );
+	output.append( "iObjects::OBJECT_CTOR_HOT_OFFSET[" ).append( name ).append( "] ) iObjects::" ).append( name ).append( "_hot_t();\n" );
+
+	List<ObjectFile *> chain;
+	inheritance_chain( this, chain );
+	usize field = 0;
+	for( ObjectFile *object : chain )
+	{
+		for( usize i = 0; i < object->hotVariableName.size(); i++, field++ )
+		{
+			output.append( "\t\tOBJECT_HOT_FIELD( " ).append( name ).append( ", " ).append( static_cast<u64>( field ) );
+			output.append( ", " ).append( object->hotVariableName[i] ).append( " );\n" );
+		}
+	}
+	output.append( "\t}\n" );
+}
+
+
+usize ObjectFile::net_variable_count()
+{
+	if( !is_networked() ) { return 0; }
+	usize count = 0;
+	for( ObjectFile *object = this; object != nullptr; object = object->parent )
+	{
+		count += object->netVariableName.size() + object->hotVariableName.size();
+	}
+	return count;
+}
+
+
+bool ObjectFile::is_networked()
+{
+	// NETWORKED is inherited
+	for( ObjectFile *object = this; object != nullptr; object = object->parent ) { if( object->networked ) { return true; } }
+	return false;
+}
+
+
+void ObjectFile::write_source_net_init()
+{
+	if( net_variable_count() == 0 ) { return; }
+	String &output = Objects::source;
+
+	output.append( "\t{\n" );
+	output.append( "\t\tiObjects::" ).append( type ).append( " *object = reinterpret_cast<iObjects::" ).append( type );
+	output.append( " *>( iObjects::OBJECT_CTOR_DEFAULT_BUFFER + iObjects::OBJECT_CTOR_BUFFER_OFFSET[" ).append( name ).append( "] );\n" );
+
+	// PUBLIC data followed by HOT data, root-most ancestor first
+	List<ObjectFile *> chain;
+	inheritance_chain( this, chain );
+	usize field = 0;
+	for( ObjectFile *object : chain )
+	{
+		for( usize i = 0; i < object->netVariableName.size(); i++, field++ )
+		{
+			output.append( "\t\tOBJECT_NET_FIELD( " ).append( name ).append( ", " ).append( static_cast<u64>( field ) );
+			output.append( ", " ).append( object->netVariableName[i] ).append( " );\n" );
+		}
+	}
+
+	usize hot = 0;
+	for( ObjectFile *object : chain )
+	{
+		for( usize i = 0; i < object->hotVariableName.size(); i++, field++, hot++ )
+		{
+			output.append( "\t\tOBJECT_NET_FIELD_HOT( " ).append( name ).append( ", " ).append( static_cast<u64>( field ) );
+			output.append( ", " ).append( static_cast<u64>( hot ) ).append( " );\n" );
+		}
+	}
+	output.append( "\t}\n" );
+}
+
+
 void ObjectFile::write_handle()
 {
 	String &output = Objects::source;
@@ -1184,6 +1426,14 @@ void Objects::resolve()
 				}
 			}
 
+			for( String &variable : parent->hotVariableHeader )
+			{
+				if( !( object.inheritedVariables.contains( variable ) ) )
+				{
+					object.inheritedVariables.add( variable );
+				}
+			}
+
 			// Functions
 			for( String &function : parent->publicFunctionHeader )
 			{
@@ -1376,10 +1626,24 @@ void Objects::generate_header_metadata( String &output )
 		output.append( "\textern byte *OBJECT_CTOR_DEFAULT_BUFFER;\n" );
 		output.append( "\textern u32 OBJECT_CTOR_BUFFER_SIZE;\n" );
 		output.append( "\textern u32 OBJECT_CTOR_BUFFER_OFFSET[];\n\n" );
+		output.append( "\textern byte *OBJECT_CTOR_HOT_MANUAL_BUFFER;\n" );
+		output.append( "\textern byte *OBJECT_CTOR_HOT_DEFAULT_BUFFER;\n" );
+		output.append( "\textern u32 OBJECT_CTOR_HOT_BUFFER_SIZE;\n" );
+		output.append( "\textern u32 OBJECT_CTOR_HOT_OFFSET[];\n\n" );
 		output.append( "\textern const u16 OBJECT_TYPE_BUCKET_CAPACITY[];\n" );
 		output.append( "\textern const i32 OBJECT_TYPE_MAX_COUNT[];\n" );
 		output.append( "\textern const u16 OBJECT_TYPE_INHERITANCE_DEPTH[];\n" );
 		output.append( "\textern const u16 OBJECT_TYPE_SIZE[];\n" );
+		output.append( "\textern const u16 OBJECT_TYPE_HOT_SIZE[];\n" );
+		output.append( "\textern const u16 OBJECT_TYPE_HOT_FIELD_COUNT[];\n" );
+		output.append( "\textern const HotFieldInfo *const OBJECT_TYPE_HOT_FIELDS[];\n" );
+		output.append( "\textern const u16 OBJECT_TYPE_VERSION[];\n" );
+		output.append( "\textern const SnapshotEvent OBJECT_TYPE_EVENT_SAVE[];\n" );
+		output.append( "\textern const SnapshotEvent OBJECT_TYPE_EVENT_LOAD[];\n" );
+		output.append( "\textern const SnapshotEvent OBJECT_TYPE_EVENT_NETWORK_SEND[];\n" );
+		output.append( "\textern const SnapshotEvent OBJECT_TYPE_EVENT_NETWORK_RECEIVE[];\n" );
+		output.append( "\textern const u16 OBJECT_TYPE_NET_FIELD_COUNT[];\n" );
+		output.append( "\textern const NetFieldInfo *const OBJECT_TYPE_NET_FIELDS[];\n" );
 
 		output.append( "#if COMPILE_DEBUG\n" );
 		output.append( "\textern const char *OBJECT_TYPE_NAME[];\n" );
@@ -1412,6 +1676,7 @@ void Objects::generate_source( String &output )
 	output.append( "// OBJECT SYSTEM INCLUDES\n" );
 	output.append( "#include <manta/objects.hpp>\n" );
 	output.append( "#include <manta/memory.hpp>\n" );
+	output.append( "#include <manta/profiler.hpp>\n" );
 	output.append( "#include <vendor/new.hpp>\n" );
 	output.append( "\n" );
 
@@ -1451,6 +1716,23 @@ void Objects::generate_source_metadata( String &output )
 	output.append( "u32 iObjects::OBJECT_CTOR_BUFFER_SIZE = 0;\n" );
 	output.append( "u32 iObjects::OBJECT_CTOR_BUFFER_OFFSET[OBJECT_TYPE_COUNT];\n\n" );
 
+	output.append( "byte *iObjects::OBJECT_CTOR_HOT_MANUAL_BUFFER = nullptr;\n" );
+	output.append( "byte *iObjects::OBJECT_CTOR_HOT_DEFAULT_BUFFER = nullptr;\n" );
+	output.append( "u32 iObjects::OBJECT_CTOR_HOT_BUFFER_SIZE = 0;\n" );
+	output.append( "u32 iObjects::OBJECT_CTOR_HOT_OFFSET[OBJECT_TYPE_COUNT];\n\n" );
+
+	// object_hot<N>::fields
+	bool hasHot = false;
+	for( ObjectFile *object : objectFilesSorted )
+	{
+		const usize count = object->hot_variable_count();
+		if( count == 0 ) { continue; }
+		output.append( "iObjects::HotFieldInfo iObjects::object_hot<" ).append( object->name ).append( ">::fields[" );
+		output.append( static_cast<u64>( count ) ).append( "];\n" );
+		hasHot = true;
+	}
+	if( hasHot ) { output.append( "\n" ); }
+
 	// OBJECT_BUCKET_CAPACITY
 	output.append( "const u16 iObjects::OBJECT_TYPE_BUCKET_CAPACITY[OBJECT_TYPE_COUNT] =\n{\n\t" );
 	for( usize i = 0, j = 0; i < objectFilesSorted.size(); i++, j++ )
@@ -1492,6 +1774,114 @@ void Objects::generate_source_metadata( String &output )
 		output.append( object.type );
 		output.append( ( j % 3 == 0 && j != 0 && i != objectFilesSorted.size() - 1 ) ? " ),\n\t" : " ), " );
 	}
+	output.append( "\n};\n\n" );
+
+	// OBJECT_TYPE_HOT_SIZE
+	output.append( "const u16 iObjects::OBJECT_TYPE_HOT_SIZE[OBJECT_TYPE_COUNT] =\n{\n\t" );
+	for( usize i = 0, j = 0; i < objectFilesSorted.size(); i++, j++ )
+	{
+		ObjectFile &object = *objectFilesSorted[i];
+		if( object.hot_variable_count() == 0 ) { output.append( "0" ); } else
+		{
+			output.append( "sizeof( iObjects::" ).append( object.name ).append( "_hot_t )" );
+		}
+		output.append( ( j % 3 == 0 && j != 0 && i != objectFilesSorted.size() - 1 ) ? ",\n\t" : ", " );
+	}
+	output.append( "\n};\n\n" );
+
+	// OBJECT_TYPE_HOT_FIELD_COUNT
+	output.append( "const u16 iObjects::OBJECT_TYPE_HOT_FIELD_COUNT[OBJECT_TYPE_COUNT] =\n{\n\t" );
+	for( usize i = 0, j = 0; i < objectFilesSorted.size(); i++, j++ )
+	{
+		ObjectFile &object = *objectFilesSorted[i];
+		output.append( static_cast<u64>( object.hot_variable_count() ) );
+		output.append( ( j % 7 == 0 && j != 0 && i != objectFilesSorted.size() - 1 ) ? ",\n\t" : ", " );
+	}
+	output.append( "\n};\n\n" );
+
+	// OBJECT_TYPE_HOT_FIELDS
+	output.append( "const iObjects::HotFieldInfo *const iObjects::OBJECT_TYPE_HOT_FIELDS[OBJECT_TYPE_COUNT] =\n{\n\t" );
+	for( usize i = 0, j = 0; i < objectFilesSorted.size(); i++, j++ )
+	{
+		ObjectFile &object = *objectFilesSorted[i];
+		if( object.hot_variable_count() == 0 ) { output.append( "nullptr" ); } else
+		{
+			output.append( "iObjects::object_hot<" ).append( object.name ).append( ">::fields" );
+		}
+		output.append( ( j % 3 == 0 && j != 0 && i != objectFilesSorted.size() - 1 ) ? ",\n\t" : ", " );
+	}
+	output.append( "\n};\n\n" );
+
+	// OBJECT_TYPE_VERSION
+	output.append( "const u16 iObjects::OBJECT_TYPE_VERSION[OBJECT_TYPE_COUNT] =\n{\n\t" );
+	for( usize i = 0, j = 0; i < objectFilesSorted.size(); i++, j++ )
+	{
+		ObjectFile &object = *objectFilesSorted[i];
+		output.append( static_cast<u64>( object.version < 0 ? 0 : object.version ) );
+		output.append( ( j % 7 == 0 && j != 0 && i != objectFilesSorted.size() - 1 ) ? ",\n\t" : ", " );
+	}
+	output.append( "\n};\n\n" );
+
+	// OBJECT_TYPE_EVENT_SAVE, OBJECT_TYPE_EVENT_LOAD & OBJECT_TYPE_EVENT_NETWORK_*
+	const u8 snapshotEvents[] = { KeywordID_EVENT_SAVE, KeywordID_EVENT_LOAD, KeywordID_EVENT_NETWORK_SEND, KeywordID_EVENT_NETWORK_RECEIVE };
+	const char *snapshotTables[] = { "OBJECT_TYPE_EVENT_SAVE", "OBJECT_TYPE_EVENT_LOAD", "OBJECT_TYPE_EVENT_NETWORK_SEND", "OBJECT_TYPE_EVENT_NETWORK_RECEIVE" };
+	for( usize k = 0; k < ARRAY_LENGTH( snapshotEvents ); k++ )
+	{
+		const u8 eventID = snapshotEvents[k];
+		const char *eventName = g_EVENT_FUNCTIONS[eventID][EventFunction_Name];
+		for( ObjectFile *object : objectFilesSorted )
+		{
+			if( !object->events[eventID].has || object->events[eventID].disabled ) { continue; }
+			output.append( "static void " ).append( object->name ).append( "_" ).append( eventName );
+			output.append( "( void *object, byte *buffer ) { reinterpret_cast<iObjects::" ).append( object->type );
+			output.append( " *>( object )->" ).append( eventName ).append( "( buffer ); }\n" );
+		}
+		output.append( "\n" );
+
+		output.append( "const iObjects::SnapshotEvent iObjects::" ).append( snapshotTables[k] );
+		output.append( "[OBJECT_TYPE_COUNT] =\n{\n\t" );
+		for( usize i = 0, j = 0; i < objectFilesSorted.size(); i++, j++ )
+		{
+			ObjectFile &object = *objectFilesSorted[i];
+			if( !object.events[eventID].has || object.events[eventID].disabled ) { output.append( "nullptr" ); } else
+			{
+				output.append( object.name ).append( "_" ).append( eventName );
+			}
+			output.append( ( j % 3 == 0 && j != 0 && i != objectFilesSorted.size() - 1 ) ? ",\n\t" : ", " );
+		}
+		output.append( "\n};\n\n" );
+	}
+
+	// OBJECT_TYPE_NET_FIELD_COUNT
+	output.append( "const u16 iObjects::OBJECT_TYPE_NET_FIELD_COUNT[OBJECT_TYPE_COUNT] =\n{\n\t" );
+	for( usize i = 0, j = 0; i < objectFilesSorted.size(); i++, j++ )
+	{
+		ObjectFile &object = *objectFilesSorted[i];
+		output.append( static_cast<u64>( object.net_variable_count() ) );
+		output.append( ( j % 7 == 0 && j != 0 && i != objectFilesSorted.size() - 1 ) ? ",\n\t" : ", " );
+	}
+	output.append( "\n};\n\n" );
+
+	// OBJECT_TYPE_NET_FIELDS
+	for( ObjectFile *object : objectFilesSorted )
+	{
+		const usize count = object->net_variable_count();
+		if( count == 0 ) { continue; }
+		output.append( "static iObjects::NetFieldInfo " ).append( object->name ).append( "_net_fields[" );
+		output.append( static_cast<u64>( count ) ).append( "]; // resolved in iObjects::init()\n" );
+	}
+	output.append( "\n" );
+
+	output.append( "const iObjects::NetFieldInfo *const iObjects::OBJECT_TYPE_NET_FIELDS[OBJECT_TYPE_COUNT] =\n{\n\t" );
+	for( usize i = 0, j = 0; i < objectFilesSorted.size(); i++, j++ )
+	{
+		ObjectFile &object = *objectFilesSorted[i];
+		if( object.net_variable_count() == 0 ) { output.append( "nullptr" ); } else
+		{
+			output.append( object.name ).append( "_net_fields" );
+		}
+		output.append( ( j % 3 == 0 && j != 0 && i != objectFilesSorted.size() - 1 ) ? ",\n\t" : ", " );
+	}
 	output.append( "\n};\n\n\n" );
 
 	// OBJECT_TYPE_NAME
@@ -1515,6 +1905,27 @@ void Objects::generate_source_metadata( String &output )
 	output.append( "#define OBJECT_CONSTRUCTOR_DATA( typeID, type ) \\\n" );
 	output.append( "\t{ new ( iObjects::OBJECT_CTOR_DEFAULT_BUFFER + iObjects::OBJECT_CTOR_BUFFER_OFFSET[typeID] ) type(); }\n\n" );
 
+	// #define OBJECT_HOT_OFFSET
+	output.append( "#define OBJECT_HOT_OFFSET( typeID, type ) \\\n" );
+	output.append( "\tiObjects::OBJECT_CTOR_HOT_BUFFER_SIZE = ( iObjects::OBJECT_CTOR_HOT_BUFFER_SIZE + 15 ) & ~15u; \\\n" );
+	output.append( "\tiObjects::OBJECT_CTOR_HOT_OFFSET[typeID] = iObjects::OBJECT_CTOR_HOT_BUFFER_SIZE; \\\n" );
+	output.append( "\tiObjects::OBJECT_CTOR_HOT_BUFFER_SIZE += sizeof( type );\n\n" );
+
+	// #define OBJECT_HOT_FIELD
+	output.append( "#define OBJECT_HOT_FIELD( typeID, index, name ) \\\n" );
+	output.append( "\tiObjects::object_hot<typeID>::fields[index] = { \\\n" );
+	output.append( "\t\tstatic_cast<u16>( reinterpret_cast<byte *>( &object->name ) - reinterpret_cast<byte *>( object ) ), \\\n" );
+	output.append( "\t\tstatic_cast<u16>( reinterpret_cast<byte *>( &record->name ) - reinterpret_cast<byte *>( record ) ), \\\n" );
+	output.append( "\t\tstatic_cast<u16>( sizeof( record->name ) ) };\n\n" );
+
+	// #define OBJECT_NET_FIELD & OBJECT_NET_FIELD_HOT
+	output.append( "#define OBJECT_NET_FIELD( typeID, index, name ) \\\n" );
+	output.append( "\ttypeID##_net_fields[index] = { \\\n" );
+	output.append( "\t\tstatic_cast<u16>( reinterpret_cast<byte *>( &object->name ) - reinterpret_cast<byte *>( object ) ), \\\n" );
+	output.append( "\t\tstatic_cast<u16>( sizeof( object->name ) ), U16_MAX };\n\n" );
+	output.append( "#define OBJECT_NET_FIELD_HOT( typeID, index, hotIndex ) \\\n" );
+	output.append( "\ttypeID##_net_fields[index] = { 0, iObjects::object_hot<typeID>::fields[hotIndex].size, hotIndex };\n\n" );
+
 	// bool init()
 	output.append( "bool iObjects::init()\n{\n" );
 	{
@@ -1532,6 +1943,31 @@ void Objects::generate_source_metadata( String &output )
 		output.append( "\tiObjects::OBJECT_CTOR_DEFAULT_BUFFER = reinterpret_cast<byte *>( memory_alloc( iObjects::OBJECT_CTOR_BUFFER_SIZE ) );\n" );
 		output.append( "\tif( iObjects::OBJECT_CTOR_DEFAULT_BUFFER == nullptr ) { return false; }\n\n" );
 
+		// HOT field records & offsets (resolved before the default prototypes are constructed)
+		if( hasHot )
+		{
+			for( ObjectFile *object : objectFilesSorted )
+			{
+				if( object->hot_variable_count() == 0 ) { continue; }
+				output.append( "\tOBJECT_HOT_OFFSET( " ).append( object->name ).append( ", iObjects::" );
+				output.append( object->name ).append( "_hot_t );\n" );
+			}
+			output.append( "\n" );
+
+			output.append( "\tiObjects::OBJECT_CTOR_HOT_MANUAL_BUFFER = reinterpret_cast<byte *>( memory_alloc( iObjects::OBJECT_CTOR_HOT_BUFFER_SIZE ) );\n" );
+			output.append( "\tif( iObjects::OBJECT_CTOR_HOT_MANUAL_BUFFER == nullptr ) { return false; }\n\n" );
+
+			output.append( "\tiObjects::OBJECT_CTOR_HOT_DEFAULT_BUFFER = reinterpret_cast<byte *>( memory_alloc( iObjects::OBJECT_CTOR_HOT_BUFFER_SIZE ) );\n" );
+			output.append( "\tif( iObjects::OBJECT_CTOR_HOT_DEFAULT_BUFFER == nullptr ) { return false; }\n\n" );
+
+			for( ObjectFile *object : objectFilesSorted ) { object->write_source_hot_init(); }
+			output.append( "\n" );
+		}
+
+		// NETWORKED field tables
+		for( ObjectFile *object : objectFilesSorted ) { object->write_source_net_init(); }
+		output.append( "\n" );
+
 		for( ObjectFile *object : objectFilesSorted )
 		{
 			output.append( "\tOBJECT_CONSTRUCTOR_DATA( " );
@@ -1557,6 +1993,14 @@ void Objects::generate_source_metadata( String &output )
 		output.append( "\t\tmemory_free( iObjects::OBJECT_CTOR_DEFAULT_BUFFER );\n" );
 		output.append( "\t\tiObjects::OBJECT_CTOR_DEFAULT_BUFFER = nullptr;\n\t}\n\n" );
 
+		output.append( "\tif( iObjects::OBJECT_CTOR_HOT_MANUAL_BUFFER != nullptr )\n\t{\n" );
+		output.append( "\t\tmemory_free( iObjects::OBJECT_CTOR_HOT_MANUAL_BUFFER );\n" );
+		output.append( "\t\tiObjects::OBJECT_CTOR_HOT_MANUAL_BUFFER = nullptr;\n\t}\n\n" );
+
+		output.append( "\tif( iObjects::OBJECT_CTOR_HOT_DEFAULT_BUFFER != nullptr )\n\t{\n" );
+		output.append( "\t\tmemory_free( iObjects::OBJECT_CTOR_HOT_DEFAULT_BUFFER );\n" );
+		output.append( "\t\tiObjects::OBJECT_CTOR_HOT_DEFAULT_BUFFER = nullptr;\n\t}\n\n" );
+
 		output.append( "\treturn true;\n" );
 	}
 	output.append( "}\n\n" );
@@ -1572,18 +2016,28 @@ void Objects::generate_source_events( String &output )
 		// Skip Certain Events
 		if( eventID == KeywordID_EVENT_CREATE ) { continue; }
 
+		const char *eventName = g_EVENT_FUNCTIONS[eventID][EventFunction_Name];
 		output.append( "void ObjectContext::" );
-		output.append( g_EVENT_FUNCTIONS[eventID][EventFunction_Name] );
+		output.append( eventName );
 		output.append( g_EVENT_FUNCTIONS[eventID][EventFunction_Parameters] );
 		output.append( "\n{\n" );
+		bool profiled = false;
 		for( ObjectFile *object : objectFilesSorted )
 		{
 			if( !object->events[eventID].has || object->events[eventID].manual ) { continue; }
 
+			// Profiling zones (event & per-type loop)
+			if( !profiled )
+			{
+				output.append( "\tPROFILE_ZONE( \"ObjectContext::" ).append( eventName ).append( "\" );\n" );
+				profiled = true;
+			}
+
 			// TODO: Optimize this?
-			output.append( "\tforeach_object( ( *this ), " ).append( object->name ).append( ", handle ) { " );
-			output.append( "handle->" ).append( g_EVENT_FUNCTIONS[eventID][EventFunction_Name] );
-			output.append( g_EVENT_FUNCTIONS[eventID][EventFunction_ParametersCaller] ).append( "; }\n" );
+			output.append( "\t{\n\t\tPROFILE_ZONE( \"" ).append( object->name ).append( "::" ).append( eventName ).append( "\" );\n" );
+			output.append( "\t\tforeach_object( ( *this ), " ).append( object->name ).append( ", handle ) { " );
+			output.append( "handle->" ).append( eventName );
+			output.append( g_EVENT_FUNCTIONS[eventID][EventFunction_ParametersCaller] ).append( "; }\n\t}\n" );
 		}
 		output.append( "}\n\n" );
 	}
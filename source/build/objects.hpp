@@ -57,6 +57,7 @@ enum_type( KeywordID, u8 )
 	KeywordID_PRIVATE,
 	KeywordID_PUBLIC,
 	KeywordID_GLOBAL,
+	KeywordID_HOT,
 
 	KEYWORD_COUNT,
 };
@@ -133,6 +134,15 @@ struct ObjectFile
 	void keyword_EVENT( const String &buffer, Keyword &keyword );
 	void keyword_EVENT_NULL( const String &buffer, Keyword &keyword );
 	void keyword_PRIVATE_PUBLIC_GLOBAL( const String &buffer, Keyword &keyword );
+	void keyword_HOT( const String &buffer, Keyword &keyword );
+
+	void write_header_hot();
+	void write_source_hot_init();
+	usize hot_variable_count(); // including inherited
+
+	void write_source_net_init();
+	usize net_variable_count(); // including inherited (NETWORKED objects only)
+	bool is_networked();
 
 	// ObjectFile Info
 	String name;
@@ -168,6 +178,12 @@ struct ObjectFile
 	List<String> privateVariableHeader;
 	List<String> publicVariableHeader;
 
+	List<String> hotVariableHeader; // e.g. "float x = 0.0f;"
+	List<String> hotVariableType;   // e.g. "float"
+	List<String> hotVariableName;   // e.g. "x"
+
+	List<String> netVariableName;   // replicated PUBLIC data (e.g. "health")
+
 	List<String> privateFunctionHeader;
 	List<String> privateFunctionSource;
 
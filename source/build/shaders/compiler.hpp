@@ -206,6 +206,9 @@ enum_type( Intrinsic, u32 )
 	Intrinsic_SampleTextureCube,
 	Intrinsic_SampleTextureCubeArray,
 	Intrinsic_SampleTexture2DLevel,
+	Intrinsic_Clamp,
+	Intrinsic_Smoothstep,
+	Intrinsic_Fwidth,
 
 	INTRINSIC_COUNT,
 };
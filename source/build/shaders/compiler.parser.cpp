@@ -58,6 +58,9 @@ const char *Intrinsics[] =
 	"sample_textureCube",      // Intrinsic_SampleTextureCube
 	"sample_textureCubeArray", // Intrinsic_SampleTextureCubeArray
 	"sample_texture2DLevel",   // Intrinsic_SampleTexture2DLevel
+	"clamp",                   // Intrinsic_Clamp
+	"smoothstep",              // Intrinsic_Smoothstep
+	"fwidth",                  // Intrinsic_Fwidth
 };
 static_assert( ARRAY_LENGTH( Intrinsics ) == INTRINSIC_COUNT, "Missing Intrinsic!" );
 
@@ -24,7 +24,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #ifndef FPS_MARGIN
-	#define FPS_MARGIN ( 5 )
+	#define FPS_MARGIN ( 5 ) // milliseconds: initial & maximum frame pacer spin-wait (calibrated at runtime)
 #endif
 
 #ifndef FPS_LIMIT
@@ -35,6 +35,18 @@
 	#define DELTA_TIME_FRAMERATE ( 60.0f )
 #endif
 
+#ifndef FIXED_TIMESTEP
+	#define FIXED_TIMESTEP ( 0 ) // Hz: simulate at a fixed rate (Frame::alpha interpolates rendering); 0: once per frame
+#endif
+
+#ifndef FIXED_TIMESTEP_STEPS_MAX
+	#define FIXED_TIMESTEP_STEPS_MAX ( 8 ) // fixed steps per frame (time beyond this is dropped)
+#endif
+
+#ifndef FRAME_PIPELINING
+	#define FRAME_PIPELINING ( 0 ) // 1: simulate frame N+1 on a worker while frame N's draw commands are replayed
+#endif
+
 #ifndef DEPTH_BUFFER_ENABLED
 	#define DEPTH_BUFFER_ENABLED ( false )
 #endif
@@ -75,11 +87,71 @@
 	#define RENDER_QUAD_BATCH_SIZE ( 4096 )
 #endif
 
+#ifndef RENDER_COMMAND_BUFFER_SIZE
+	#define RENDER_COMMAND_BUFFER_SIZE ( 256 * 1024 ) // initial size (grows)
+#endif
+
+#define GFX_VALIDATION_NONE ( 0 )   // No API error checks
+#define GFX_VALIDATION_DEBUG ( 1 )  // Asynchronous driver debug output (e.g. KHR_debug)
+#define GFX_VALIDATION_STRICT ( 2 ) // Error query after every checked API call (e.g. glGetError)
+
+#ifndef GFX_VALIDATION
+	#if COMPILE_DEBUG
+		#define GFX_VALIDATION ( GFX_VALIDATION_DEBUG )
+	#else
+		#define GFX_VALIDATION ( GFX_VALIDATION_NONE )
+	#endif
+#endif
+
+#ifndef RENDER_THREAD
+	#define RENDER_THREAD ( 0 ) // 1: a dedicated thread owns the graphics context and replays recorded frames
+#endif
+
+#ifndef RENDER_THREAD_FRAMES
+	#define RENDER_THREAD_FRAMES ( 2 ) // recorded frames in flight between the game & render threads
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PROFILING
+	#define PROFILING ( COMPILE_DEBUG ) // CPU profiling zones (manta/profiler.hpp)
+#endif
+
+#ifndef PROFILING_ZONES_PER_THREAD
+	#define PROFILING_ZONES_PER_THREAD ( 8192 ) // zones buffered between collections (must be a power of 2)
+#endif
+
+#ifndef PROFILING_THREADS_MAX
+	#define PROFILING_THREADS_MAX ( 64 )
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-#define AUDIO_ALSA ( OS_LINUX | OS_ANDROID )
-#define AUDIO_COREAUDIO ( OS_MACOS | OS_IOS | OS_IPADOS )
-#define AUDIO_WASAPI ( OS_WINDOWS )
+#ifndef JOBS_WORKER_COUNT
+	#define JOBS_WORKER_COUNT ( -1 ) // -1: one worker per core (excluding the main thread)
+#endif
+
+#ifndef JOBS_QUEUE_CAPACITY
+	#define JOBS_QUEUE_CAPACITY ( 4096 ) // per thread (must be a power of 2)
+#endif
+
+#ifndef JOBS_DEFERRED_CAPACITY
+	#define JOBS_DEFERRED_CAPACITY ( 1024 )
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUDIO_ENABLED
+	#define AUDIO_ENABLED ( 0 ) // 1: start the mixer & open a device (set in both the build & runtime config.hpp)
+#endif
+
+#ifndef AUDIO_DEVICE_NONE
+	#define AUDIO_DEVICE_NONE ( 0 ) // 1: 'none' backend on every OS (in-memory sink, e.g. headless benchmarks)
+#endif
+
+#define AUDIO_ALSA ( ( OS_LINUX | OS_ANDROID ) && AUDIO_ENABLED && !AUDIO_DEVICE_NONE )
+#define AUDIO_COREAUDIO ( ( OS_MACOS | OS_IOS | OS_IPADOS ) && AUDIO_ENABLED && !AUDIO_DEVICE_NONE )
+#define AUDIO_WASAPI ( ( OS_WINDOWS ) && AUDIO_ENABLED && !AUDIO_DEVICE_NONE )
 #define AUDIO_NONE ( !( AUDIO_ALSA || AUDIO_COREAUDIO || AUDIO_WASAPI ))
 
 #if AUDIO_ALSA
@@ -92,6 +164,34 @@
 	#define BACKEND_AUDIO "none"
 #endif
 
+#ifndef AUDIO_SAMPLE_RATE
+	#define AUDIO_SAMPLE_RATE ( 48000 ) // output rate (samples at other rates are resampled per voice)
+#endif
+
+#ifndef AUDIO_PERIOD_FRAMES
+	#define AUDIO_PERIOD_FRAMES ( 256 ) // frames mixed per period (must be a multiple of 4)
+#endif
+
+#ifndef AUDIO_PERIODS
+	#define AUDIO_PERIODS ( 2 ) // periods queued in the device (latency: AUDIO_PERIODS * AUDIO_PERIOD_FRAMES)
+#endif
+
+#ifndef AUDIO_VOICES_MAX
+	#define AUDIO_VOICES_MAX ( 256 )
+#endif
+
+#ifndef AUDIO_COMMANDS_MAX
+	#define AUDIO_COMMANDS_MAX ( 1024 ) // voice commands queued between mixer periods
+#endif
+
+#ifndef AUDIO_STREAMS_MAX
+	#define AUDIO_STREAMS_MAX ( 8 ) // sounds streamed concurrently (see Audio::play_stream)
+#endif
+
+#ifndef AUDIO_STREAM_BLOCKS
+	#define AUDIO_STREAM_BLOCKS ( 4 ) // decoded blocks buffered ahead per stream (Assets::soundBlockFrames each)
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #define FILESYSTEM_POSIX ( OS_LINUX | OS_ANDROID | OS_MACOS | OS_IOS | OS_IPADOS )
@@ -120,6 +220,18 @@
 	#define BACKEND_NETWORK "none"
 #endif
 
+#ifndef NETWORK_PACKET_SIZE
+	#define NETWORK_PACKET_SIZE ( 1200 ) // max UDP payload (stays below common path MTUs)
+#endif
+
+#ifndef REPLICATION_HISTORY
+	#define REPLICATION_HISTORY ( 32 ) // states kept as delta baselines (per server & client)
+#endif
+
+#ifndef REPLICATION_PEERS_MAX
+	#define REPLICATION_PEERS_MAX ( 8 )
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #define RENDER_NONE ( !( GRAPHICS_D3D11 || GRAPHICS_D3D12 || GRAPHICS_METAL || GRAPHICS_OPENGL || GRAPHICS_VULKAN ) )
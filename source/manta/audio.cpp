@@ -0,0 +1,837 @@
+#include <manta/audio.hpp>
+
+#include <manta/assets.hpp>
+#include <manta/memory.hpp>
+#include <manta/thread.hpp>
+#include <manta/time.hpp>
+#include <manta/math.hpp>
+#include <manta/profiler.hpp>
+
+#include <vendor/math.hpp>
+#include <vendor/simd.hpp>
+
+#include <adpcm.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static_assert( AUDIO_PERIOD_FRAMES % 4 == 0, "AUDIO_PERIOD_FRAMES must be a multiple of 4" );
+static_assert( AUDIO_VOICES_MAX <= 0xFFFF, "AUDIO_VOICES_MAX must fit in 16 bits" );
+static_assert( AUDIO_STREAM_BLOCKS >= 2, "AUDIO_STREAM_BLOCKS must be at least 2" );
+
+#define AUDIO_CHANNELS ( 2 )
+#define AUDIO_FIXED_ONE ( 1ULL << 32 ) // voice positions are 32.32 fixed point frames
+
+#define VOICE_INDEX( voice ) ( ( voice ) & 0xFFFF )
+#define VOICE_GENERATION( voice ) ( ( voice ) >> 16 )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+enum_type( AudioCommandType, u8 )
+{
+	AudioCommandType_Play,
+	AudioCommandType_Stop,
+	AudioCommandType_StopAll,
+	AudioCommandType_Gain,
+	AudioCommandType_Pan,
+	AudioCommandType_Pitch,
+};
+
+
+struct AudioCommand
+{
+	AudioSample sample;
+	VoiceID voice;
+	i32 stream;
+	float gain;
+	float pan;
+	float pitch;
+	AudioCommandType type;
+	bool loop;
+};
+
+
+struct Voice
+{
+	AudioSample sample;
+	VoiceID id = VOICEID_NULL;
+	u64 position = 0; // 32.32 fixed point frame
+	u64 step = 0;     // 32.32 fixed point frames per output frame
+	float gain = 1.0f;
+	float pan = 0.0f;
+	float gainL = 0.0f; // channel gains reached at the end of the last period (ramp origin)
+	float gainR = 0.0f;
+	i32 stream = -1;  // AudioStream index (-1: 'sample' is resident)
+	u64 lap = 0;      // completed loops of a stream (block sequence = lap * blockCount + block)
+	bool loop = false;
+	bool active = false;
+	bool started = false;
+};
+
+
+enum_type( AudioStreamState, i32 )
+{
+	AudioStreamState_Free,
+	AudioStreamState_Active,
+	AudioStreamState_Released, // voice stopped, freed by the decoder thread once it is no longer decoding it
+};
+
+
+// Blocks are identified by sequence (decode order, counting loops); sequence 's' decodes into ring slot
+// 's % AUDIO_STREAM_BLOCKS'. The decoder may write sequence 's' once 's < read + AUDIO_STREAM_BLOCKS' and the
+// mixer may read it once 's < written'.
+struct AudioStream
+{
+	u32 sound = 0;
+	i64 end = 0;               // sequences to decode (I64_MAX: looping)
+	volatile i64 read = 0;     // sequence the mixer is playing
+	volatile i64 written = 0;  // sequences decoded
+	volatile i32 state = AudioStreamState_Free;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Shared (guarded by 'lock')
+static Mutex lock;
+static AudioCommand commands[AUDIO_COMMANDS_MAX];
+static u32 commandCount = 0;
+static u16 voiceGeneration[AUDIO_VOICES_MAX];
+static AudioStats statistics;
+
+// Cleared by the audio thread when a voice stops, set by Audio::play() when it claims the voice
+static volatile i32 voicePlaying[AUDIO_VOICES_MAX];
+
+// Audio thread
+static Voice voices[AUDIO_VOICES_MAX];
+static AudioCommand commandsPending[AUDIO_COMMANDS_MAX];
+alignas( 16 ) static float bus[AUDIO_PERIOD_FRAMES * AUDIO_CHANNELS];
+alignas( 16 ) static float scratchL[AUDIO_PERIOD_FRAMES];
+alignas( 16 ) static float scratchR[AUDIO_PERIOD_FRAMES];
+alignas( 16 ) static i16 output[AUDIO_PERIOD_FRAMES * AUDIO_CHANNELS];
+
+// Streams
+static AudioStream streams[AUDIO_STREAMS_MAX];
+alignas( 16 ) static float streamBlocks[AUDIO_STREAMS_MAX][AUDIO_STREAM_BLOCKS][Assets::soundBlockFrames * AUDIO_CHANNELS];
+static bool streamsWake = false; // audio thread
+
+// Decoder thread
+static Mutex decodeMutex;
+static Condition decodeCondition;
+static u32 decodeSignal = 0;
+
+static void *thread = nullptr;
+static void *decoder = nullptr;
+static volatile i32 running = 0;
+static bool device = false;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static u64 voice_step( const AudioSample &sample, const float pitch )
+{
+	const double rate = static_cast<double>( sample.sampleRate ) / AUDIO_SAMPLE_RATE * ( pitch > 0.0f ? pitch : 0.0f );
+	return static_cast<u64>( rate * static_cast<double>( AUDIO_FIXED_ONE ) );
+}
+
+
+static void voice_gains( const Voice &voice, float &gainL, float &gainR )
+{
+	const float pan = voice.pan < -1.0f ? -1.0f : ( voice.pan > 1.0f ? 1.0f : voice.pan );
+
+	if( voice.sample.channels == 1 )
+	{
+		// Mono: constant power pan
+		const float angle = ( pan + 1.0f ) * ( PI * 0.25f );
+		gainL = voice.gain * cosf( angle );
+		gainR = voice.gain * sinf( angle );
+	}
+	else
+	{
+		// Stereo: balance
+		gainL = voice.gain * ( pan > 0.0f ? 1.0f - pan : 1.0f );
+		gainR = voice.gain * ( pan < 0.0f ? 1.0f + pan : 1.0f );
+	}
+}
+
+
+static void voice_stop( Voice &voice )
+{
+	voice.active = false;
+
+	if( voice.stream >= 0 )
+	{
+		atomic_store( &streams[voice.stream].state, static_cast<i32>( AudioStreamState_Released ) );
+		voice.stream = -1;
+		streamsWake = true;
+	}
+
+	atomic_store( &voicePlaying[VOICE_INDEX( voice.id )], 0 );
+}
+
+
+static void voice_resample( Voice &voice )
+{
+	// Resamples (linear interpolation) the next period of 'voice' into scratchL & scratchR (mono: scratchL only)
+	const AudioSample &sample = voice.sample;
+	const u64 end = static_cast<u64>( sample.frames ) << 32;
+	const bool stereo = ( sample.channels == 2 );
+	u32 i = 0;
+
+	if( voice.step == AUDIO_FIXED_ONE && ( voice.position & ( AUDIO_FIXED_ONE - 1 ) ) == 0 )
+	{
+		// Native rate: copy contiguous runs
+		while( i < AUDIO_PERIOD_FRAMES )
+		{
+			const u32 frame = static_cast<u32>( voice.position >> 32 );
+			const u32 remaining = sample.frames - frame;
+			const u32 count = AUDIO_PERIOD_FRAMES - i < remaining ? AUDIO_PERIOD_FRAMES - i : remaining;
+
+			if( stereo )
+			{
+				const float *source = sample.data + frame * 2;
+				for( u32 j = 0; j < count; j++ ) { scratchL[i + j] = source[j * 2 + 0]; scratchR[i + j] = source[j * 2 + 1]; }
+			}
+			else
+			{
+				memory_copy( scratchL + i, sample.data + frame, count * sizeof( float ) );
+			}
+
+			i += count;
+			voice.position += static_cast<u64>( count ) << 32;
+			if( voice.position >= end )
+			{
+				if( !voice.loop ) { break; }
+				voice.position = 0;
+			}
+		}
+	}
+	else
+	{
+		for( ; i < AUDIO_PERIOD_FRAMES; i++ )
+		{
+			if( voice.position >= end )
+			{
+				if( !voice.loop ) { break; }
+				voice.position %= end;
+			}
+
+			const u32 frame = static_cast<u32>( voice.position >> 32 );
+			const u32 next = frame + 1 < sample.frames ? frame + 1 : ( voice.loop ? 0 : frame );
+			const float t = static_cast<float>( voice.position & ( AUDIO_FIXED_ONE - 1 ) ) * ( 1.0f / 4294967296.0f );
+
+			if( stereo )
+			{
+				const float *a = sample.data + frame * 2;
+				const float *b = sample.data + next * 2;
+				scratchL[i] = a[0] + ( b[0] - a[0] ) * t;
+				scratchR[i] = a[1] + ( b[1] - a[1] ) * t;
+			}
+			else
+			{
+				const float a = sample.data[frame];
+				const float b = sample.data[next];
+				scratchL[i] = a + ( b - a ) * t;
+			}
+
+			voice.position += voice.step;
+		}
+	}
+
+	// One-shot voice ended mid-period
+	if( i < AUDIO_PERIOD_FRAMES )
+	{
+		memory_set( scratchL + i, 0, ( AUDIO_PERIOD_FRAMES - i ) * sizeof( float ) );
+		if( stereo ) { memory_set( scratchR + i, 0, ( AUDIO_PERIOD_FRAMES - i ) * sizeof( float ) ); }
+		voice_stop( voice );
+	}
+}
+
+
+static bool voice_resample_stream( Voice &voice )
+{
+	// Resamples the next period of a streamed 'voice' from its decoded blocks into scratchL & scratchR. If the
+	// decoder has not caught up, the voice holds its position & the rest of the period is silent (returns false).
+	AudioStream &stream = streams[voice.stream];
+	const DiskSound &sound = Assets::sounds[stream.sound];
+	const u64 end = static_cast<u64>( sound.frames ) << 32;
+	const u64 lapBlocks = sound.blockCount;
+	const i64 written = atomic_load( &stream.written );
+	const bool stereo = ( sound.channels == 2 );
+	bool ended = false;
+	bool starved = false;
+	u32 i = 0;
+
+	for( ; i < AUDIO_PERIOD_FRAMES; i++ )
+	{
+		if( voice.position >= end )
+		{
+			if( !voice.loop ) { ended = true; break; }
+			voice.position %= end;
+			voice.lap++;
+		}
+
+		const u32 frame = static_cast<u32>( voice.position >> 32 );
+		const i64 sequence = static_cast<i64>( voice.lap * lapBlocks + frame / Assets::soundBlockFrames );
+		u32 next = frame + 1;
+		i64 sequenceNext = static_cast<i64>( voice.lap * lapBlocks + next / Assets::soundBlockFrames );
+		if( next >= sound.frames )
+		{
+			next = voice.loop ? 0 : frame;
+			sequenceNext = voice.loop ? static_cast<i64>( ( voice.lap + 1 ) * lapBlocks ) : sequence;
+		}
+
+		if( UNLIKELY( sequenceNext >= written ) ) { starved = true; break; }
+
+		const float *a = streamBlocks[voice.stream][sequence % AUDIO_STREAM_BLOCKS] +
+			( frame % Assets::soundBlockFrames ) * sound.channels;
+		const float *b = streamBlocks[voice.stream][sequenceNext % AUDIO_STREAM_BLOCKS] +
+			( next % Assets::soundBlockFrames ) * sound.channels;
+		const float t = static_cast<float>( voice.position & ( AUDIO_FIXED_ONE - 1 ) ) * ( 1.0f / 4294967296.0f );
+		scratchL[i] = a[0] + ( b[0] - a[0] ) * t;
+		if( stereo ) { scratchR[i] = a[1] + ( b[1] - a[1] ) * t; }
+
+		voice.position += voice.step;
+	}
+
+	// Silence the rest of the period
+	if( i < AUDIO_PERIOD_FRAMES )
+	{
+		memory_set( scratchL + i, 0, ( AUDIO_PERIOD_FRAMES - i ) * sizeof( float ) );
+		if( stereo ) { memory_set( scratchR + i, 0, ( AUDIO_PERIOD_FRAMES - i ) * sizeof( float ) ); }
+	}
+
+	if( ended ) { voice_stop( voice ); return true; }
+
+	// Release consumed blocks to the decoder
+	const u32 frame = static_cast<u32>( voice.position >> 32 );
+	atomic_store( &stream.read, static_cast<i64>( voice.lap * lapBlocks + frame / Assets::soundBlockFrames ) );
+	streamsWake = true;
+
+	// Waiting on the first block is not an underrun
+	return !starved || ( voice.position == 0 && voice.lap == 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void bus_accumulate( const float *left, const float *right, const float gainL0, const float gainR0,
+	const float gainL1, const float gainR1 )
+{
+	// bus += interleave( left, right ) * gain, with gain ramped linearly from gain0 to gain1 across the period
+	const float deltaL = ( gainL1 - gainL0 ) * ( 1.0f / AUDIO_PERIOD_FRAMES );
+	const float deltaR = ( gainR1 - gainR0 ) * ( 1.0f / AUDIO_PERIOD_FRAMES );
+
+#if SIMD_SSE
+	__m128 gain = _mm_setr_ps( gainL0, gainR0, gainL0 + deltaL, gainR0 + deltaR );
+	const __m128 delta = _mm_setr_ps( deltaL * 2.0f, deltaR * 2.0f, deltaL * 2.0f, deltaR * 2.0f );
+	for( u32 i = 0; i < AUDIO_PERIOD_FRAMES; i += 4 )
+	{
+		const __m128 l = _mm_load_ps( left + i );
+		const __m128 r = _mm_load_ps( right + i );
+		float *out = bus + i * AUDIO_CHANNELS;
+		_mm_store_ps( out + 0, _mm_add_ps( _mm_load_ps( out + 0 ), _mm_mul_ps( _mm_unpacklo_ps( l, r ), gain ) ) );
+		gain = _mm_add_ps( gain, delta );
+		_mm_store_ps( out + 4, _mm_add_ps( _mm_load_ps( out + 4 ), _mm_mul_ps( _mm_unpackhi_ps( l, r ), gain ) ) );
+		gain = _mm_add_ps( gain, delta );
+	}
+#elif SIMD_NEON
+	const float gainInit[4] = { gainL0, gainR0, gainL0 + deltaL, gainR0 + deltaR };
+	const float deltaInit[4] = { deltaL * 2.0f, deltaR * 2.0f, deltaL * 2.0f, deltaR * 2.0f };
+	float32x4_t gain = vld1q_f32( gainInit );
+	const float32x4_t delta = vld1q_f32( deltaInit );
+	for( u32 i = 0; i < AUDIO_PERIOD_FRAMES; i += 4 )
+	{
+		const float32x4x2_t lr = vzipq_f32( vld1q_f32( left + i ), vld1q_f32( right + i ) );
+		float *out = bus + i * AUDIO_CHANNELS;
+		vst1q_f32( out + 0, vmlaq_f32( vld1q_f32( out + 0 ), lr.val[0], gain ) );
+		gain = vaddq_f32( gain, delta );
+		vst1q_f32( out + 4, vmlaq_f32( vld1q_f32( out + 4 ), lr.val[1], gain ) );
+		gain = vaddq_f32( gain, delta );
+	}
+#else
+	float gainL = gainL0;
+	float gainR = gainR0;
+	for( u32 i = 0; i < AUDIO_PERIOD_FRAMES; i++ )
+	{
+		bus[i * 2 + 0] += left[i] * gainL;
+		bus[i * 2 + 1] += right[i] * gainR;
+		gainL += deltaL;
+		gainR += deltaR;
+	}
+#endif
+}
+
+
+static void bus_output( i16 *samples )
+{
+	// Clip & convert the float bus to 16-bit PCM
+	const u32 count = AUDIO_PERIOD_FRAMES * AUDIO_CHANNELS;
+
+#if SIMD_SSE
+	const __m128 scale = _mm_set1_ps( 32767.0f );
+	const __m128 low = _mm_set1_ps( -1.0f );
+	const __m128 high = _mm_set1_ps( 1.0f );
+	for( u32 i = 0; i < count; i += 8 )
+	{
+		const __m128 a = _mm_min_ps( _mm_max_ps( _mm_load_ps( bus + i + 0 ), low ), high );
+		const __m128 b = _mm_min_ps( _mm_max_ps( _mm_load_ps( bus + i + 4 ), low ), high );
+		const __m128i packed = _mm_packs_epi32( _mm_cvtps_epi32( _mm_mul_ps( a, scale ) ),
+			_mm_cvtps_epi32( _mm_mul_ps( b, scale ) ) );
+		_mm_store_si128( reinterpret_cast<__m128i *>( samples + i ), packed );
+	}
+#elif SIMD_NEON
+	const float32x4_t scale = vdupq_n_f32( 32767.0f );
+	const float32x4_t low = vdupq_n_f32( -1.0f );
+	const float32x4_t high = vdupq_n_f32( 1.0f );
+	for( u32 i = 0; i < count; i += 8 )
+	{
+		const float32x4_t a = vminq_f32( vmaxq_f32( vld1q_f32( bus + i + 0 ), low ), high );
+		const float32x4_t b = vminq_f32( vmaxq_f32( vld1q_f32( bus + i + 4 ), low ), high );
+		vst1q_s16( samples + i, vcombine_s16( vqmovn_s32( vcvtnq_s32_f32( vmulq_f32( a, scale ) ) ),
+			vqmovn_s32( vcvtnq_s32_f32( vmulq_f32( b, scale ) ) ) ) );
+	}
+#else
+	for( u32 i = 0; i < count; i++ )
+	{
+		const float sample = bus[i] < -1.0f ? -1.0f : ( bus[i] > 1.0f ? 1.0f : bus[i] );
+		samples[i] = static_cast<i16>( sample * 32767.0f );
+	}
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void command_execute( const AudioCommand &command )
+{
+	if( command.type == AudioCommandType_StopAll )
+	{
+		for( u32 i = 0; i < AUDIO_VOICES_MAX; i++ ) { if( voices[i].active ) { voice_stop( voices[i] ); } }
+		return;
+	}
+
+	Voice &voice = voices[VOICE_INDEX( command.voice )];
+
+	if( command.type == AudioCommandType_Play )
+	{
+		voice.sample = command.sample;
+		voice.id = command.voice;
+		voice.position = 0;
+		voice.step = voice_step( command.sample, command.pitch );
+		voice.gain = command.gain;
+		voice.pan = command.pan;
+		voice.loop = command.loop;
+		voice.stream = command.stream;
+		voice.lap = 0;
+		voice.active = true;
+		voice.started = false;
+		return;
+	}
+
+	// Stale handle?
+	if( voice.id != command.voice || !voice.active ) { return; }
+
+	switch( command.type )
+	{
+		case AudioCommandType_Stop: voice_stop( voice ); break;
+		case AudioCommandType_Gain: voice.gain = command.gain; break;
+		case AudioCommandType_Pan: voice.pan = command.pan; break;
+		case AudioCommandType_Pitch: voice.step = voice_step( voice.sample, command.pitch ); break;
+		default: break;
+	}
+}
+
+
+static bool command_push( const AudioCommand &command )
+{
+	// Caller holds 'lock'
+	if( UNLIKELY( commandCount == AUDIO_COMMANDS_MAX ) ) { statistics.commandsDropped++; return false; }
+	commands[commandCount++] = command;
+	return true;
+}
+
+
+static void command_push_voice( const AudioCommandType type, const VoiceID voice, const float value )
+{
+	if( voice == VOICEID_NULL ) { return; }
+
+	AudioCommand command { };
+	command.type = type;
+	command.voice = voice;
+	command.gain = value;
+	command.pan = value;
+	command.pitch = value;
+
+	lock.lock();
+	command_push( command );
+	lock.unlock();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void decode_block( const u32 streamIndex, const i64 sequence )
+{
+	// ADPCM block -> ring slot (interleaved float)
+	const AudioStream &stream = streams[streamIndex];
+	const DiskSound &sound = Assets::sounds[stream.sound];
+	const u32 block = static_cast<u32>( sequence % sound.blockCount );
+	const byte *data = Assets::binary.data + sound.offset + static_cast<usize>( block ) * sound.blockSize;
+	float *pcm = streamBlocks[streamIndex][sequence % AUDIO_STREAM_BLOCKS];
+
+	for( u32 channel = 0; channel < sound.channels; channel++ )
+	{
+		const byte *header = data + channel * ( ADPCM_HEADER_SIZE + Assets::soundBlockFrames / 2 );
+		const byte *nibbles = header + ADPCM_HEADER_SIZE;
+		AdpcmState state;
+		state.predictor = static_cast<i16>( header[0] | ( header[1] << 8 ) );
+		state.index = header[2];
+
+		for( u32 frame = 0; frame < Assets::soundBlockFrames; frame += 2 )
+		{
+			const u8 pair = nibbles[frame / 2];
+			pcm[( frame + 0 ) * sound.channels + channel] = adpcm_decode( state, pair & 0x0F ) * ( 1.0f / 32768.0f );
+			pcm[( frame + 1 ) * sound.channels + channel] = adpcm_decode( state, pair >> 4 ) * ( 1.0f / 32768.0f );
+		}
+	}
+}
+
+
+static THREAD_FUNCTION( decode_thread )
+{
+	u32 signal = 0;
+
+	while( atomic_load( &running ) )
+	{
+		// Decode one block per stream per pass (round robin)
+		bool decoded = false;
+		for( u32 i = 0; i < AUDIO_STREAMS_MAX; i++ )
+		{
+			AudioStream &stream = streams[i];
+			const i32 state = atomic_load( &stream.state );
+			if( state == AudioStreamState_Released ) { atomic_store( &stream.state, static_cast<i32>( AudioStreamState_Free ) ); continue; }
+			if( state != AudioStreamState_Active ) { continue; }
+
+			const i64 sequence = stream.written;
+			if( sequence >= stream.end || sequence >= atomic_load( &stream.read ) + AUDIO_STREAM_BLOCKS ) { continue; }
+
+			const double start = Time::value();
+			decode_block( i, sequence );
+			atomic_store( &stream.written, sequence + 1 );
+			decoded = true;
+
+			const double time = Time::value() - start;
+			lock.lock();
+			statistics.blocksDecoded++;
+			statistics.decodeTime += time;
+			lock.unlock();
+		}
+		if( decoded ) { continue; }
+
+		// Sleep until the mixer consumes a block (or a stream starts)
+		decodeMutex.lock();
+		while( signal == decodeSignal && atomic_load( &running ) ) { decodeCondition.sleep( decodeMutex ); }
+		signal = decodeSignal;
+		decodeMutex.unlock();
+	}
+
+	return 0;
+}
+
+
+static void decode_wake()
+{
+	decodeMutex.lock();
+	decodeSignal++;
+	decodeCondition.wake();
+	decodeMutex.unlock();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void iAudio::mix( i16 *samples )
+{
+	PROFILE_ZONE( "Audio::mix" );
+	const double start = Time::value();
+
+	// Commands
+	lock.lock();
+	const u32 count = commandCount;
+	memory_copy( commandsPending, commands, count * sizeof( AudioCommand ) );
+	commandCount = 0;
+	lock.unlock();
+
+	for( u32 i = 0; i < count; i++ ) { command_execute( commandsPending[i] ); }
+
+	// Voices
+	memory_set( bus, 0, sizeof( bus ) );
+	u32 active = 0;
+	u32 underruns = 0;
+
+	for( u32 i = 0; i < AUDIO_VOICES_MAX; i++ )
+	{
+		Voice &voice = voices[i];
+		if( !voice.active ) { continue; }
+		active++;
+
+		float gainL, gainR;
+		voice_gains( voice, gainL, gainR );
+		if( !voice.started ) { voice.gainL = gainL; voice.gainR = gainR; voice.started = true; }
+
+		const bool stereo = ( voice.sample.channels == 2 );
+		if( voice.stream < 0 ) { voice_resample( voice ); }
+		else if( !voice_resample_stream( voice ) ) { underruns++; }
+		bus_accumulate( scratchL, stereo ? scratchR : scratchL, voice.gainL, voice.gainR, gainL, gainR );
+
+		voice.gainL = gainL;
+		voice.gainR = gainR;
+	}
+
+	bus_output( samples );
+
+	// Decoder
+	if( streamsWake ) { streamsWake = false; decode_wake(); }
+
+	// Statistics
+	const double time = Time::value() - start;
+	lock.lock();
+	statistics.periods++;
+	statistics.voicesMixed += active;
+	statistics.mixTime += time;
+	statistics.mixTimeMax = time > statistics.mixTimeMax ? time : statistics.mixTimeMax;
+	statistics.voicesActive = active;
+	statistics.streamUnderruns += underruns;
+	lock.unlock();
+}
+
+
+static THREAD_FUNCTION( audio_thread )
+{
+	const double period = static_cast<double>( AUDIO_PERIOD_FRAMES ) / AUDIO_SAMPLE_RATE;
+	double deadline = Time::value();
+	bool writing = device;
+
+	while( atomic_load( &running ) )
+	{
+		iAudio::mix( output );
+
+		// The device blocks until it has room for the period (stop writing to it once it fails)
+		if( LIKELY( writing ) )
+		{
+			writing = bAudio::write( output );
+			if( LIKELY( writing ) ) { deadline = Time::value(); continue; }
+		}
+
+		// No device: keep mixing in real time
+		deadline += period;
+		Time::sleep_until( deadline );
+	}
+
+	return 0;
+}
+
+
+bool iAudio::init()
+{
+	lock.init();
+	commandCount = 0;
+	statistics = AudioStats { };
+	for( u32 i = 0; i < AUDIO_VOICES_MAX; i++ )
+	{
+		voices[i] = Voice { };
+		voicePlaying[i] = 0;
+		voiceGeneration[i] = 0;
+	}
+	for( u32 i = 0; i < AUDIO_STREAMS_MAX; i++ ) { streams[i].state = AudioStreamState_Free; }
+	streamsWake = false;
+	decodeMutex.init();
+	decodeCondition.init();
+	if( !AUDIO_ENABLED ) { return true; }
+
+	// Device (continue silently without one, e.g. headless machines)
+	device = bAudio::init();
+	if( !device ) { DebugPrintLn( "Audio: no output device (" BACKEND_AUDIO "), mixing without output" ); }
+
+	// Audio Thread
+	atomic_store( &running, 1 );
+	thread = Thread::create( audio_thread );
+	ErrorReturnIf( thread == nullptr, false, "Audio: failed to create audio thread" );
+
+	// Decoder Thread
+	decoder = Thread::create( decode_thread );
+	ErrorReturnIf( decoder == nullptr, false, "Audio: failed to create decoder thread" );
+
+	// Success
+	return true;
+}
+
+
+bool iAudio::free()
+{
+	atomic_store( &running, 0 );
+
+	if( thread != nullptr )
+	{
+		Thread::join( thread );
+		thread = nullptr;
+	}
+
+	if( decoder != nullptr )
+	{
+		decode_wake();
+		Thread::join( decoder );
+		decoder = nullptr;
+	}
+
+	if( device ) { bAudio::free(); device = false; }
+	decodeCondition.free();
+	decodeMutex.free();
+	lock.free();
+
+	// Success
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static u32 voice_claim()
+{
+	// Caller holds 'lock'
+	u32 index = 0;
+	for( ; index < AUDIO_VOICES_MAX; index++ ) { if( atomic_load( &voicePlaying[index] ) == 0 ) { break; } }
+	if( index < AUDIO_VOICES_MAX ) { voiceGeneration[index]++; }
+	return index;
+}
+
+
+VoiceID Audio::play( const AudioSample &sample, const float gain, const float pan, const float pitch, const bool loop )
+{
+	Assert( sample.channels == 1 || sample.channels == 2 );
+	if( !AUDIO_ENABLED || sample.data == nullptr || sample.frames == 0 ) { return VOICEID_NULL; }
+
+	lock.lock();
+
+	// Claim a voice
+	const u32 index = voice_claim();
+	if( index == AUDIO_VOICES_MAX ) { lock.unlock(); return VOICEID_NULL; }
+	const VoiceID voice = ( static_cast<u32>( voiceGeneration[index] ) << 16 ) | index;
+
+	AudioCommand command { };
+	command.type = AudioCommandType_Play;
+	command.sample = sample;
+	command.voice = voice;
+	command.stream = -1;
+	command.gain = gain;
+	command.pan = pan;
+	command.pitch = pitch;
+	command.loop = loop;
+
+	const bool queued = command_push( command );
+	if( queued ) { atomic_store( &voicePlaying[index], 1 ); }
+	lock.unlock();
+
+	return queued ? voice : VOICEID_NULL;
+}
+
+
+VoiceID Audio::play_stream( const u32 sound, const float gain, const float pan, const float pitch, const bool loop )
+{
+	Assert( sound < Assets::soundsCount );
+	if( !AUDIO_ENABLED ) { return VOICEID_NULL; }
+	const DiskSound &diskSound = Assets::sounds[sound];
+
+	lock.lock();
+
+	// Claim a stream & a voice
+	u32 stream = 0;
+	for( ; stream < AUDIO_STREAMS_MAX; stream++ ) { if( atomic_load( &streams[stream].state ) == AudioStreamState_Free ) { break; } }
+	if( stream == AUDIO_STREAMS_MAX ) { lock.unlock(); return VOICEID_NULL; }
+
+	const u32 index = voice_claim();
+	if( index == AUDIO_VOICES_MAX ) { lock.unlock(); return VOICEID_NULL; }
+	const VoiceID voice = ( static_cast<u32>( voiceGeneration[index] ) << 16 ) | index;
+
+	// Free streams are untouched by the audio & decoder threads
+	AudioStream &audioStream = streams[stream];
+	audioStream.sound = sound;
+	audioStream.end = loop ? I64_MAX : static_cast<i64>( diskSound.blockCount );
+	audioStream.read = 0;
+	audioStream.written = 0;
+	atomic_store( &audioStream.state, static_cast<i32>( AudioStreamState_Active ) );
+
+	AudioCommand command { };
+	command.type = AudioCommandType_Play;
+	command.sample.frames = diskSound.frames;
+	command.sample.sampleRate = diskSound.sampleRate;
+	command.sample.channels = diskSound.channels;
+	command.voice = voice;
+	command.stream = static_cast<i32>( stream );
+	command.gain = gain;
+	command.pan = pan;
+	command.pitch = pitch;
+	command.loop = loop;
+
+	const bool queued = command_push( command );
+	if( queued ) { atomic_store( &voicePlaying[index], 1 ); }
+	else { atomic_store( &audioStream.state, static_cast<i32>( AudioStreamState_Released ) ); }
+	lock.unlock();
+
+	// Start decoding before the voice's first period
+	decode_wake();
+	return queued ? voice : VOICEID_NULL;
+}
+
+
+void Audio::stop( const VoiceID voice )
+{
+	command_push_voice( AudioCommandType_Stop, voice, 0.0f );
+}
+
+
+void Audio::set_gain( const VoiceID voice, const float gain )
+{
+	command_push_voice( AudioCommandType_Gain, voice, gain );
+}
+
+
+void Audio::set_pan( const VoiceID voice, const float pan )
+{
+	command_push_voice( AudioCommandType_Pan, voice, pan );
+}
+
+
+void Audio::set_pitch( const VoiceID voice, const float pitch )
+{
+	command_push_voice( AudioCommandType_Pitch, voice, pitch );
+}
+
+
+bool Audio::playing( const VoiceID voice )
+{
+	if( voice == VOICEID_NULL ) { return false; }
+	const u32 index = VOICE_INDEX( voice );
+	Assert( index < AUDIO_VOICES_MAX );
+
+	lock.lock();
+	const bool current = ( voiceGeneration[index] == VOICE_GENERATION( voice ) );
+	lock.unlock();
+
+	return current && atomic_load( &voicePlaying[index] ) != 0;
+}
+
+
+void Audio::stop_all()
+{
+	AudioCommand command { };
+	command.type = AudioCommandType_StopAll;
+
+	lock.lock();
+	command_push( command );
+	lock.unlock();
+}
+
+
+AudioStats Audio::stats()
+{
+	lock.lock();
+	const AudioStats copy = statistics;
+	lock.unlock();
+	return copy;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1 +1,107 @@
-#pragma once
\ No newline at end of file
+#pragma once
+
+#include <config.hpp>
+#include <types.hpp>
+#include <debug.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Software mixer
+//
+// Voices are mixed on a dedicated audio thread, one period (AUDIO_PERIOD_FRAMES) at a time, into a stereo float
+// bus (SSE/NEON) which is converted to 16-bit PCM and written to the device. The device queues AUDIO_PERIODS
+// periods, so output latency is fixed. Audio:: calls are thread-safe and take effect at the next period boundary;
+// gain & pan changes are ramped across one period.
+//
+// Sound assets (.sound) are packed into the binary as ADPCM and streamed: a decoder thread keeps a ring of
+// AUDIO_STREAM_BLOCKS decoded blocks ahead of each playing stream, and the mixer only reads decoded blocks. Decoded
+// memory is fixed (AUDIO_STREAMS_MAX rings) regardless of track length.
+//
+// The mixer only runs with AUDIO_ENABLED; otherwise no threads are started, no device is opened, and Audio::play()
+// returns VOICEID_NULL.
+//
+//     static AudioSample laser = { data, frames, 22050, 1 };
+//     const VoiceID voice = Audio::play( laser, 0.5f, -0.25f );
+//     Audio::set_pitch( voice, 1.5f );
+//     Audio::play_stream( snd_music, 0.8f, 0.0f, 1.0f, true );
+
+#define VOICEID_NULL ( U32_MAX )
+
+using VoiceID = u32;
+
+
+// PCM sound (interleaved float, 1 or 2 channels); 'data' must outlive every voice playing it
+struct AudioSample
+{
+	const float *data = nullptr;
+	u32 frames = 0;
+	u32 sampleRate = AUDIO_SAMPLE_RATE;
+	u8 channels = 1;
+};
+
+
+struct AudioStats
+{
+	u64 periods = 0;          // periods mixed
+	u64 voicesMixed = 0;      // sum of active voices over every mixed period
+	double mixTime = 0.0;     // seconds spent mixing (excludes device writes)
+	double mixTimeMax = 0.0;  // slowest period
+	u32 voicesActive = 0;     // voices in the last period
+	u32 commandsDropped = 0;  // AUDIO_COMMANDS_MAX exceeded between periods
+	u64 blocksDecoded = 0;    // stream blocks decoded (decoder thread)
+	double decodeTime = 0.0;  // seconds spent decoding (decoder thread)
+	u32 streamUnderruns = 0;  // periods where a playing stream waited on the decoder
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace bAudio
+{
+	// Opens the default device for AUDIO_SAMPLE_RATE 16-bit stereo with AUDIO_PERIODS periods of AUDIO_PERIOD_FRAMES
+	extern bool init();
+	extern bool free();
+
+	// Blocks until the device has queued one period ('samples': AUDIO_PERIOD_FRAMES interleaved stereo frames)
+	extern bool write( const i16 *samples );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace iAudio
+{
+	extern bool init();
+	extern bool free();
+
+	// Mixes one period into 'output' (AUDIO_PERIOD_FRAMES interleaved stereo frames) -- called by the audio thread
+	extern void mix( i16 *output );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Audio
+{
+	// Returns VOICEID_NULL if every voice is in use ('pan': -1 left .. 1 right, 'pitch': playback rate multiplier)
+	extern VoiceID play( const AudioSample &sample, const float gain = 1.0f, const float pan = 0.0f,
+		const float pitch = 1.0f, const bool loop = false );
+
+	// Streams a sound asset (e.g. snd_music); returns VOICEID_NULL if every stream or voice is in use
+	extern VoiceID play_stream( const u32 sound, const float gain = 1.0f, const float pan = 0.0f,
+		const float pitch = 1.0f, const bool loop = false );
+
+	// Voice handles go stale once the voice stops; calls on stale handles are ignored
+	extern void stop( const VoiceID voice );
+	extern void set_gain( const VoiceID voice, const float gain );
+	extern void set_pan( const VoiceID voice, const float pan );
+	extern void set_pitch( const VoiceID voice, const float pitch );
+	extern bool playing( const VoiceID voice );
+
+	extern void stop_all();
+	extern AudioStats stats();
+
+#if AUDIO_NONE
+	// In-memory sink: the most recently written period & the number of frames written since init
+	extern const i16 *sink( u64 &framesWritten );
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1 +1,93 @@
-#include <manta/audio.hpp>
\ No newline at end of file
+#include <manta/audio.hpp>
+
+#include <vendor/alsa.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static snd_pcm_t *device = nullptr;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static bool device_configure()
+{
+	snd_pcm_hw_params_t *hw = nullptr;
+	ErrorReturnIf( snd_pcm_hw_params_malloc( &hw ) < 0, false, "ALSA: failed to allocate hardware parameters" );
+
+	// 16-bit interleaved stereo, AUDIO_PERIODS periods of AUDIO_PERIOD_FRAMES
+	unsigned int rate = AUDIO_SAMPLE_RATE;
+	snd_pcm_uframes_t period = AUDIO_PERIOD_FRAMES;
+	snd_pcm_uframes_t buffer = AUDIO_PERIOD_FRAMES * AUDIO_PERIODS;
+	int error = snd_pcm_hw_params_any( device, hw );
+	if( error >= 0 ) { error = snd_pcm_hw_params_set_access( device, hw, SND_PCM_ACCESS_RW_INTERLEAVED ); }
+	if( error >= 0 ) { error = snd_pcm_hw_params_set_format( device, hw, SND_PCM_FORMAT_S16_LE ); }
+	if( error >= 0 ) { error = snd_pcm_hw_params_set_channels( device, hw, 2 ); }
+	if( error >= 0 ) { error = snd_pcm_hw_params_set_rate_near( device, hw, &rate, nullptr ); }
+	if( error >= 0 ) { error = snd_pcm_hw_params_set_period_size_near( device, hw, &period, nullptr ); }
+	if( error >= 0 ) { error = snd_pcm_hw_params_set_buffer_size_near( device, hw, &buffer ); }
+	if( error >= 0 ) { error = snd_pcm_hw_params( device, hw ); }
+	snd_pcm_hw_params_free( hw );
+
+	ErrorReturnIf( error < 0, false, "ALSA: failed to configure device (%s)", snd_strerror( error ) );
+	ErrorReturnIf( rate != AUDIO_SAMPLE_RATE, false, "ALSA: device does not support %u Hz (nearest: %u Hz)",
+		AUDIO_SAMPLE_RATE, rate );
+
+	// Start once the first period is queued
+	snd_pcm_sw_params_t *sw = nullptr;
+	ErrorReturnIf( snd_pcm_sw_params_malloc( &sw ) < 0, false, "ALSA: failed to allocate software parameters" );
+	error = snd_pcm_sw_params_current( device, sw );
+	if( error >= 0 ) { error = snd_pcm_sw_params_set_start_threshold( device, sw, AUDIO_PERIOD_FRAMES ); }
+	if( error >= 0 ) { error = snd_pcm_sw_params_set_avail_min( device, sw, AUDIO_PERIOD_FRAMES ); }
+	if( error >= 0 ) { error = snd_pcm_sw_params( device, sw ); }
+	snd_pcm_sw_params_free( sw );
+	ErrorReturnIf( error < 0, false, "ALSA: failed to configure device (%s)", snd_strerror( error ) );
+
+	// Success
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool bAudio::init()
+{
+	const int error = snd_pcm_open( &device, "default", SND_PCM_STREAM_PLAYBACK, 0 );
+	ErrorReturnIf( error < 0, false, "ALSA: failed to open default device (%s)", snd_strerror( error ) );
+
+	if( !device_configure() )
+	{
+		snd_pcm_close( device );
+		device = nullptr;
+		return false;
+	}
+
+	// Success
+	return true;
+}
+
+
+bool bAudio::free()
+{
+	if( device == nullptr ) { return true; }
+	snd_pcm_drop( device );
+	snd_pcm_close( device );
+	device = nullptr;
+
+	// Success
+	return true;
+}
+
+
+bool bAudio::write( const i16 *samples )
+{
+	snd_pcm_uframes_t written = 0;
+	while( written < AUDIO_PERIOD_FRAMES )
+	{
+		const snd_pcm_sframes_t frames = snd_pcm_writei( device, samples + written * 2, AUDIO_PERIOD_FRAMES - written );
+		if( frames >= 0 ) { written += static_cast<snd_pcm_uframes_t>( frames ); continue; }
+
+		// Underrun or suspend
+		const int error = snd_pcm_recover( device, static_cast<int>( frames ), 1 );
+		ErrorReturnIf( error < 0, false, "ALSA: write failed (%s)", snd_strerror( error ) );
+	}
+
+	return true;
+}
@@ -1 +1,52 @@
-#include <manta/audio.hpp>
\ No newline at end of file
+#include <manta/audio.hpp>
+
+#include <manta/memory.hpp>
+#include <manta/thread.hpp>
+#include <manta/time.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// In-memory sink: consumes periods in real time so the mixer runs exactly as it would against a device
+
+static i16 sink[AUDIO_PERIOD_FRAMES * 2];
+static volatile i64 sinkFrames = 0;
+static double deadline = 0.0;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool bAudio::init()
+{
+	memory_set( sink, 0, sizeof( sink ) );
+	atomic_store( &sinkFrames, static_cast<i64>( 0 ) );
+	deadline = Time::value();
+
+	// Success
+	return true;
+}
+
+
+bool bAudio::free()
+{
+	return true;
+}
+
+
+bool bAudio::write( const i16 *samples )
+{
+	memory_copy( sink, samples, sizeof( sink ) );
+	atomic_add( &sinkFrames, static_cast<i64>( AUDIO_PERIOD_FRAMES ) );
+
+	// Device clock
+	deadline += static_cast<double>( AUDIO_PERIOD_FRAMES ) / AUDIO_SAMPLE_RATE;
+	const double queued = static_cast<double>( AUDIO_PERIODS - 1 ) * AUDIO_PERIOD_FRAMES / AUDIO_SAMPLE_RATE;
+	Time::sleep_until( deadline - queued );
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const i16 *Audio::sink( u64 &framesWritten )
+{
+	framesWritten = static_cast<u64>( atomic_load( &sinkFrames ) );
+	return ::sink;
+}
@@ -1 +1,22 @@
-#include <manta/audio.hpp>
\ No newline at end of file
+#include <manta/audio.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// TODO: WASAPI output -- until then iAudio mixes without a device (real time, silent)
+
+bool bAudio::init()
+{
+	return false;
+}
+
+
+bool bAudio::free()
+{
+	return true;
+}
+
+
+bool bAudio::write( const i16 *samples )
+{
+	return false;
+}
@@ -57,6 +57,8 @@ static const DXGI_FORMAT D3D11ColorFormats[] =
 	DXGI_FORMAT_R16_UNORM,         // GfxColorFormat_R16
 	DXGI_FORMAT_R16G16_UNORM,      // GfxColorFormat_R16G16
 	DXGI_FORMAT_R32_FLOAT,         // GfxColorFormat_R32
+	DXGI_FORMAT_BC1_UNORM,         // GfxColorFormat_BC1
+	DXGI_FORMAT_BC3_UNORM,         // GfxColorFormat_BC3
 };
 static_assert( ARRAY_LENGTH( D3D11ColorFormats ) == GFXCOLORFORMAT_COUNT, "Missing GfxColorFormat!" );
 
@@ -249,6 +251,7 @@ struct GfxTexture2DResource : public GfxResource
 	GfxColorFormat colorFormat;
 	u32 width = 0;
 	u32 height = 0;
+	u16 levels = 1;
 };
 
 
@@ -432,6 +435,19 @@ bool bGfx::rb_free()
 }
 
 
+bool bGfx::rb_context_acquire()
+{
+	// The immediate context is usable from any (single) thread
+	return true;
+}
+
+
+bool bGfx::rb_context_release()
+{
+	return true;
+}
+
+
 void bGfx::rb_frame_begin()
 {
 	// Reset Render Targets
@@ -1175,7 +1191,8 @@ bool bGfx::rb_constant_buffer_bind_compute( GfxConstantBufferResource *&resource
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool bGfx::rb_texture_2d_init( GfxTexture2DResource *&resource, void *pixels, const u16 width, const u16 height, const GfxColorFormat &format )
+bool bGfx::rb_texture_2d_init( GfxTexture2DResource *&resource, void *pixels, const u16 width, const u16 height,
+	const GfxColorFormat &format, const u16 levels )
 {
 	// Register Texture2D
 	Assert( resource == nullptr );
@@ -1183,12 +1200,14 @@ bool bGfx::rb_texture_2d_init( GfxTexture2DResource *&resource, void *pixels, co
 	resource->colorFormat = format;
 	resource->width = width;
 	resource->height = height;
+	resource->levels = levels;
+	ErrorReturnIf( levels > D3D11_REQ_MIP_LEVELS, false, "%s: Too many mip levels (%u)", __FUNCTION__, levels );
 
 	// Setup Texture Description
 	DECL_ZERO( D3D11_TEXTURE2D_DESC, desc );
 	desc.Width = width;
 	desc.Height = height;
-	desc.MipLevels = 1;
+	desc.MipLevels = levels;
 	desc.ArraySize = 1;
 	desc.Format = D3D11ColorFormats[format];
 	desc.SampleDesc.Count = 1;
@@ -1198,16 +1217,26 @@ bool bGfx::rb_texture_2d_init( GfxTexture2DResource *&resource, void *pixels, co
 	desc.CPUAccessFlags = 0;
 	desc.MiscFlags = 0;
 
-	// Setup Texture Data
-	DECL_ZERO( D3D11_SUBRESOURCE_DATA, data );
-	data.pSysMem = pixels;
-	data.SysMemPitch = width * 4;
-	data.SysMemSlicePitch = 0;
+	// Setup Texture Data (one subresource per mip level, packed back to back)
+	D3D11_SUBRESOURCE_DATA data[D3D11_REQ_MIP_LEVELS];
+	byte *level = reinterpret_cast<byte *>( pixels );
+	u32 levelWidth = width;
+	u32 levelHeight = height;
+	for( u16 i = 0; i < levels; i++ )
+	{
+		data[i].pSysMem = level;
+		data[i].SysMemPitch = bGfx::colorFormatBlockSizeBytes[format] > 0 ?
+			( ( levelWidth + 3 ) / 4 ) * bGfx::colorFormatBlockSizeBytes[format] : levelWidth * bGfx::colorFormatPixelSizeBytes[format];
+		data[i].SysMemSlicePitch = 0;
+		level += GFX_SIZE_IMAGE_COLOR_BYTES( levelWidth, levelHeight, 1, format );
+		levelWidth = levelWidth > 1 ? levelWidth >> 1 : 1;
+		levelHeight = levelHeight > 1 ? levelHeight >> 1 : 1;
+	}
 
 	// Create Texture
 	ID3D11Texture2D *peer = nullptr;
-	PROFILE_GFX( Gfx::stats.gpuMemoryTextures += GFX_SIZE_IMAGE_COLOR_BYTES( width, height, 1, format ) );
-	if( FAILED( device->CreateTexture2D( &desc, &data, &peer ) ) )
+	PROFILE_GFX( Gfx::stats.gpuMemoryTextures += bGfx::mip_chain_size_bytes( width, height, levels, format ) );
+	if( FAILED( device->CreateTexture2D( &desc, data, &peer ) ) )
 	{
 		ErrorReturnMsg( false, "%s: Failed to create texture 2D", __FUNCTION__ );
 	}
@@ -1230,7 +1259,8 @@ bool bGfx::rb_texture_2d_free( GfxTexture2DResource *&resource )
 {
 	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
 
-	PROFILE_GFX( Gfx::stats.gpuMemoryTextures -= GFX_SIZE_IMAGE_COLOR_BYTES( resource->width, resource->height, 1, resource->colorFormat ) );
+	PROFILE_GFX( Gfx::stats.gpuMemoryTextures -=
+		bGfx::mip_chain_size_bytes( resource->width, resource->height, resource->levels, resource->colorFormat ) );
 
 	resource->view->Release();
 	resource->view = nullptr;
@@ -1497,13 +1527,52 @@ bool bGfx::rb_render_target_2d_buffer_read_color( GfxRenderTarget2DResource *&re
 }
 
 
-bool rb_render_target_2d_buffer_read_depth( GfxRenderTarget2DResource *&resource, GfxTexture2DResource *&resourceDepth, void *buffer, const u32 size )
+bool bGfx::rb_render_target_2d_buffer_read_depth( GfxRenderTarget2DResource *&resource, GfxTexture2DResource *&resourceDepth, void *buffer, const u32 size )
 {
+	ErrorIf( !resource->desc.cpuAccess, "Trying to CPU access a render target that does not have CPU access flag!" );
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	Assert( resource->stagingDepth != nullptr );
+	Assert( resourceDepth != nullptr && resourceDepth->id != GFX_RESOURCE_ID_NULL );
+
+	const u32 srcSize = resource->width * resource->height * bGfx::depthFormatPixelSizeBytes[resource->desc.depthFormat];
+	Assert( size > 0 && srcSize <= size );
+	Assert( buffer != nullptr );
+
+	// Copy Data to Staging Texture
+	ID3D11Resource *srcResource;
+	resourceDepth->view->GetResource( &srcResource );
+	context->CopyResource( resource->stagingDepth, srcResource );
+	srcResource->Release();
+
+	// Map Staging Texture
+	DECL_ZERO( D3D11_MAPPED_SUBRESOURCE, mappedResource );
+	context->Map( resource->stagingDepth, 0, D3D11_MAP_READ, 0, &mappedResource );
+
+	// Copy Texture Data
+	memory_copy( buffer, mappedResource.pData, srcSize );
+
+	// Unmap Staging Texture
+	context->Unmap( resource->stagingDepth, 0 );
+
 	// Success
 	return true;
 }
 
 
+bool bGfx::rb_render_target_2d_readback_request( GfxRenderTarget2DResource *&resource, GfxTexture2DResource *&resourceColor,
+                                                 GfxReadbackCallback callback, void *userData )
+{
+	// TODO: Staging texture ring with event queries; for now this falls back to a synchronous read
+	const u32 size = resource->width * resource->height * bGfx::colorFormatPixelSizeBytes[resource->desc.colorFormat];
+	void *pixels = memory_alloc( size );
+	const bool success = rb_render_target_2d_buffer_read_color( resource, resourceColor, pixels, size );
+	if( success ) { callback( pixels, resource->width, resource->height, userData ); }
+	memory_free( pixels );
+
+	return success;
+}
+
+
 bool bGfx::rb_render_target_2d_buffer_write_color( GfxRenderTarget2DResource *&resource, GfxTexture2DResource *&resourceColor, const void *const buffer, const u32 size )
 {
 	ErrorIf( !resource->desc.cpuAccess, "Trying to CPU access a render target that does not have CPU access flag!" );
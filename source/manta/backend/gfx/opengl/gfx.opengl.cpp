@@ -16,16 +16,30 @@
 #include <manta/hashmap.hpp>
 #include <manta/memory.hpp>
 #include <manta/list.hpp>
+#include <manta/buffer.hpp>
+#include <manta/fileio.hpp>
+#include <manta/string.hpp>
 
 #include <vendor/crc32.hpp>
 
 #define GL_NULL ( 0 )
 
-#define CHECK_ERROR(msg,...) { int error = glGetError(); ErrorIf( error != GL_NO_ERROR, msg " (%d)\n", error, __VA_ARGS__ ); }
+// Validation (GFX_VALIDATION)
+// STRICT queries glGetError after every checked call; DEBUG relies on the KHR_debug callback instead
+#if GFX_VALIDATION == GFX_VALIDATION_STRICT
+	#define CHECK_ERROR( message, ... ) \
+		{ const GLenum error = glGetError(); ErrorIf( error != GL_NO_ERROR, message " (%u)", ##__VA_ARGS__, error ); }
+	#define CHECK_ERROR_RETURN( value, message, ... ) \
+		{ const GLenum error = glGetError(); ErrorReturnIf( error != GL_NO_ERROR, value, message " (%u)", ##__VA_ARGS__, error ); }
+#else
+	#define CHECK_ERROR( message, ... )
+	#define CHECK_ERROR_RETURN( value, message, ... )
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 static GfxShaderResource *boundShaderResource = nullptr;
+static GLuint boundFramebuffer = GL_NULL;
 
 static HashMap<u32, GLuint> constantBufferUniformBlockIndices;
 static HashMap<u32, GLint> texture2DUniformLocations;
@@ -51,29 +65,30 @@ static const OpenGLColorFormat OpenGLColorFormats[] =
 	{ GL_RED,  GL_R16F,     GL_UNSIGNED_SHORT },          // GfxColorFormat_R16
 	{ GL_RG,   GL_RG16F,    GL_UNSIGNED_SHORT },          // GfxColorFormat_R16G16
 	{ GL_RED,  GL_R32F,     GL_FLOAT },                   // GfxColorFormat_R32
+	{ GL_RGBA, GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, GL_UNSIGNED_BYTE }, // GfxColorFormat_BC1
+	{ GL_RGBA, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, GL_UNSIGNED_BYTE }, // GfxColorFormat_BC3
 };
 static_assert( ARRAY_LENGTH( OpenGLColorFormats ) == GFXCOLORFORMAT_COUNT, "Missing GfxColorFormat!" );
 
-/*
-struct D3D11DepthStencilFormat
+struct OpenGLDepthFormat
 {
-	D3D11DepthStencilFormat( const DXGI_FORMAT t2DFormat, const DXGI_FORMAT dsvFormat, const DXGI_FORMAT srvFormat ) :
-		texture2DDescFormat{ t2DFormat }, depthStencilViewDescFormat{ dsvFormat }, shaderResourceViewDescFormat{ srvFormat }{ }
+	OpenGLDepthFormat( const GLenum format, const GLenum formatInternal, const GLenum formatType, const GLenum attachment ) :
+		format{ format }, formatInternal{ formatInternal }, formatType{ formatType }, attachment{ attachment } { }
 
-	DXGI_FORMAT texture2DDescFormat, depthStencilViewDescFormat, shaderResourceViewDescFormat;
+	GLenum format, formatInternal, formatType, attachment;
 };
 
-static const D3D11DepthStencilFormat D3D11DepthStencilFormats[] =
+
+static const OpenGLDepthFormat OpenGLDepthFormats[] =
 {
-	{ DXGI_FORMAT_UNKNOWN,        DXGI_FORMAT_UNKNOWN,           DXGI_FORMAT_UNKNOWN, },              // GfxDepthFormat_NONE
-	{ DXGI_FORMAT_R16_TYPELESS,   DXGI_FORMAT_D16_UNORM,         DXGI_FORMAT_R16_FLOAT },             // GfxDepthFormat_R16_FLOAT
-	{ DXGI_FORMAT_R16_TYPELESS,   DXGI_FORMAT_D16_UNORM,         DXGI_FORMAT_R16_UINT },              // GfxDepthFormat_R16_UINT
-	{ DXGI_FORMAT_R32_TYPELESS,   DXGI_FORMAT_D32_FLOAT,         DXGI_FORMAT_R32_FLOAT },             // GfxDepthFormat_R32_FLOAT
-	{ DXGI_FORMAT_R16_TYPELESS,   DXGI_FORMAT_D16_UNORM,         DXGI_FORMAT_R32_UINT },              // GfxDepthFormat_R32_UINT
-	{ DXGI_FORMAT_R24G8_TYPELESS, DXGI_FORMAT_D24_UNORM_S8_UINT, DXGI_FORMAT_R24_UNORM_X8_TYPELESS }, // GfxDepthFormat_R24_UINT_G8_UINT
+	{ GL_DEPTH_COMPONENT, GL_DEPTH_COMPONENT16,  GL_UNSIGNED_SHORT,    GL_DEPTH_ATTACHMENT },         // GfxDepthFormat_NONE
+	{ GL_DEPTH_COMPONENT, GL_DEPTH_COMPONENT16,  GL_UNSIGNED_SHORT,    GL_DEPTH_ATTACHMENT },         // GfxDepthFormat_R16_FLOAT
+	{ GL_DEPTH_COMPONENT, GL_DEPTH_COMPONENT16,  GL_UNSIGNED_SHORT,    GL_DEPTH_ATTACHMENT },         // GfxDepthFormat_R16_UINT
+	{ GL_DEPTH_COMPONENT, GL_DEPTH_COMPONENT32F, GL_FLOAT,             GL_DEPTH_ATTACHMENT },         // GfxDepthFormat_R32_FLOAT
+	{ GL_DEPTH_COMPONENT, GL_DEPTH_COMPONENT24,  GL_UNSIGNED_INT,      GL_DEPTH_ATTACHMENT },         // GfxDepthFormat_R32_UINT
+	{ GL_DEPTH_STENCIL,   GL_DEPTH24_STENCIL8,   GL_UNSIGNED_INT_24_8, GL_DEPTH_STENCIL_ATTACHMENT }, // GfxDepthFormat_R24_UINT_G8_UINT
 };
-static_assert( ARRAY_LENGTH( D3D11DepthStencilFormats ) == GFXDEPTHFORMAT_COUNT, "Missing GfxDepthFormat!" );
-*/
+static_assert( ARRAY_LENGTH( OpenGLDepthFormats ) == GFXDEPTHFORMAT_COUNT, "Missing GfxDepthFormat!" );
 
 static const GLenum OpenGLFillModes[] =
 {
@@ -101,6 +116,15 @@ static const GLint OpenGLFilteringModes[] =
 static_assert( ARRAY_LENGTH( OpenGLFilteringModes ) == GFXFILTERINGMODE_COUNT, "Missing GfxFilteringMode!" );
 
 
+static const GLint OpenGLFilteringModesMinify[] =
+{
+	GL_NEAREST_MIPMAP_LINEAR, // GfxFilteringMode_NEAREST
+	GL_LINEAR_MIPMAP_LINEAR,  // GfxFilteringMode_LINEAR
+	GL_LINEAR_MIPMAP_LINEAR,  // GfxFilteringMode_ANISOTROPIC TODO: Support anisotrophic
+};
+static_assert( ARRAY_LENGTH( OpenGLFilteringModesMinify ) == GFXFILTERINGMODE_COUNT, "Missing GfxFilteringMode!" );
+
+
 static const GLint OpenGLUVWrapModes[] =
 {
 	GL_REPEAT,          // GfxUVWrapMode_WRAP
@@ -246,17 +270,13 @@ struct GfxTexture2DResource : public GfxResource
 	GfxColorFormat colorFormat;
 	u32 width = 0;
 	u32 height = 0;
+	u16 levels = 1;
 };
 
 
 struct GfxRenderTarget2DResource : public GfxResource
 {
-	/*
-	ID3D11RenderTargetView *targetColor = nullptr;
-	ID3D11DepthStencilView *targetDepth = nullptr;
-	ID3D11Texture2D *stagingColor = nullptr;
-	ID3D11Texture2D *stagingDepth = nullptr;
-	*/
+	GLuint fbo;
 	GfxRenderTargetDescription desc = { };
 	u16 width = 0;
 	u16 height = 0;
@@ -271,6 +291,9 @@ struct GfxShaderResource : public GfxResource
 	GLuint program;
 	u32 sizeVS, sizePS, sizeCS;
 	u32 shaderID;
+	u32 cacheKey;
+	bool cached = false;   // program was created from the program binary cache
+	bool resolved = false; // link status has been verified (deferred until first use)
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -394,6 +417,458 @@ static GLint opengl_texture_uniform_location( HashMap<u32, GLint> &cache, const
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Program Binary Cache
+//
+// Linked programs are retrieved with glGetProgramBinary and written to <project>.glcache at the end of each frame
+// that linked new programs (so a crash keeps the programs linked before it). The cache is
+// keyed per shader by a checksum of its source & vertex format, and the whole file is discarded whenever the
+// driver (vendor/renderer/version strings) changes.
+
+#define SHADER_CACHE_MAGIC ( 0x4353474D ) // "MGSC"
+#define SHADER_CACHE_VERSION ( 1 )
+
+struct ShaderCacheEntry
+{
+	GLenum format = 0;
+	u32 size = 0;
+	byte *data = nullptr;
+};
+
+static HashMap<u32, ShaderCacheEntry> shaderCacheEntries;
+static u32 shaderCacheDriverKey = 0;
+static bool shaderCacheDirty = false;
+static char shaderCachePath[PATH_SIZE];
+
+static bool supportsProgramBinary = false;
+static bool supportsParallelShaderCompile = false;
+
+
+static bool opengl_extension_supported( const char *name )
+{
+	GLint count = 0;
+	glGetIntegerv( GL_NUM_EXTENSIONS, &count );
+
+	for( GLint i = 0; i < count; i++ )
+	{
+		const char *extension = reinterpret_cast<const char *>( nglGetStringi( GL_EXTENSIONS, static_cast<GLuint>( i ) ) );
+		if( extension != nullptr && strcmp( extension, name ) == 0 ) { return true; }
+	}
+
+	return false;
+}
+
+
+static u32 opengl_driver_key()
+{
+	const GLenum strings[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+	u32 key = 0;
+
+	for( u32 i = 0; i < ARRAY_LENGTH( strings ); i++ )
+	{
+		const char *string = reinterpret_cast<const char *>( glGetString( strings[i] ) );
+		if( string == nullptr ) { continue; }
+		key = checksum_xcrc32( string, strlen( string ), key );
+	}
+
+	return key;
+}
+
+
+static u32 opengl_shader_cache_key( const DiskShader &diskShader )
+{
+	const char *codeVertex = reinterpret_cast<const char *>( Assets::binary.data + diskShader.offsetVertex );
+	const char *codeFragment = reinterpret_cast<const char *>( Assets::binary.data + diskShader.offsetFragment );
+
+	u32 key = checksum_xcrc32( codeVertex, diskShader.sizeVertex, diskShader.vertexFormat );
+	key = checksum_xcrc32( codeFragment, diskShader.sizeFragment, key );
+
+	// U32_MAX is the HashMap null key
+	return key == U32_MAX ? 0 : key;
+}
+
+
+static bool opengl_shader_cache_path( char *buffer, const usize size )
+{
+	const int length = snprintf( buffer, size, "%s" SLASH "%s.glcache", WORKING_DIRECTORY, BUILD_PROJECT );
+	return length > 0 && static_cast<usize>( length ) < size;
+}
+
+
+static void opengl_shader_cache_init()
+{
+	shaderCacheEntries.init();
+	shaderCacheDirty = false;
+	if( !supportsProgramBinary ) { return; }
+
+	// Cache File Path (disable the cache rather than use a truncated path)
+	if( !opengl_shader_cache_path( shaderCachePath, sizeof( shaderCachePath ) ) )
+	{
+		PrintLnColor( LOG_YELLOW, "OpenGL: Shader cache path too long, program binary cache disabled" );
+		supportsProgramBinary = false;
+		return;
+	}
+
+	shaderCacheDriverKey = opengl_driver_key();
+
+	// Load Cache File
+	Buffer cache;
+	if( !cache.load( shaderCachePath, false ) ) { return; }
+
+	// Validate Header
+	const u32 magic = cache.read<u32>();
+	const u32 version = cache.read<u32>();
+	const u32 driverKey = cache.read<u32>();
+	const u32 count = cache.read<u32>();
+	if( magic != SHADER_CACHE_MAGIC || version != SHADER_CACHE_VERSION || driverKey != shaderCacheDriverKey )
+	{
+		cache.free();
+		shaderCacheDirty = true;
+		return;
+	}
+
+	// Read Entries
+	for( u32 i = 0; i < count; i++ )
+	{
+		const u32 key = cache.read<u32>();
+		ShaderCacheEntry entry;
+		entry.format = cache.read<u32>();
+		entry.size = cache.read<u32>();
+		if( entry.size == 0 || cache.tell + entry.size > cache.current ) { shaderCacheDirty = true; break; }
+
+		entry.data = reinterpret_cast<byte *>( memory_alloc( entry.size ) );
+		memory_copy( entry.data, cache.data + cache.tell, entry.size );
+		cache.tell += entry.size;
+
+		if( !shaderCacheEntries.add( key, entry ) ) { memory_free( entry.data ); }
+	}
+
+	cache.free();
+}
+
+
+static void opengl_shader_cache_save()
+{
+	if( !supportsProgramBinary || !shaderCacheDirty ) { return; }
+	shaderCacheDirty = false;
+
+	u32 count = 0;
+	for( ShaderCacheEntry &entry : shaderCacheEntries ) { count += entry.data != nullptr; }
+
+	Buffer cache;
+	cache.init( 1024, true );
+	cache.write<u32>( SHADER_CACHE_MAGIC );
+	cache.write<u32>( SHADER_CACHE_VERSION );
+	cache.write<u32>( shaderCacheDriverKey );
+	cache.write<u32>( count );
+
+	for( auto itr = shaderCacheEntries.begin(); itr != shaderCacheEntries.end(); ++itr )
+	{
+		const ShaderCacheEntry &entry = itr.ptr->value;
+		if( entry.data == nullptr ) { continue; }
+		cache.write<u32>( itr.ptr->key );
+		cache.write<u32>( entry.format );
+		cache.write<u32>( entry.size );
+		cache.write( entry.data, entry.size );
+	}
+
+	if( !cache.save( shaderCachePath ) ) { PrintLnColor( LOG_YELLOW, "OpenGL: Failed to write shader cache (%s)", shaderCachePath ); }
+	cache.free();
+}
+
+
+static void opengl_shader_cache_free()
+{
+	// Write Cache File
+	opengl_shader_cache_save();
+
+	// Free Entries
+	for( ShaderCacheEntry &entry : shaderCacheEntries )
+	{
+		if( entry.data != nullptr ) { memory_free( entry.data ); }
+		entry.data = nullptr;
+	}
+	shaderCacheEntries.free();
+}
+
+
+static bool opengl_shader_cache_load( GfxShaderResource *const resource )
+{
+	if( !supportsProgramBinary ) { return false; }
+
+	ShaderCacheEntry &entry = shaderCacheEntries.find( resource->cacheKey ).value;
+	if( !shaderCacheEntries.contains( resource->cacheKey ) || entry.data == nullptr ) { return false; }
+
+	// The driver may still reject the binary; link status is verified in opengl_shader_resolve()
+	nglProgramBinary( resource->program, entry.format, entry.data, static_cast<GLsizei>( entry.size ) );
+	return true;
+}
+
+
+static void opengl_shader_cache_store( GfxShaderResource *const resource )
+{
+	if( !supportsProgramBinary ) { return; }
+
+	GLint size = 0;
+	nglGetProgramiv( resource->program, GL_PROGRAM_BINARY_LENGTH, &size );
+	if( size <= 0 ) { return; }
+
+	ShaderCacheEntry entry;
+	entry.size = static_cast<u32>( size );
+	entry.data = reinterpret_cast<byte *>( memory_alloc( entry.size ) );
+	nglGetProgramBinary( resource->program, size, nullptr, &entry.format, entry.data );
+
+	// Replace stale entry
+	ShaderCacheEntry &existing = shaderCacheEntries.find( resource->cacheKey ).value;
+	if( shaderCacheEntries.contains( resource->cacheKey ) && existing.data != nullptr ) { memory_free( existing.data ); }
+	shaderCacheEntries.set( resource->cacheKey, entry );
+	shaderCacheDirty = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void opengl_shader_compile( GfxShaderResource *const resource, const DiskShader &diskShader )
+{
+	// Create Shaders
+	resource->shaderVertex = nglCreateShader( GL_VERTEX_SHADER );
+	resource->shaderFragment = nglCreateShader( GL_FRAGMENT_SHADER );
+
+	// Source Shaders
+	const byte *codeVertex = Assets::binary.data + diskShader.offsetVertex;
+	nglShaderSource( resource->shaderVertex, 1, reinterpret_cast<const GLchar **>( &codeVertex ),
+	                                            reinterpret_cast<const GLint *>( &diskShader.sizeVertex ) );
+
+	const byte *codeFragment = Assets::binary.data + diskShader.offsetFragment;
+	nglShaderSource( resource->shaderFragment, 1, reinterpret_cast<const GLchar **>( &codeFragment ),
+	                                              reinterpret_cast<const GLint *>( &diskShader.sizeFragment ) );
+
+	// Compile Shaders
+	// Compile status is not queried here; doing so would stall on the driver's compiler thread.
+	nglCompileShader( resource->shaderVertex );
+	nglCompileShader( resource->shaderFragment );
+
+	// Attach Shaders
+	nglAttachShader( resource->program, resource->shaderVertex );
+	nglAttachShader( resource->program, resource->shaderFragment );
+	// TODO... compute shaders
+
+	// Input Layout
+	bGfx::opengl_vertex_input_layout_init[diskShader.vertexFormat]( resource->program );
+
+	// Link Program
+	if( supportsProgramBinary ) { nglProgramParameteri( resource->program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE ); }
+	nglLinkProgram( resource->program );
+}
+
+
+static void opengl_shader_delete_shaders( GfxShaderResource *const resource )
+{
+	if( resource->shaderVertex != GL_NULL ) { nglDeleteShader( resource->shaderVertex ); }
+	if( resource->shaderFragment != GL_NULL ) { nglDeleteShader( resource->shaderFragment ); }
+	resource->shaderVertex = GL_NULL;
+	resource->shaderFragment = GL_NULL;
+}
+
+
+static bool opengl_shader_ready( GfxShaderResource *const resource )
+{
+	// Without KHR_parallel_shader_compile, we can't poll without blocking
+	if( !supportsParallelShaderCompile ) { return false; }
+
+	GLint complete = GL_FALSE;
+	nglGetProgramiv( resource->program, GL_COMPLETION_STATUS_KHR, &complete );
+	return complete == GL_TRUE;
+}
+
+
+static bool opengl_shader_resolve( GfxShaderResource *const resource )
+{
+	if( resource->resolved ) { return true; }
+	const DiskShader &diskShader = Gfx::diskShaders[resource->shaderID];
+
+	// Link Status (blocks until the driver finishes compiling)
+	GLint status = GL_FALSE;
+	nglGetProgramiv( resource->program, GL_LINK_STATUS, &status );
+
+	// Cached binary rejected (i.e. driver update) -- rebuild from source
+	if( status == GL_FALSE && resource->cached )
+	{
+		resource->cached = false;
+		nglDeleteProgram( resource->program );
+		resource->program = nglCreateProgram();
+		opengl_shader_compile( resource, diskShader );
+		nglGetProgramiv( resource->program, GL_LINK_STATUS, &status );
+	}
+
+	if( status == GL_FALSE )
+	{
+	#if COMPILE_DEBUG
+		// TODO: Shader names in error messages
+		char info[1024];
+
+		// Check Vertex Shader
+		if( nglGetShaderiv( resource->shaderVertex, GL_COMPILE_STATUS, &status ), !status )
+		{
+			nglGetShaderInfoLog( resource->shaderVertex, sizeof( info ), nullptr, info );
+			ErrorReturnMsg( false, "%s: Failed to compile vertex shader (%u)\nVertex shader error: %s", __FUNCTION__, resource->shaderID, info );
+		}
+
+		// Check Fragment Shader
+		if( nglGetShaderiv( resource->shaderFragment, GL_COMPILE_STATUS, &status ), !status )
+		{
+			nglGetShaderInfoLog( resource->shaderFragment, sizeof( info ), nullptr, info );
+			ErrorReturnMsg( false, "%s: Failed to compile fragment shader (%u)\nFragment shader error: %s", __FUNCTION__, resource->shaderID, info );
+		}
+
+		// Check Program
+		nglGetProgramInfoLog( resource->program, sizeof( info ), nullptr, info );
+		ErrorReturnMsg( false, "%s: Failed to link shader program (%u)\nLink error: %s", __FUNCTION__, resource->shaderID, info );
+	#else
+		ErrorReturnMsg( false, "%s: Failed to link shader program (%u)", __FUNCTION__, resource->shaderID );
+	#endif
+	}
+
+	// Delete Shaders
+	opengl_shader_delete_shaders( resource );
+
+	// Cache Program Binary
+	if( !resource->cached ) { opengl_shader_cache_store( resource ); }
+
+	// Success
+	resource->resolved = true;
+	return true;
+}
+
+
+static void opengl_shader_poll()
+{
+	// Resolve shaders that finished compiling in the background so their binaries reach the cache
+	if( !supportsParallelShaderCompile ) { return; }
+
+	for( u32 i = 0; i < Gfx::shadersCount; i++ )
+	{
+		GfxShaderResource *const resource = bGfx::shaders[i].resource;
+		if( resource == nullptr || resource->resolved ) { continue; }
+		if( !opengl_shader_ready( resource ) ) { continue; }
+		ErrorIf( !opengl_shader_resolve( resource ), "Failed to create shader! (%u)", resource->shaderID );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if GFX_VALIDATION == GFX_VALIDATION_DEBUG && !GL_MAC
+static void GL_API opengl_debug_callback( GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length,
+                                          const GLchar *message, const void *userParam )
+{
+	const bool error = ( type == GL_DEBUG_TYPE_ERROR || severity == GL_DEBUG_SEVERITY_HIGH );
+	PrintLnColor( error ? LOG_RED : LOG_YELLOW, "OpenGL: %s (id: %u)", message, id );
+}
+#endif
+
+
+static void opengl_debug_init()
+{
+#if GFX_VALIDATION == GFX_VALIDATION_DEBUG && !GL_MAC
+	// Requires OpenGL 4.3 or KHR_debug
+	if( nglDebugMessageCallback == nullptr ) { return; }
+
+	// Asynchronous: GL_DEBUG_OUTPUT_SYNCHRONOUS is left disabled so the driver never stalls on validation
+	glEnable( GL_DEBUG_OUTPUT );
+	nglDebugMessageCallback( opengl_debug_callback, nullptr );
+
+	// Ignore notifications
+	if( nglDebugMessageControl != nullptr )
+	{
+		nglDebugMessageControl( GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, false );
+	}
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Readback
+//
+// Asynchronous readbacks glReadPixels into a ring of pixel-pack buffers, each followed by a fence. Requests complete
+// in order: rb_frame_end polls the oldest fence without waiting and only maps its buffer once the fence has signalled,
+// so the CPU never stalls on the GPU.
+
+struct OpenGLReadback
+{
+	GLuint pbo = GL_NULL;
+	GLsync fence = nullptr;
+	u32 capacity = 0; // pbo size in bytes
+	u32 size = 0;
+	u32 frame = 0;
+	u16 width = 0;
+	u16 height = 0;
+	GfxReadbackCallback callback = nullptr;
+	void *userData = nullptr;
+};
+
+static OpenGLReadback readbacks[GFX_READBACK_RING_SIZE];
+static u32 readbackFirst = 0;
+static u32 readbackCount = 0;
+static u32 readbackFrame = 0;
+
+
+static void opengl_read_pixels( const GLuint fbo, const u16 width, const u16 height, const GLenum format,
+                                const GLenum type, void *pixels )
+{
+	// Read through GL_READ_FRAMEBUFFER so the draw framebuffer binding is left untouched
+	nglBindFramebuffer( GL_READ_FRAMEBUFFER, fbo );
+	glPixelStorei( GL_PACK_ALIGNMENT, 1 );
+	glReadPixels( 0, 0, width, height, format, type, pixels );
+	nglBindFramebuffer( GL_READ_FRAMEBUFFER, boundFramebuffer );
+}
+
+
+static void opengl_readback_poll()
+{
+	readbackFrame++;
+
+	while( readbackCount > 0 )
+	{
+		OpenGLReadback &readback = readbacks[readbackFirst];
+		if( readbackFrame - readback.frame < GFX_READBACK_LATENCY ) { break; }
+
+		// Poll (timeout 0: never wait, try again next frame)
+		const GLenum status = nglClientWaitSync( readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0 );
+		if( status == GL_TIMEOUT_EXPIRED ) { break; }
+		ErrorIf( status == GL_WAIT_FAILED, "OpenGL: Failed to poll readback fence" );
+		nglDeleteSync( readback.fence );
+		readback.fence = nullptr;
+
+		// Map & Callback (the slot stays reserved, so readbacks queued by the callback can not reuse its buffer)
+		nglBindBuffer( GL_PIXEL_PACK_BUFFER, readback.pbo );
+		const void *pixels = nglMapBufferRange( GL_PIXEL_PACK_BUFFER, 0, readback.size, GL_MAP_READ_BIT );
+		CHECK_ERROR( "Failed to map readback buffer" );
+		if( pixels != nullptr ) { readback.callback( pixels, readback.width, readback.height, readback.userData ); }
+		nglBindBuffer( GL_PIXEL_PACK_BUFFER, readback.pbo );
+		nglUnmapBuffer( GL_PIXEL_PACK_BUFFER );
+		nglBindBuffer( GL_PIXEL_PACK_BUFFER, GL_NULL );
+
+		readbackFirst = ( readbackFirst + 1 ) % GFX_READBACK_RING_SIZE;
+		readbackCount--;
+	}
+}
+
+
+static void opengl_readback_free()
+{
+	// Pending readbacks are dropped
+	for( OpenGLReadback &readback : readbacks )
+	{
+		PROFILE_GFX( Gfx::stats.gpuMemoryRenderTargets -= readback.capacity );
+		if( readback.fence != nullptr ) { nglDeleteSync( readback.fence ); }
+		if( readback.pbo != GL_NULL ) { nglDeleteBuffers( 1, &readback.pbo ); }
+		readback = { };
+	}
+
+	readbackFirst = 0;
+	readbackCount = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 bool bGfx::rb_init()
 {
 	// GfxState
@@ -408,6 +883,9 @@ bool bGfx::rb_init()
 		ErrorReturnMsg( false, "%s: Failed to init OpenGL", __FUNCTION__ );
 	}
 
+	// Validation
+	opengl_debug_init();
+
 //#if DEPTH_BUFFER_ENABLED
 	glEnable( GL_DEPTH_TEST );
 	glDepthMask( true );
@@ -420,6 +898,26 @@ bool bGfx::rb_init()
 	constantBufferUniformBlockIndices.init();
 	texture2DUniformLocations.init();
 
+	// Program Binaries
+#if GL_MAC
+	supportsProgramBinary = true;
+#else
+	supportsProgramBinary = nglGetProgramBinary != nullptr && nglProgramBinary != nullptr && nglProgramParameteri != nullptr;
+#endif
+	GLint programBinaryFormats = 0;
+	if( supportsProgramBinary ) { glGetIntegerv( GL_NUM_PROGRAM_BINARY_FORMATS, &programBinaryFormats ); }
+	supportsProgramBinary = programBinaryFormats > 0;
+	opengl_shader_cache_init();
+
+	// Parallel Shader Compilation
+#if GL_MAC
+	supportsParallelShaderCompile = false;
+#else
+	supportsParallelShaderCompile = nglMaxShaderCompilerThreadsKHR != nullptr &&
+	                                opengl_extension_supported( "GL_KHR_parallel_shader_compile" );
+	if( supportsParallelShaderCompile ) { nglMaxShaderCompilerThreadsKHR( 0xFFFFFFFF ); } // Let the driver decide
+#endif
+
 	// Success
 	return true;
 }
@@ -427,6 +925,9 @@ bool bGfx::rb_init()
 
 bool bGfx::rb_free()
 {
+	// Readbacks
+	opengl_readback_free();
+
 	// Resources
 	resources_free();
 
@@ -434,11 +935,26 @@ bool bGfx::rb_free()
 	constantBufferUniformBlockIndices.free();
 	texture2DUniformLocations.free();
 
+	// Program Binaries
+	opengl_shader_cache_free();
+
 	// Success
 	return true;
 }
 
 
+bool bGfx::rb_context_acquire()
+{
+	return opengl_make_current( true );
+}
+
+
+bool bGfx::rb_context_release()
+{
+	return opengl_make_current( false );
+}
+
+
 void bGfx::rb_frame_begin()
 {
 	// OpenGL does nothing
@@ -447,13 +963,22 @@ void bGfx::rb_frame_begin()
 
 void bGfx::rb_frame_end()
 {
-#if COMPILE_DEBUG
+	// Resolve Pending Shaders
+	opengl_shader_poll();
+
+	// Write newly linked programs to the cache
+	opengl_shader_cache_save();
+
+	// Complete Readbacks
+	opengl_readback_poll();
+
+#if GFX_VALIDATION == GFX_VALIDATION_STRICT
 	// Check OpenGL errors
 	while( true )
 	{
-		int error = glGetError();
+		const GLenum error = glGetError();
 		if( error == GL_NO_ERROR ) { break; }
-		Error( "OpenGL Error: %d\n", error );
+		Error( "OpenGL Error: %u\n", error );
 	}
 #endif
 
@@ -537,8 +1062,8 @@ bool bGfx::rb_set_raster_state( const GfxRasterState &state )
 
 bool bGfx::rb_set_sampler_state( const GfxSamplerState &state )
 {
-	// Filter Mode
-	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, OpenGLFilteringModes[state.filterMode] );
+	// Filter Mode (textures clamp GL_TEXTURE_MAX_LEVEL to their mip count, so the mipmapped minify is always complete)
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, OpenGLFilteringModesMinify[state.filterMode] );
 	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, OpenGLFilteringModes[state.filterMode] );
 
 	// UV Wrap Mode
@@ -693,9 +1218,6 @@ bool bGfx::rb_vertex_buffer_free( GfxVertexBufferResource *&resource )
 	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
 	PROFILE_GFX( Gfx::stats.gpuMemoryVertexBuffers -= resource->size );
 
-	PrintLn( "Draw Start" );
-	CHECK_ERROR( "draw start" );
-
 	nglDeleteVertexArrays( 1, &resource->vao );
 	resource->vao = GL_NULL;
 	nglDeleteBuffers( 1, &resource->vbo );
@@ -704,8 +1226,6 @@ bool bGfx::rb_vertex_buffer_free( GfxVertexBufferResource *&resource )
 	resource = nullptr;
 
 	// Success
-	PrintLn( "Draw End" );
-	CHECK_ERROR( "draw end" );
 	return true;
 }
 
@@ -947,7 +1467,8 @@ bool bGfx::rb_constant_buffer_bind_compute( GfxConstantBufferResource *&resource
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool bGfx::rb_texture_2d_init( GfxTexture2DResource *&resource, void *pixels, const u16 width, const u16 height, const GfxColorFormat &format )
+bool bGfx::rb_texture_2d_init( GfxTexture2DResource *&resource, void *pixels, const u16 width, const u16 height,
+	const GfxColorFormat &format, const u16 levels )
 {
 	// Register Texture2D
 	Assert( resource == nullptr );
@@ -955,16 +1476,13 @@ bool bGfx::rb_texture_2d_init( GfxTexture2DResource *&resource, void *pixels, co
 	resource->colorFormat = format;
 	resource->width = width;
 	resource->height = height;
+	resource->levels = levels;
 
 	// Create Texture
 	glGenTextures( 1, &resource->texture );
 
 	// Check Errors
-	GLenum error = glGetError();
-	if( error != GL_NO_ERROR )
-	{
-		ErrorReturnMsg( false, "%s: Failed to init texture (%d)", __FUNCTION__, error );
-	}
+	CHECK_ERROR_RETURN( false, "%s: Failed to init texture", __FUNCTION__ );
 
 	// Setup Texture2D Data (TODO: Switch to sampler objects)
 	glBindTexture( GL_TEXTURE_2D, resource->texture );
@@ -972,13 +1490,37 @@ bool bGfx::rb_texture_2d_init( GfxTexture2DResource *&resource, void *pixels, co
 	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
 	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
 	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0 );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1 );
 	const GLint glFormatInternal = OpenGLColorFormats[format].formatInternal;
 	const GLenum glFormat = OpenGLColorFormats[format].format;
 	const GLenum glFormatType = OpenGLColorFormats[format].formatType;
-	glTexImage2D( GL_TEXTURE_2D, 0, glFormatInternal, width, height, 0, glFormat, glFormatType, pixels );
+
+	// Upload mip levels (packed back to back)
+	byte *level = reinterpret_cast<byte *>( pixels );
+	u16 levelWidth = width;
+	u16 levelHeight = height;
+	const bool compressed = bGfx::colorFormatBlockSizeBytes[format] > 0;
+	for( u16 i = 0; i < levels; i++ )
+	{
+		const GLsizei size = static_cast<GLsizei>( GFX_SIZE_IMAGE_COLOR_BYTES( levelWidth, levelHeight, 1, format ) );
+		if( compressed )
+		{
+			Assert( level != nullptr );
+			nglCompressedTexImage2D( GL_TEXTURE_2D, i, glFormatInternal, levelWidth, levelHeight, 0, size, level );
+		}
+		else
+		{
+			glTexImage2D( GL_TEXTURE_2D, i, glFormatInternal, levelWidth, levelHeight, 0, glFormat, glFormatType, level );
+		}
+		if( level != nullptr ) { level += size; }
+		levelWidth = levelWidth > 1 ? levelWidth >> 1 : 1;
+		levelHeight = levelHeight > 1 ? levelHeight >> 1 : 1;
+	}
 	glBindTexture( GL_TEXTURE_2D, 0 );
+	CHECK_ERROR_RETURN( false, "%s: Failed to upload texture (format: %u)", __FUNCTION__, format );
 
-	PROFILE_GFX( Gfx::stats.gpuMemoryTextures += GFX_SIZE_IMAGE_COLOR_BYTES( width, height, 1, format ) );
+	PROFILE_GFX( Gfx::stats.gpuMemoryTextures += bGfx::mip_chain_size_bytes( width, height, levels, format ) );
 
 	// Success
 	return true;
@@ -988,7 +1530,8 @@ bool bGfx::rb_texture_2d_init( GfxTexture2DResource *&resource, void *pixels, co
 bool bGfx::rb_texture_2d_free( GfxTexture2DResource *&resource )
 {
 	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
-	PROFILE_GFX( Gfx::stats.gpuMemoryTextures -= GFX_SIZE_IMAGE_COLOR_BYTES( resource->width, resource->height, 1, resource->colorFormat ) );
+	PROFILE_GFX( Gfx::stats.gpuMemoryTextures -=
+		bGfx::mip_chain_size_bytes( resource->width, resource->height, resource->levels, resource->colorFormat ) );
 
 	glDeleteTextures( 1, &resource->texture );
 	resource->texture = GL_NULL;
@@ -1028,13 +1571,96 @@ bool bGfx::rb_texture_2d_release( const int slot )
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-//static ID3D11RenderTargetView *RT_CACHE_TARGET_COLOR; // HACK: change this?
-//static ID3D11DepthStencilView *RT_CACHE_TARGET_DEPTH; // HACK: change this?
+static void opengl_framebuffer_bind( const GLuint fbo )
+{
+	// The frontend state filters redundant render target binds; this also covers unbinding from rb_render_target_2d_free
+	if( boundFramebuffer == fbo ) { return; }
+	nglBindFramebuffer( GL_FRAMEBUFFER, fbo );
+	boundFramebuffer = fbo;
+	PROFILE_GFX( Gfx::stats.frame.renderTargetBinds++ );
+}
 
 
 bool bGfx::rb_render_target_2d_init( GfxRenderTarget2DResource *&resource, GfxTexture2DResource *&resourceColor, GfxTexture2DResource *&resourceDepth,
                                      const u16 width, const u16 height, const GfxRenderTargetDescription &desc )
 {
+	// Register RenderTarget2D
+	Assert( resource == nullptr );
+	resource = renderTarget2DResources.make_new();
+	resource->width = width;
+	resource->height = height;
+	resource->desc = desc;
+
+	// Creating textures disturbs the frontend's texture binding; restore it afterwards
+	GLint textureBound = 0;
+	glGetIntegerv( GL_TEXTURE_BINDING_2D, &textureBound );
+
+	// Framebuffer
+	nglGenFramebuffers( 1, &resource->fbo );
+	nglBindFramebuffer( GL_FRAMEBUFFER, resource->fbo );
+	CHECK_ERROR_RETURN( false, "%s: Failed to create framebuffer", __FUNCTION__ );
+
+	// Color
+	{
+		// Register Texture2D
+		Assert( resourceColor == nullptr );
+		resourceColor = texture2DResources.make_new();
+		resourceColor->colorFormat = desc.colorFormat;
+		resourceColor->width = width;
+		resourceColor->height = height;
+
+		// Create Texture
+		glGenTextures( 1, &resourceColor->texture );
+		glBindTexture( GL_TEXTURE_2D, resourceColor->texture );
+		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0 );
+		const OpenGLColorFormat &format = OpenGLColorFormats[desc.colorFormat];
+		glTexImage2D( GL_TEXTURE_2D, 0, format.formatInternal, width, height, 0, format.format, format.formatType, nullptr );
+
+		// Attach
+		nglFramebufferTexture2D( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, resourceColor->texture, 0 );
+		CHECK_ERROR_RETURN( false, "%s: Failed to create color texture", __FUNCTION__ );
+
+		PROFILE_GFX( Gfx::stats.gpuMemoryRenderTargets += GFX_SIZE_IMAGE_COLOR_BYTES( width, height, 1, desc.colorFormat ) );
+	}
+
+	// Depth
+	if( desc.depthFormat != GfxDepthFormat_NONE )
+	{
+		// Register Texture2D
+		Assert( resourceDepth == nullptr );
+		resourceDepth = texture2DResources.make_new();
+		resourceDepth->colorFormat = GfxColorFormat_NONE;
+		resourceDepth->width = width;
+		resourceDepth->height = height;
+
+		// Create Texture
+		glGenTextures( 1, &resourceDepth->texture );
+		glBindTexture( GL_TEXTURE_2D, resourceDepth->texture );
+		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+		glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0 );
+		const OpenGLDepthFormat &format = OpenGLDepthFormats[desc.depthFormat];
+		glTexImage2D( GL_TEXTURE_2D, 0, format.formatInternal, width, height, 0, format.format, format.formatType, nullptr );
+
+		// Attach
+		nglFramebufferTexture2D( GL_FRAMEBUFFER, format.attachment, GL_TEXTURE_2D, resourceDepth->texture, 0 );
+		CHECK_ERROR_RETURN( false, "%s: Failed to create depth texture", __FUNCTION__ );
+
+		PROFILE_GFX( Gfx::stats.gpuMemoryRenderTargets += GFX_SIZE_IMAGE_DEPTH_BYTES( width, height, 1, desc.depthFormat ) );
+	}
+
+	// Validate
+	const GLenum status = nglCheckFramebufferStatus( GL_FRAMEBUFFER );
+	nglBindFramebuffer( GL_FRAMEBUFFER, boundFramebuffer );
+	glBindTexture( GL_TEXTURE_2D, static_cast<GLuint>( textureBound ) );
+	ErrorReturnIf( status != GL_FRAMEBUFFER_COMPLETE, false, "%s: Framebuffer is incomplete (status: 0x%X)", __FUNCTION__, status );
+
 	// Success
 	return true;
 }
@@ -1042,6 +1668,38 @@ bool bGfx::rb_render_target_2d_init( GfxRenderTarget2DResource *&resource, GfxTe
 
 bool bGfx::rb_render_target_2d_free( GfxRenderTarget2DResource *&resource, GfxTexture2DResource *&resourceColor, GfxTexture2DResource *&resourceDepth )
 {
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+
+	// Depth
+	if( resource->desc.depthFormat != GfxDepthFormat_NONE )
+	{
+		Assert( resourceDepth != nullptr && resourceDepth->id != GFX_RESOURCE_ID_NULL );
+		PROFILE_GFX( Gfx::stats.gpuMemoryRenderTargets -= GFX_SIZE_IMAGE_DEPTH_BYTES( resource->width, resource->height, 1, resource->desc.depthFormat ) );
+
+		glDeleteTextures( 1, &resourceDepth->texture );
+		resourceDepth->texture = GL_NULL;
+		texture2DResources.remove( resourceDepth->id );
+		resourceDepth = nullptr;
+	}
+
+	// Color
+	{
+		Assert( resourceColor != nullptr && resourceColor->id != GFX_RESOURCE_ID_NULL );
+		PROFILE_GFX( Gfx::stats.gpuMemoryRenderTargets -= GFX_SIZE_IMAGE_COLOR_BYTES( resource->width, resource->height, 1, resource->desc.colorFormat ) );
+
+		glDeleteTextures( 1, &resourceColor->texture );
+		resourceColor->texture = GL_NULL;
+		texture2DResources.remove( resourceColor->id );
+		resourceColor = nullptr;
+	}
+
+	// Framebuffer
+	if( boundFramebuffer == resource->fbo ) { opengl_framebuffer_bind( GL_NULL ); }
+	nglDeleteFramebuffers( 1, &resource->fbo );
+	resource->fbo = GL_NULL;
+	renderTarget2DResources.remove( resource->id );
+	resource = nullptr;
+
 	// Success
 	return true;
 }
@@ -1049,13 +1707,80 @@ bool bGfx::rb_render_target_2d_free( GfxRenderTarget2DResource *&resource, GfxTe
 
 bool bGfx::rb_render_target_2d_buffer_read_color( GfxRenderTarget2DResource *&resource, GfxTexture2DResource *&resourceColor, void *buffer, const u32 size )
 {
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	Assert( resourceColor != nullptr && resourceColor->id != GFX_RESOURCE_ID_NULL );
+
+	const u32 srcSize = GFX_SIZE_IMAGE_COLOR_BYTES( resource->width, resource->height, 1, resource->desc.colorFormat );
+	Assert( size > 0 && srcSize <= size );
+	Assert( buffer != nullptr );
+
+	// Read Pixels (blocks until the GPU has finished rendering to the target)
+	const OpenGLColorFormat &format = OpenGLColorFormats[resource->desc.colorFormat];
+	opengl_read_pixels( resource->fbo, resource->width, resource->height, format.format, format.formatType, buffer );
+	CHECK_ERROR_RETURN( false, "%s: Failed to read render target color", __FUNCTION__ );
+
+	// Success
+	return true;
+}
+
+
+bool bGfx::rb_render_target_2d_buffer_read_depth( GfxRenderTarget2DResource *&resource, GfxTexture2DResource *&resourceDepth, void *buffer, const u32 size )
+{
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	Assert( resourceDepth != nullptr && resourceDepth->id != GFX_RESOURCE_ID_NULL );
+
+	const u32 srcSize = GFX_SIZE_IMAGE_DEPTH_BYTES( resource->width, resource->height, 1, resource->desc.depthFormat );
+	Assert( size > 0 && srcSize <= size );
+	Assert( buffer != nullptr );
+
+	// Read Pixels (blocks until the GPU has finished rendering to the target)
+	const OpenGLDepthFormat &format = OpenGLDepthFormats[resource->desc.depthFormat];
+	opengl_read_pixels( resource->fbo, resource->width, resource->height, format.format, format.formatType, buffer );
+	CHECK_ERROR_RETURN( false, "%s: Failed to read render target depth", __FUNCTION__ );
+
 	// Success
 	return true;
 }
 
 
-bool rb_render_target_2d_buffer_read_depth( GfxRenderTarget2DResource *&resource, GfxTexture2DResource *&resourceDepth, void *buffer, const u32 size )
+bool bGfx::rb_render_target_2d_readback_request( GfxRenderTarget2DResource *&resource, GfxTexture2DResource *&resourceColor,
+                                                 GfxReadbackCallback callback, void *userData )
 {
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	Assert( resourceColor != nullptr && resourceColor->id != GFX_RESOURCE_ID_NULL );
+
+	// Ring full
+	if( readbackCount == GFX_READBACK_RING_SIZE ) { return false; }
+
+	OpenGLReadback &readback = readbacks[( readbackFirst + readbackCount ) % GFX_READBACK_RING_SIZE];
+	readback.size = GFX_SIZE_IMAGE_COLOR_BYTES( resource->width, resource->height, 1, resource->desc.colorFormat );
+	readback.frame = readbackFrame;
+	readback.width = resource->width;
+	readback.height = resource->height;
+	readback.callback = callback;
+	readback.userData = userData;
+
+	// Pixel Buffer (grown on demand)
+	if( readback.pbo == GL_NULL ) { nglGenBuffers( 1, &readback.pbo ); }
+	nglBindBuffer( GL_PIXEL_PACK_BUFFER, readback.pbo );
+	if( readback.capacity < readback.size )
+	{
+		PROFILE_GFX( Gfx::stats.gpuMemoryRenderTargets += readback.size - readback.capacity );
+		nglBufferData( GL_PIXEL_PACK_BUFFER, readback.size, nullptr, GL_STREAM_READ );
+		readback.capacity = readback.size;
+	}
+
+	// Read Pixels (returns immediately: the copy lands in the bound pixel-pack buffer)
+	const OpenGLColorFormat &format = OpenGLColorFormats[resource->desc.colorFormat];
+	opengl_read_pixels( resource->fbo, resource->width, resource->height, format.format, format.formatType, nullptr );
+	nglBindBuffer( GL_PIXEL_PACK_BUFFER, GL_NULL );
+	CHECK_ERROR_RETURN( false, "%s: Failed to queue render target readback", __FUNCTION__ );
+
+	// Fence
+	readback.fence = nglFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+	ErrorReturnIf( readback.fence == nullptr, false, "%s: Failed to create readback fence", __FUNCTION__ );
+	readbackCount++;
+
 	// Success
 	return true;
 }
@@ -1070,6 +1795,9 @@ bool bGfx::rb_render_target_2d_buffer_write_color( GfxRenderTarget2DResource *&r
 
 bool bGfx::rb_render_target_2d_bind( const GfxRenderTarget2DResource *const &resource, int slot )
 {
+	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
+	opengl_framebuffer_bind( resource->fbo );
+
 	// Success
 	return true;
 }
@@ -1077,6 +1805,8 @@ bool bGfx::rb_render_target_2d_bind( const GfxRenderTarget2DResource *const &res
 
 bool bGfx::rb_render_target_2d_release()
 {
+	opengl_framebuffer_bind( GL_NULL );
+
 	// Success
 	return true;
 }
@@ -1089,66 +1819,21 @@ bool bGfx::rb_shader_init( GfxShaderResource *&resource, const u32 shaderID, con
 	Assert( resource == nullptr );
 	resource = shaderResources.make_new();
 	resource->shaderID = shaderID;
-
-	// Create Shaders
-	resource->shaderVertex = nglCreateShader( GL_VERTEX_SHADER );
-	resource->shaderFragment = nglCreateShader( GL_FRAGMENT_SHADER );
-
-	// Source Shaders
-	const byte *codeVertex = Assets::binary.data + diskShader.offsetVertex;
-	nglShaderSource( resource->shaderVertex, 1, reinterpret_cast<const GLchar **>( &codeVertex ),
-	                                            reinterpret_cast<const GLint *>( &diskShader.sizeVertex ) );
-
-	const byte *codeFragment = Assets::binary.data + diskShader.offsetFragment;
-	nglShaderSource( resource->shaderFragment, 1, reinterpret_cast<const GLchar **>( &codeFragment ),
-	                                              reinterpret_cast<const GLint *>( &diskShader.sizeFragment ) );
-
-	// Compile Shaders
-	nglCompileShader( resource->shaderVertex );
-	nglCompileShader( resource->shaderFragment );
-
-	char info[1024];
-	int status;
-
-	// Check Vertex Shader
-	if( nglGetShaderiv( resource->shaderVertex, GL_COMPILE_STATUS, &status ), !status )
-	{
-	#if COMPILE_DEBUG
-		// TODO: Shader names in error messages
-		nglGetShaderInfoLog( resource->shaderVertex, sizeof( info ), nullptr, info );
-		ErrorReturnMsg( false, "%s: Failed to get vertex shader info log (%u)\nVertex shader error: %s", __FUNCTION__, shaderID, info );
-	#endif
-	}
-
-	// Check Fragment Shader
-	if( nglGetShaderiv( resource->shaderFragment, GL_COMPILE_STATUS, &status ), !status )
-	{
-	#if COMPILE_DEBUG
-		// TODO: Shader names in error messages
-		nglGetShaderInfoLog( resource->shaderFragment, sizeof( info ), nullptr, info );
-		ErrorReturnMsg( false, "%s: Failed to get fragment shader info log (%u)\nFragment shader error: %s", __FUNCTION__, shaderID, info );
-	#endif
-	}
+	resource->shaderVertex = GL_NULL;
+	resource->shaderFragment = GL_NULL;
+	resource->shaderCompute = GL_NULL;
+	resource->cacheKey = opengl_shader_cache_key( diskShader );
+	resource->resolved = false;
 
 	// Create Program
+	// Only the compile & link are issued here; status is checked on first bind (see opengl_shader_resolve)
 	resource->program = nglCreateProgram();
-	nglAttachShader( resource->program, resource->shaderVertex );
-	nglAttachShader( resource->program, resource->shaderFragment );
-	// TODO... compute shaders
-
-	// Input Layout
-	opengl_vertex_input_layout_init[Gfx::diskShaders[shaderID].vertexFormat]( resource->program );
-
-	// Link Program
-	nglLinkProgram( resource->program );
-
-	// Delete Shaders
-	nglDeleteShader( resource->shaderVertex );
-	nglDeleteShader( resource->shaderFragment );
+	resource->cached = opengl_shader_cache_load( resource );
+	if( !resource->cached ) { opengl_shader_compile( resource, diskShader ); }
 
 	resource->sizeVS = diskShader.sizeVertex;
 	PROFILE_GFX( Gfx::stats.gpuMemoryShaderPrograms += resource->sizeVS );
-	resource->sizeVS = diskShader.sizeFragment;
+	resource->sizePS = diskShader.sizeFragment;
 	PROFILE_GFX( Gfx::stats.gpuMemoryShaderPrograms += resource->sizePS );
 
 	// Success
@@ -1163,6 +1848,7 @@ bool bGfx::rb_shader_free( GfxShaderResource *&resource )
 	PROFILE_GFX( Gfx::stats.gpuMemoryShaderPrograms -= resource->sizeVS );
 	PROFILE_GFX( Gfx::stats.gpuMemoryShaderPrograms -= resource->sizePS );
 
+	opengl_shader_delete_shaders( resource );
 	nglDeleteProgram( resource->program );
 	resource->program = GL_NULL;
 	shaderResources.remove( resource->id );
@@ -1177,6 +1863,12 @@ bool bGfx::rb_shader_bind( GfxShaderResource *&resource )
 {
 	Assert( resource != nullptr && resource->id != GFX_RESOURCE_ID_NULL );
 
+	// Deferred compile & link status
+	if( UNLIKELY( !resource->resolved ) )
+	{
+		ErrorReturnIf( !opengl_shader_resolve( resource ), false, "%s: Failed to create shader (%u)", __FUNCTION__, resource->shaderID );
+	}
+
 	boundShaderResource = resource;
 	nglUseProgram( resource->program );
 
@@ -19,6 +19,9 @@
 // the framebuffer config used to create the window
 static GLXFBConfig config;
 
+// The OpenGL context
+static GLXContext context;
+
 // The pixel format descriptor.
 static const int pfd[]
 {
@@ -47,7 +50,7 @@ static const int attributes[]
     GLX_CONTEXT_PROFILE_MASK_ARB, GLX_CONTEXT_CORE_PROFILE_BIT_ARB,
 
     // Enable Debug
-#if COMPILE_DEBUG
+#if GFX_VALIDATION != GFX_VALIDATION_NONE
     GLX_CONTEXT_FLAGS_ARB, GLX_CONTEXT_DEBUG_BIT_ARB,
 #endif
 
@@ -58,8 +61,6 @@ static const int attributes[]
 
 bool opengl_init()
 {
-    GLXContext context;
-
     // Load GLX Procedures
 	#undef  META
 	#define META(type, name, ...)                                                             \
@@ -101,6 +102,13 @@ bool opengl_swap()
 }
 
 
+bool opengl_make_current( const bool current )
+{
+    return current ? glXMakeCurrent( iWindow::display, iWindow::handle, context ) :
+                     glXMakeCurrent( iWindow::display, None, nullptr );
+}
+
+
 void *opengl_proc( const char *name )
 {
     return reinterpret_cast<void *>( glXGetProcAddress( reinterpret_cast<const GLubyte *>( name ) ) );
@@ -64,6 +64,15 @@ bool opengl_swap()
 }
 
 
+bool opengl_make_current( const bool current )
+{
+	if( current ) { [context makeCurrentContext]; } else { [NSOpenGLContext clearCurrentContext]; }
+
+	// Success
+	return true;
+}
+
+
 void *opengl_proc( const char *name )
 {
 	return nullptr;
@@ -25,7 +25,12 @@ bool opengl_load()
 			if( ( n##name = reinterpret_cast<n##name##proc>( opengl_proc( #name ) ) ) == nullptr )  \
 				{ ErrorReturnMsg( false, "OPENGL: Failed to load OpenGL procedure (%s)", #name ); }
 
+		#undef  META_OPTIONAL
+		#define META_OPTIONAL(type, name, ...)                                                      \
+			n##name = reinterpret_cast<n##name##proc>( opengl_proc( #name ) );
+
 		#include "opengl.procedures.hpp"
+		#undef  META_OPTIONAL
 	#endif
 
 	// Success
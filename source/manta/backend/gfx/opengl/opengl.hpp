@@ -615,6 +615,18 @@
 #define GL_PROGRAM_BINARY_LENGTH                         0x8741
 #define GL_NUM_PROGRAM_BINARY_FORMATS                    0x87FE
 #define GL_PROGRAM_BINARY_FORMATS                        0x87FF
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR               0x91B0
+#define GL_COMPLETION_STATUS_KHR                         0x91B1
+#define GL_DEBUG_OUTPUT                                  0x92E0
+#define GL_DEBUG_OUTPUT_SYNCHRONOUS                      0x8242
+#define GL_DEBUG_TYPE_ERROR                              0x824C
+#define GL_DEBUG_SEVERITY_HIGH                           0x9146
+#define GL_DEBUG_SEVERITY_MEDIUM                         0x9147
+#define GL_DEBUG_SEVERITY_LOW                            0x9148
+#define GL_DEBUG_SEVERITY_NOTIFICATION                   0x826B
+#define GL_DONT_CARE                                     0x1100
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT                 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT                 0x83F3
 #define GL_COMPRESSED_R11_EAC                            0x9270
 #define GL_COMPRESSED_SIGNED_R11_EAC                     0x9271
 #define GL_COMPRESSED_RG11_EAC                           0x9272
@@ -644,17 +656,23 @@ using GLenum     = unsigned int;
 using GLbitfield = unsigned int;
 using GLfloat    = float;
 using GLclampf   = float;
+using GLsync     = struct __GLsync *;
 
 #if PIPELINE_OS_WINDOWS
 	// Windows
 	using GLsizeiptr = i64;
 	using GLintptr   = i64;
+	using GLuint64   = u64;
 #else
 	// Everything Else
 	using GLsizeiptr = signed long;
 	using GLintptr   = signed long;
+	using GLuint64   = __UINT64_TYPE__; // must match the system headers' uint64_t
 #endif
 
+using GLDEBUGPROC = void (GL_API *)( GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length,
+                                     const GLchar *message, const void *userParam );
+
 #if !GL_MAC
 	// Define OpenGL Procedures
 	#undef  META
@@ -704,11 +722,22 @@ using GLclampf   = float;
 	#define nglUniformBlockBinding glUniformBlockBinding
 	#define nglBufferSubData glBufferSubData
 	#define nglDrawBuffers glDrawBuffers
+	#define nglGetProgramiv glGetProgramiv
+	#define nglGetProgramInfoLog glGetProgramInfoLog
+	#define nglGetStringi glGetStringi
+	#define nglGetProgramBinary glGetProgramBinary
+	#define nglProgramBinary glProgramBinary
+	#define nglProgramParameteri glProgramParameteri
+	#define nglFenceSync glFenceSync
+	#define nglClientWaitSync glClientWaitSync
+	#define nglDeleteSync glDeleteSync
+	#define nglCompressedTexImage2D glCompressedTexImage2D
 #endif
 
 
 extern bool  opengl_init();
 extern bool  opengl_swap();
+extern bool  opengl_make_current( const bool current ); // binds/unbinds the context to the calling thread
 extern void *opengl_proc( const char *name );
 extern bool  opengl_load();
 extern void  opengl_update();
@@ -736,8 +765,11 @@ extern "C"
 	GL_EXTERN void           GL_API glGenTextures(GLsizei, GLuint *);
 	GL_EXTERN GLenum         GL_API glGetError();
 	GL_EXTERN GLubyte const *GL_API glGetString(GLenum);
+	GL_EXTERN void           GL_API glGetIntegerv(GLenum, GLint *);
 	GL_EXTERN void           GL_API glTexImage2D(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const void *);
 	GL_EXTERN void           GL_API glTexParameteri(GLenum, GLenum, GLint);
+	GL_EXTERN void           GL_API glPixelStorei(GLenum, GLint);
+	GL_EXTERN void           GL_API glReadPixels(GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, void *);
 	GL_EXTERN void           GL_API glViewport(GLint, GLint, GLsizei, GLsizei);
 	GL_EXTERN void           GL_API glDepthFunc(GLenum);
 	GL_EXTERN void           GL_API glColorMask(GLboolean, GLboolean, GLboolean, GLboolean);
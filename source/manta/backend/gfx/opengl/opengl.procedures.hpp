@@ -43,7 +43,28 @@ META(void,      glDrawBuffers,              GLsizei, const GLenum *)
 META(void,      glBlendFuncSeparate,        GLenum, GLenum, GLenum, GLenum )
 META(void,      glBlendEquation,            GLenum)
 META(void,      glBlendEquationSeparate,    GLenum, GLenum )
+META(void,      glGetProgramiv,             GLuint, GLenum, GLint *)
+META(const GLubyte *, glGetStringi,         GLenum, GLuint)
+META(GLsync,    glFenceSync,                GLenum, GLbitfield)
+META(GLenum,    glClientWaitSync,           GLsync, GLbitfield, GLuint64)
+META(void,      glDeleteSync,               GLsync)
+META(void,      glCompressedTexImage2D,     GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, const void *)
+
+// Optional procedures (nullptr when unsupported by the driver)
+#ifndef META_OPTIONAL
+	#define META_OPTIONAL META
+#endif
+
+META_OPTIONAL(void, glGetProgramBinary,     GLuint, GLsizei, GLsizei *, GLenum *, void *)
+META_OPTIONAL(void, glProgramBinary,        GLuint, GLenum, const void *, GLsizei)
+META_OPTIONAL(void, glProgramParameteri,    GLuint, GLenum, GLint)
+#if !GL_MAC
+META_OPTIONAL(void, glMaxShaderCompilerThreadsKHR, GLuint)
+META_OPTIONAL(void, glDebugMessageCallback, GLDEBUGPROC, const void *)
+META_OPTIONAL(void, glDebugMessageControl,  GLenum, GLenum, GLenum, GLsizei, const GLuint *, GLboolean)
+#endif
 
 #if COMPILE_DEBUG
 	META ( void, glGetShaderInfoLog, GLuint, GLsizei, GLsizei *, GLchar * )
+	META ( void, glGetProgramInfoLog, GLuint, GLsizei, GLsizei *, GLchar * )
 #endif
\ No newline at end of file
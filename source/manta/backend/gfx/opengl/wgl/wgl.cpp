@@ -30,6 +30,9 @@
 // Win32 Device Context
 static HDC device;
 
+// The OpenGL context
+static HGLRC context;
+
 // The pixel format descriptor.
 static const PIXELFORMATDESCRIPTOR pfd
 {
@@ -60,7 +63,7 @@ static const int attributes[]
     WGL_CONTEXT_PROFILE_MASK_ARB, WGL_CONTEXT_CORE_PROFILE_BIT_ARB,
 
     // Enable Debug
-#if ENGINE_DEBUG
+#if GFX_VALIDATION != GFX_VALIDATION_NONE
     WGL_CONTEXT_FLAGS_ARB, WGL_CONTEXT_DEBUG_BIT_ARB,
 #endif
 
@@ -72,7 +75,6 @@ static const int attributes[]
 bool opengl_init()
 {
 	int   format;
-	HGLRC context;
 
 	// Get Device Context
 	device = GetDC( iWindow::handle );
@@ -133,6 +135,11 @@ bool opengl_swap()
 	return SwapBuffers( device );
 }
 
+bool opengl_make_current( const bool current )
+{
+	return current ? wglMakeCurrent( device, context ) : wglMakeCurrent( nullptr, nullptr );
+}
+
 void *opengl_proc( const char *name )
 {
 	return reinterpret_cast<void *>( wglGetProcAddress( name ) );
@@ -1 +1,25 @@
-#include <manta/network.hpp>
\ No newline at end of file
+#include <manta/network.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool bNetwork::socket_open( NetSocket &socket, const u16 port )
+{
+	return false;
+}
+
+
+void bNetwork::socket_close( NetSocket &socket )
+{
+}
+
+
+bool bNetwork::socket_send( NetSocket &socket, const NetAddress &address, const void *data, const usize size )
+{
+	return false;
+}
+
+
+usize bNetwork::socket_receive( NetSocket &socket, NetAddress &address, void *data, const usize capacity )
+{
+	return 0;
+}
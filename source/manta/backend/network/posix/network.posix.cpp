@@ -1 +1,74 @@
-#include <manta/network.hpp>
\ No newline at end of file
+#include <manta/network.hpp>
+
+#include <vendor/sockets.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool bNetwork::socket_open( NetSocket &socket, const u16 port )
+{
+	const int handle = ::socket( AF_INET, SOCK_DGRAM, IPPROTO_UDP );
+	ErrorReturnIf( handle < 0, false, "Network: failed to create socket (errno %d)", errno );
+
+	// Bind
+	sockaddr_in address { };
+	address.sin_family = AF_INET;
+	address.sin_port = htons( port );
+	address.sin_addr.s_addr = htonl( NET_HOST_ANY );
+	if( bind( handle, reinterpret_cast<sockaddr *>( &address ), sizeof( address ) ) < 0 )
+	{
+		const int error = errno;
+		::close( handle );
+		ErrorReturnMsg( false, "Network: failed to bind socket to port %u (errno %d)", port, error );
+	}
+
+	// Non-blocking
+	if( fcntl( handle, F_SETFL, fcntl( handle, F_GETFL, 0 ) | O_NONBLOCK ) < 0 )
+	{
+		const int error = errno;
+		::close( handle );
+		ErrorReturnMsg( false, "Network: failed to set socket non-blocking (errno %d)", error );
+	}
+
+	// Resolve ephemeral port
+	socklen_t length = sizeof( address );
+	getsockname( handle, reinterpret_cast<sockaddr *>( &address ), &length );
+
+	socket.handle = handle;
+	socket.port = ntohs( address.sin_port );
+
+	// Success
+	return true;
+}
+
+
+void bNetwork::socket_close( NetSocket &socket )
+{
+	::close( static_cast<int>( socket.handle ) );
+}
+
+
+bool bNetwork::socket_send( NetSocket &socket, const NetAddress &address, const void *data, const usize size )
+{
+	sockaddr_in destination { };
+	destination.sin_family = AF_INET;
+	destination.sin_port = htons( address.port );
+	destination.sin_addr.s_addr = htonl( address.host );
+
+	const long sent = sendto( static_cast<int>( socket.handle ), data, size, 0,
+		reinterpret_cast<sockaddr *>( &destination ), sizeof( destination ) );
+	return sent == static_cast<long>( size );
+}
+
+
+usize bNetwork::socket_receive( NetSocket &socket, NetAddress &address, void *data, const usize capacity )
+{
+	sockaddr_in source { };
+	socklen_t length = sizeof( source );
+
+	const long received = recvfrom( static_cast<int>( socket.handle ), data, capacity, 0,
+		reinterpret_cast<sockaddr *>( &source ), &length );
+	if( received <= 0 ) { return 0; } // EAGAIN/EWOULDBLOCK: nothing pending
+
+	address = NetAddress { ntohl( source.sin_addr.s_addr ), ntohs( source.sin_port ) };
+	return static_cast<usize>( received );
+}
@@ -1 +1,87 @@
-#include <manta/network.hpp>
\ No newline at end of file
+#include <manta/network.hpp>
+
+#include <vendor/winsock.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static bool winsockStarted = false;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool bNetwork::socket_open( NetSocket &socket, const u16 port )
+{
+	// Winsock is started on first use
+	if( !winsockStarted )
+	{
+		WSADATA data;
+		ErrorReturnIf( WSAStartup( MAKEWORD( 2, 2 ), &data ) != 0, false, "Network: failed to start Winsock" );
+		winsockStarted = true;
+	}
+
+	const SOCKET handle = ::socket( AF_INET, SOCK_DGRAM, IPPROTO_UDP );
+	ErrorReturnIf( handle == INVALID_SOCKET, false, "Network: failed to create socket (%d)", WSAGetLastError() );
+
+	// Bind
+	sockaddr_in address { };
+	address.sin_family = AF_INET;
+	address.sin_port = htons( port );
+	address.sin_addr.s_addr = htonl( NET_HOST_ANY );
+	if( bind( handle, reinterpret_cast<sockaddr *>( &address ), sizeof( address ) ) == SOCKET_ERROR )
+	{
+		const int error = WSAGetLastError();
+		closesocket( handle );
+		ErrorReturnMsg( false, "Network: failed to bind socket to port %u (%d)", port, error );
+	}
+
+	// Non-blocking
+	u_long nonBlocking = 1;
+	if( ioctlsocket( handle, FIONBIO, &nonBlocking ) == SOCKET_ERROR )
+	{
+		const int error = WSAGetLastError();
+		closesocket( handle );
+		ErrorReturnMsg( false, "Network: failed to set socket non-blocking (%d)", error );
+	}
+
+	// Resolve ephemeral port
+	int length = sizeof( address );
+	getsockname( handle, reinterpret_cast<sockaddr *>( &address ), &length );
+
+	socket.handle = static_cast<i64>( handle );
+	socket.port = ntohs( address.sin_port );
+
+	// Success
+	return true;
+}
+
+
+void bNetwork::socket_close( NetSocket &socket )
+{
+	closesocket( static_cast<SOCKET>( socket.handle ) );
+}
+
+
+bool bNetwork::socket_send( NetSocket &socket, const NetAddress &address, const void *data, const usize size )
+{
+	sockaddr_in destination { };
+	destination.sin_family = AF_INET;
+	destination.sin_port = htons( address.port );
+	destination.sin_addr.s_addr = htonl( address.host );
+
+	const int sent = sendto( static_cast<SOCKET>( socket.handle ), reinterpret_cast<const char *>( data ),
+		static_cast<int>( size ), 0, reinterpret_cast<sockaddr *>( &destination ), sizeof( destination ) );
+	return sent == static_cast<int>( size );
+}
+
+
+usize bNetwork::socket_receive( NetSocket &socket, NetAddress &address, void *data, const usize capacity )
+{
+	sockaddr_in source { };
+	int length = sizeof( source );
+
+	const int received = recvfrom( static_cast<SOCKET>( socket.handle ), reinterpret_cast<char *>( data ),
+		static_cast<int>( capacity ), 0, reinterpret_cast<sockaddr *>( &source ), &length );
+	if( received <= 0 ) { return 0; } // WSAEWOULDBLOCK: nothing pending
+
+	address = NetAddress { ntohl( source.sin_addr.s_addr ), ntohs( source.sin_port ) };
+	return static_cast<usize>( received );
+}
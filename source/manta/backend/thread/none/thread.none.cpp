@@ -7,17 +7,40 @@ void Thread::sleep( u32 milliseconds )
 }
 
 
+void Thread::yield()
+{
+}
+
+
 ThreadID Thread::id()
 {
 	return ThreadID { };
 }
 
 
-void *Thread::create( ThreadFunction function )
+void *Thread::create( ThreadFunction function, void *argument )
 {
 	return nullptr;
 }
 
+
+bool Thread::join( void *handle )
+{
+	return false;
+}
+
+
+bool Thread::pin( void *handle, const u32 core )
+{
+	return false;
+}
+
+
+u32 Thread::core_count()
+{
+	return 1;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void Mutex::init()
@@ -58,4 +81,9 @@ void Condition::sleep( Mutex &mutex )
 
 void Condition::wake()
 {
+}
+
+
+void Condition::wake_all()
+{
 }
\ No newline at end of file
@@ -13,21 +13,54 @@ void Thread::sleep( u32 milliseconds )
 }
 
 
+void Thread::yield()
+{
+	sched_yield();
+}
+
+
 ThreadID Thread::id()
 {
 	return ThreadID( pthread_self() );
 }
 
 
-void *Thread::create( ThreadFunction function )
+void *Thread::create( ThreadFunction function, void *argument )
 {
 	// Create the thread
 	void *handle;
-	int result = pthread_create( reinterpret_cast<pthread_t *>( &handle ), nullptr, function, nullptr );
+	int result = pthread_create( reinterpret_cast<pthread_t *>( &handle ), nullptr, function, argument );
 	ErrorIf( result != 0, "POSIX: Failed to create thread!" );
 	return handle;
 }
 
+
+bool Thread::join( void *handle )
+{
+	return pthread_join( reinterpret_cast<pthread_t>( handle ), nullptr ) == 0;
+}
+
+
+bool Thread::pin( void *handle, const u32 core )
+{
+#if OS_LINUX
+	cpu_set_t set;
+	CPU_ZERO( &set );
+	CPU_SET( core % CPU_SETSIZE, &set );
+	return pthread_setaffinity_np( reinterpret_cast<pthread_t>( handle ), sizeof( cpu_set_t ), &set ) == 0;
+#else
+	// Thread affinity is only a hint on other POSIX platforms (i.e. macOS has no pthread_setaffinity_np)
+	return false;
+#endif
+}
+
+
+u32 Thread::core_count()
+{
+	const long count = sysconf( _SC_NPROCESSORS_ONLN );
+	return count < 1 ? 1 : static_cast<u32>( count );
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -77,4 +110,10 @@ void Condition::sleep( Mutex &mutex )
 void Condition::wake()
 {
 	pthread_cond_signal( &condition );
+}
+
+
+void Condition::wake_all()
+{
+	pthread_cond_broadcast( &condition );
 }
\ No newline at end of file
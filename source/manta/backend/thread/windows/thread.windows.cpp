@@ -12,20 +12,47 @@ void Thread::sleep( u32 milliseconds )
 }
 
 
+void Thread::yield()
+{
+	SwitchToThread();
+}
+
+
 ThreadID Thread::id()
 {
 	return ThreadID( GetCurrentThreadId() );
 }
 
 
-void *Thread::create( ThreadFunction function )
+void *Thread::create( ThreadFunction function, void *argument )
 {
 	// Create the thread
-	void *handle = CreateThread( nullptr, 0, reinterpret_cast<LPTHREAD_START_ROUTINE>( function ), nullptr, 0, nullptr );
+	void *handle = CreateThread( nullptr, 0, reinterpret_cast<LPTHREAD_START_ROUTINE>( function ), argument, 0, nullptr );
 	ErrorIf( handle == nullptr, "WIN: Failed to create thread!" );
 	return handle;
 }
 
+
+bool Thread::join( void *handle )
+{
+	if( WaitForSingleObject( reinterpret_cast<HANDLE>( handle ), INFINITE ) != 0 ) { return false; }
+	return CloseHandle( reinterpret_cast<HANDLE>( handle ) );
+}
+
+
+bool Thread::pin( void *handle, const u32 core )
+{
+	const UINT_PTR mask = static_cast<UINT_PTR>( 1 ) << ( core % ( sizeof( UINT_PTR ) * 8 ) );
+	return SetThreadAffinityMask( reinterpret_cast<HANDLE>( handle ), mask ) != 0;
+}
+
+
+u32 Thread::core_count()
+{
+	const DWORD count = GetActiveProcessorCount( 0xFFFF ); // ALL_PROCESSOR_GROUPS
+	return count < 1 ? 1 : static_cast<u32>( count );
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -75,4 +102,10 @@ void Condition::sleep( Mutex &mutex )
 void Condition::wake()
 {
 	WakeConditionVariable( &condition );
+}
+
+
+void Condition::wake_all()
+{
+	WakeAllConditionVariable( &condition );
 }
\ No newline at end of file
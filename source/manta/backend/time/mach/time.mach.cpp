@@ -39,3 +39,9 @@ u64 Time::seed()
 {
 	return static_cast<u64>( mach_absolute_time() );
 }
+
+
+void Time::sleep_until( const double time )
+{
+	mach_wait_until( offset + static_cast<u64>( time * frequency ) );
+}
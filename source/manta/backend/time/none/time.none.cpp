@@ -24,3 +24,8 @@ u64 Time::seed()
 {
 	return 0;
 }
+
+
+void Time::sleep_until( const double time )
+{
+}
@@ -1,10 +1,11 @@
 #include <manta/time.hpp>
 
 #include <time.h>
+#include <errno.h>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-thread_local static timespec offset;
+static timespec offset;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -37,3 +38,15 @@ u64 Time::seed()
 {
 	return static_cast<u64>( offset.tv_nsec );
 }
+
+
+void Time::sleep_until( const double time )
+{
+	// Absolute deadline on the monotonic clock (no drift from the time spent computing a relative duration)
+	const i64 nanoseconds = static_cast<i64>( offset.tv_nsec ) + static_cast<i64>( time * 1e+9 );
+	timespec deadline;
+	deadline.tv_sec = offset.tv_sec + nanoseconds / 1000000000;
+	deadline.tv_nsec = nanoseconds % 1000000000;
+
+	while( clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr ) == EINTR ) { }
+}
@@ -6,8 +6,8 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-thread_local static LARGE_INTEGER offset;
-thread_local static double frequency;
+static LARGE_INTEGER offset;
+static double frequency;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -50,4 +50,12 @@ u64 Time::seed()
 	LARGE_INTEGER current;
 	QueryPerformanceCounter( &current );
 	return static_cast<u64>( current.LowPart );
-}
\ No newline at end of file
+}
+
+
+void Time::sleep_until( const double time )
+{
+	// Sleep() has 1ms granularity (timeBeginPeriod) -- the frame pacer spin-waits the remainder
+	const double remaining = time - Time::value();
+	if( remaining >= 0.001 ) { Sleep( static_cast<DWORD>( remaining * 1000.0 ) ); }
+}
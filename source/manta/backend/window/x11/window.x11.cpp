@@ -36,6 +36,12 @@ namespace iWindow
 		Window::height = defaultHeight;
 		Window::resized = true;
 
+		#if RENDER_THREAD
+			// The render thread presents (glXSwapBuffers) while this thread polls events
+			if( !XInitThreads() )
+				{ ErrorReturnMsg( false, "X11: Failed to initialize Xlib threading" ); }
+		#endif
+
 		// Open Display
 		if( ( iWindow::display = XOpenDisplay( nullptr ) ) == nullptr )
 			{ ErrorReturnMsg( false, "X11: Failed to open X11 display" ); }
@@ -101,7 +101,7 @@ cleanup:
 }
 
 
-void Buffer::write( void *data, const usize size )
+void Buffer::write( const void *data, const usize size )
 {
 	while( !fixed )
 	{
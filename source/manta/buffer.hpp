@@ -22,7 +22,7 @@ public:
 	bool save( const char *path );
 	bool load( const char *path, const bool grow );
 
-	void write( void *data, const usize size );
+	void write( const void *data, const usize size );
 
 	template <typename T>
 	void write( const T element )
@@ -521,8 +521,9 @@ void draw_text( const u16 font, const u16 size, const float x, const float y, Co
 	Assert( font < Assets::fontsCount );
 	Assert( size > 0 );
 
-	int offsetX = 0;
-	int offsetY = 0;
+	float offsetX = 0.0f;
+	float offsetY = 0.0f;
+	bool sdf = false;
 
 	u32 state = UTF8_ACCEPT;
 	u32 codepoint;
@@ -535,40 +536,40 @@ void draw_text( const u16 font, const u16 size, const float x, const float y, Co
 		// Newline char
 		if( UNLIKELY( codepoint == '\n' ) )
 		{
-			offsetX = 0;
+			offsetX = 0.0f;
 			offsetY += size;
 			continue;
 		}
 
-		// Retrieve FontGlyphInfo
-		FontGlyphInfo &glyphInfo = iFonts::get( { font, size, codepoint } );
+		// Retrieve FontQuad
+		FontQuad glyph;
+		iFonts::quad( font, size, codepoint, glyph );
 
 		// Draw Quad
-		if( glyphInfo.width != 0 && glyphInfo.height != 0 )
+		if( glyph.texture != nullptr )
 		{
-			const float glyphX1 = x + offsetX + glyphInfo.xshift;
-			const float glyphY1 = y + offsetY + glyphInfo.yshift;
-			const float glyphX2 = x + offsetX + glyphInfo.xshift + glyphInfo.width;
-			const float glyphY2 = y + offsetY + glyphInfo.yshift + glyphInfo.height;
-
-			constexpr u16 uvScale = ( 1 << 16 ) / FONTS_TEXTURE_SIZE;
-			const u16 u1 = ( glyphInfo.u ) * uvScale;
-			const u16 v1 = ( glyphInfo.v ) * uvScale;
-			const u16 u2 = ( glyphInfo.u + glyphInfo.width ) * uvScale;
-			const u16 v2 = ( glyphInfo.v + glyphInfo.height ) * uvScale;
+			// Switch between runtime atlas & SDF glyphs
+			if( UNLIKELY( glyph.sdf != sdf ) )
+			{
+				sdf = glyph.sdf;
+				if( sdf ) { iFonts::sdf_begin(); } else { iFonts::sdf_end(); }
+			}
 
 			// TODO: Implement this properly...
-			if( Gfx::quad_batch_can_break() || UNLIKELY( Gfx::state().textureResource[0] != iFonts::texture2D.resource ) )
+			if( !sdf && ( Gfx::quad_batch_can_break() || UNLIKELY( !Gfx::texture_bound( iFonts::texture2D ) ) ) )
 			{
 				iFonts::update();
 			}
 
-			Gfx::quad_batch_write( glyphX1, glyphY1, glyphX2, glyphY2, u1, v1, u2, v2, color, &iFonts::texture2D, 0.0f );
+			Gfx::quad_batch_write( x + offsetX + glyph.x1, y + offsetY + glyph.y1, x + offsetX + glyph.x2, y + offsetY + glyph.y2,
+			                       glyph.u1, glyph.v1, glyph.u2, glyph.v2, color, glyph.texture, 0.0f );
 		}
 
 		// Advance Character
-		offsetX += glyphInfo.advance;
+		offsetX += glyph.advance;
 	}
+
+	if( sdf ) { iFonts::sdf_end(); }
 #endif
 }
 
@@ -592,9 +593,10 @@ i32v2 text_dimensions( const u16 font, const u16 size, const char *string )
 	Assert( font < Assets::fontsCount );
 	Assert( size > 0 );
 
-	int offsetX = 0;
-	int offsetY = 0;
-	i32v2 result = 0;
+	float offsetX = 0.0f;
+	float offsetY = 0.0f;
+	float width = 0.0f;
+	float height = 0.0f;
 
 	u32 state = UTF8_ACCEPT;
 	u32 codepoint;
@@ -607,20 +609,21 @@ i32v2 text_dimensions( const u16 font, const u16 size, const char *string )
 		// Newline char
 		if( UNLIKELY( codepoint == '\n' ) )
 		{
-			offsetX = 0;
-			result.y = max( result.y, offsetY + size );
+			offsetX = 0.0f;
+			height = max( height, offsetY + size );
 			offsetY += size;
 			continue;
 		}
 
-		// Retrieve FontGlyphInfo & advance
-		FontGlyphInfo &glyphInfo = iFonts::get( { font, size, codepoint } );
-		result.x = max( result.x, offsetX + static_cast<int>( glyphInfo.advance ) );
-		result.y = max( result.y, offsetY + glyphInfo.height );
-		offsetX += glyphInfo.advance;
+		// Retrieve FontQuad & advance
+		FontQuad glyph;
+		iFonts::quad( font, size, codepoint, glyph );
+		width = max( width, offsetX + glyph.advance );
+		height = max( height, offsetY + glyph.height );
+		offsetX += glyph.advance;
 	}
 
-	return result;
+	return i32v2 { static_cast<i32>( ceilf( width ) ), static_cast<i32>( ceilf( height ) ) };
 }
 
 
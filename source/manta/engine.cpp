@@ -1,11 +1,14 @@
 #include <manta/engine.hpp>
 
 #include <manta/assets.hpp>
+#include <manta/audio.hpp>
 #include <manta/time.hpp>
+#include <manta/jobs.hpp>
 #include <manta/window.hpp>
 #include <manta/gfx.hpp>
 #include <manta/objects.hpp>
 #include <manta/fonts.hpp>
+#include <manta/profiler.hpp>
 
 #include <manta/input.hpp>
 #include <manta/fileio.hpp>
@@ -28,6 +31,12 @@ namespace Engine
 		// Time
 		ErrorReturnIf( !iTime::init(), false, "Engine: failed to initialize timer" );
 
+		// Jobs
+		ErrorReturnIf( !iJobs::init(), false, "Engine: failed to initialize job system" );
+
+		// Audio
+		ErrorReturnIf( !iAudio::init(), false, "Engine: failed to initialize audio" );
+
 		// Window
 		ErrorReturnIf( !iWindow::init(), false, "Engine: failed to initialize window" );
 
@@ -58,6 +67,12 @@ namespace Engine
 		// Window
 		ErrorReturnIf( !iWindow::free(), false, "Engine: failed to free window" );
 
+		// Audio
+		ErrorReturnIf( !iAudio::free(), false, "Engine: failed to free audio" );
+
+		// Jobs
+		ErrorReturnIf( !iJobs::free(), false, "Engine: failed to free job system" );
+
 		// Time
 		ErrorReturnIf( !iTime::free(), false, "Engine: failed to free timer" );
 
@@ -70,6 +85,8 @@ namespace Engine
 
 	static void update( const Delta delta )
 	{
+		PROFILE_ZONE( "Engine::update" );
+
 		// Input
 		Input::update( delta );
 
@@ -80,6 +97,83 @@ namespace Engine
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace Engine
+{
+	static void simulate( const ProjectCallbacks &project, const Delta delta, const u32 steps )
+	{
+		PROFILE_ZONE( "Engine::simulate" );
+
+		// FIXED_TIMESTEP: Frame::steps steps of Frame::deltaStep (otherwise 1 step of Frame::delta)
+		for( u32 i = 0; i < steps; i++ ) { project.simulate( delta ); }
+	}
+}
+
+
+#if FRAME_PIPELINING
+namespace Engine
+{
+	// Frame N is recorded once its simulation has finished (the snapshot boundary), then the simulation of
+	// frame N+1 runs on a worker while frame N's command stream is replayed
+	static JobCounter simulation;
+	static Delta simulationDelta = 0.0;
+	static u32 simulationSteps = 0;
+
+	static void simulate_job( void *data, const u32 begin, const u32 end )
+	{
+		simulate( *reinterpret_cast<const ProjectCallbacks *>( data ), simulationDelta, simulationSteps );
+	}
+}
+#endif
+
+
+namespace Engine
+{
+	static void render( const ProjectCallbacks &project, const Delta delta )
+	{
+		PROFILE_ZONE( "Engine::render" );
+		project.render( delta );
+	}
+
+
+	static void frame( const ProjectCallbacks &project )
+	{
+		PROFILE_ZONE( "Engine::frame" );
+
+		// Gfx calls are recorded when pipelining or when the render thread owns the graphics context
+		const bool pipelined = FRAME_PIPELINING && project.pipelined();
+		const bool recorded = RENDER_THREAD || pipelined;
+		if( recorded ) { fGfx::record_begin(); }
+
+		// Update Engine & Project
+		Engine::update( Frame::delta );
+		project.update( Frame::delta );
+
+		#if FRAME_PIPELINING
+			if( pipelined )
+			{
+				// Record this frame, then simulate the next frame on a worker
+				render( project, Frame::delta );
+				fGfx::record_end();
+
+				simulationDelta = Frame::deltaStep;
+				simulationSteps = Frame::steps;
+				Jobs::submit( simulate_job, const_cast<ProjectCallbacks *>( &project ), &simulation );
+			}
+			else
+		#endif
+		{
+			simulate( project, Frame::deltaStep, Frame::steps );
+			render( project, Frame::delta );
+			if( recorded ) { fGfx::record_end(); }
+		}
+
+		// Replay (the render thread replays published streams on its own)
+		if( recorded && !RENDER_THREAD ) { fGfx::replay(); }
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 namespace Engine
 {
 	static bool painted = false; // Delay showing the window until after a frame is rendered
@@ -100,22 +194,35 @@ namespace Engine
 			// Init Engine & Project
 			ErrorIf( !Engine::init( argc, argv ), "Failed to initialize the engine" );
 			ErrorIf( !project.init( argc, argv ), "Failed to initialize the project" );
+			ErrorIf( !fGfx::render_thread_init(), "Failed to start the render thread" );
 
 			// Main Loop
 			while( !exiting )
 			{
+				#if FRAME_PIPELINING
+					// Snapshot Boundary
+					Jobs::wait( simulation );
+				#endif
+
 				Frame::start();
 				{
-					// Update Engine & Project
-					Engine::update( Frame::delta );
-					project.update( Frame::delta );
+					// Engine & Project
+					Engine::frame( project );
 
 					// Show the window after at least 1 frame has been rendered
 					if( !painted ) { iWindow::show(); painted = true; }
 				}
+				#if PROFILING
+					Profiler::collect();
+				#endif
 				Frame::end();
 			}
 
+			#if FRAME_PIPELINING
+				Jobs::wait( simulation );
+			#endif
+			ErrorIf( !fGfx::render_thread_free(), "Failed to stop the render thread" );
+
 			// Free Project & Engine (if restarting--otherwise no need to cleanup)
 			#if 0
 				ErrorIf( !project.free(), "Failed to free the project" );
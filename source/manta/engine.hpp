@@ -10,9 +10,13 @@ class ProjectCallbacks
 public:
 	ProjectCallbacks( bool ( *init )( int, char ** ),
 	                  bool ( *free )(),
-	                  void ( *update )( const Delta ) ) : callback_init( init ),
-	                                                      callback_free( free ),
-	                                                      callback_update( update ) { }
+	                  void ( *update )( const Delta ),
+	                  void ( *simulate )( const Delta ) = nullptr,
+	                  void ( *render )( const Delta ) = nullptr ) : callback_init( init ),
+	                                                                 callback_free( free ),
+	                                                                 callback_update( update ),
+	                                                                 callback_simulate( simulate ),
+	                                                                 callback_render( render ) { }
 
 	inline bool init( int argc, char **argv ) const
 	{
@@ -30,10 +34,30 @@ public:
 		callback_update( delta );
 	}
 
+	inline void simulate( const Delta delta ) const
+	{
+		if( callback_simulate == nullptr ) { return; }
+		callback_simulate( delta );
+	}
+
+	inline void render( const Delta delta ) const
+	{
+		if( callback_render == nullptr ) { return; }
+		callback_render( delta );
+	}
+
+	// FRAME_PIPELINING requires the simulation & rendering to be split
+	inline bool pipelined() const
+	{
+		return callback_simulate != nullptr && callback_render != nullptr;
+	}
+
 private:
-	bool ( *callback_init )( int, char ** );  // bool init( int argc, char **argv );
-	bool ( *callback_free )();                // bool free();
-	void ( *callback_update )( const Delta ); // void update( Delta delta );
+	bool ( *callback_init )( int, char ** );    // bool init( int argc, char **argv );
+	bool ( *callback_free )();                  // bool free();
+	void ( *callback_update )( const Delta );   // void update( Delta delta );   -- main thread (input, window)
+	void ( *callback_simulate )( const Delta ); // void simulate( Delta delta ); -- may run on a job worker
+	void ( *callback_render )( const Delta );   // void render( Delta delta );   -- may be recorded & replayed
 };
 
 
@@ -7,6 +7,7 @@
 #include <manta/fileio.hpp>
 #include <manta/gfx.hpp>
 #include <manta/color.hpp>
+#include <manta/profiler.hpp>
 
 #include <vendor/vendor.hpp>
 
@@ -64,6 +65,7 @@ namespace iFonts
 	u16 insertX = FONTS_GLYPH_PADDING;
 	u16 insertY = FONTS_GLYPH_PADDING;
 	u16 lineHeight = 0;
+	u32 generation = 0;
 
 	FontGlyphEntry *data = nullptr;
 
@@ -252,6 +254,7 @@ void iFonts::flush()
 	insertX = FONTS_GLYPH_PADDING;
 	insertY = FONTS_GLYPH_PADDING;
 	lineHeight = 0;
+	generation++;
 }
 
 
@@ -259,6 +262,7 @@ void iFonts::update()
 {
 	// Dirty?
 	if( dirtyGlyphs.size() == 0 ) { return; }
+	PROFILE_ZONE( "iFonts::update" );
 
 	// Rasterize glyph bitmaps & copy to Texture2DBuffer
 	for( FontGlyphEntry &entry : dirtyGlyphs )
@@ -295,6 +299,96 @@ void iFonts::update()
 }
 
 
+void iFonts::quad( const u16 font, const u16 size, const u32 codepoint, FontQuad &quad )
+{
+	// Signed Distance Field
+	const DiskFontGlyph *sdfGlyph = sdf_glyph( font, codepoint );
+	if( sdfGlyph != nullptr )
+	{
+		const DiskFont &diskFont = Assets::fonts[font];
+		const float scale = static_cast<float>( size ) / diskFont.sdfSize;
+		quad.x1 = sdfGlyph->xshift * scale;
+		quad.y1 = sdfGlyph->yshift * scale;
+		quad.x2 = quad.x1 + sdfGlyph->width * scale;
+		quad.y2 = quad.y1 + sdfGlyph->height * scale;
+		quad.advance = sdfGlyph->advance * scale;
+		quad.height = sdfGlyph->height > diskFont.sdfSpread * 2 ? ( sdfGlyph->height - diskFont.sdfSpread * 2 ) * scale : 0.0f;
+		quad.sdf = true;
+
+		if( sdfGlyph->glyph == U32_MAX ) { quad.texture = nullptr; return; }
+		const DiskGlyph &diskGlyph = Assets::glyphs[sdfGlyph->glyph];
+		quad.u1 = diskGlyph.u1;
+		quad.v1 = diskGlyph.v1;
+		quad.u2 = diskGlyph.u2;
+		quad.v2 = diskGlyph.v2;
+		quad.texture = &bGfx::textures[diskFont.sdfTexture];
+		return;
+	}
+
+	// Runtime Atlas
+	const FontGlyphInfo &glyphInfo = get( { font, size, codepoint } );
+	quad.x1 = glyphInfo.xshift;
+	quad.y1 = glyphInfo.yshift;
+	quad.x2 = quad.x1 + glyphInfo.width;
+	quad.y2 = quad.y1 + glyphInfo.height;
+	quad.advance = glyphInfo.advance;
+	quad.height = glyphInfo.height;
+	quad.sdf = false;
+
+	if( glyphInfo.width == 0 || glyphInfo.height == 0 ) { quad.texture = nullptr; return; }
+	constexpr u16 uvScale = ( 1 << 16 ) / FONTS_TEXTURE_SIZE;
+	quad.u1 = ( glyphInfo.u ) * uvScale;
+	quad.v1 = ( glyphInfo.v ) * uvScale;
+	quad.u2 = ( glyphInfo.u + glyphInfo.width ) * uvScale;
+	quad.v2 = ( glyphInfo.v + glyphInfo.height ) * uvScale;
+	quad.texture = &texture2D;
+}
+
+
+const DiskFontGlyph *iFonts::sdf_glyph( const u16 font, const u32 codepoint )
+{
+	const DiskFont &diskFont = Assets::fonts[font];
+	if( diskFont.sdfSize == 0 ) { return nullptr; }
+
+	// Glyphs are baked per range in order (see Fonts::bake_sdf)
+	u32 index = diskFont.sdfGlyphFirst;
+	for( u32 i = 0; i < diskFont.fontRangeCount; i++ )
+	{
+		const DiskFontRange &range = Assets::fontRanges[diskFont.fontRangeFirst + i];
+		if( codepoint >= range.start && codepoint <= range.end ) { return &Assets::fontGlyphs[index + codepoint - range.start]; }
+		index += range.end - range.start + 1;
+	}
+
+	return nullptr;
+}
+
+
+static u32 sdfShaderPrevious = SHADER_DEFAULT;
+static GfxFilteringMode sdfFilteringPrevious = GfxFilteringMode_NEAREST;
+
+
+void iFonts::sdf_begin()
+{
+	// Previous shader (bound by resource)
+	sdfShaderPrevious = SHADER_DEFAULT;
+	for( u32 i = 0; i < Gfx::shadersCount; i++ )
+	{
+		if( bGfx::shaders[i].resource == Gfx::state().shader.resource ) { sdfShaderPrevious = i; break; }
+	}
+	sdfFilteringPrevious = Gfx::state().sampler.filterMode;
+
+	Gfx::shader_bind( SHADER_TEXT_SDF );
+	Gfx::set_filtering_mode( GfxFilteringMode_LINEAR );
+}
+
+
+void iFonts::sdf_end()
+{
+	Gfx::set_filtering_mode( sdfFilteringPrevious );
+	Gfx::shader_bind( sdfShaderPrevious );
+}
+
+
 void iFonts::cache( const u16 font, const u16 size, const u32 start, const u32 end )
 {
 	for( u32 codepoint = start; codepoint <= end; codepoint++ )
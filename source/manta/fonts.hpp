@@ -94,6 +94,17 @@ struct FontInfo
 	stbtt_fontinfo info;
 };
 
+
+struct FontQuad
+{
+	float x1, y1, x2, y2; // relative to the pen position
+	u16 u1, v1, u2, v2;
+	float advance;
+	float height;                // ink height (text_dimensions)
+	const GfxTexture2D *texture; // nullptr: nothing to draw (e.g. whitespace)
+	bool sdf;                    // drawn with SHADER_TEXT_SDF (see iFonts::sdf_begin)
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 namespace iFonts
@@ -112,9 +123,19 @@ namespace iFonts
 	extern void cache( const u16 font, const u16 size, const u32 start, const u32 end );
 	extern void cache( const u16 font, const u16 size, const char *buffer );
 
+	// Resolves a codepoint to a quad: fonts with a baked signed distance field ("sdf" in the .font) scale their
+	// build-time glyphs to any size, other codepoints are rasterized into the runtime atlas at 'size'
+	extern void quad( const u16 font, const u16 size, const u32 codepoint, FontQuad &quad );
+	extern const DiskFontGlyph *sdf_glyph( const u16 font, const u32 codepoint );
+
+	// Binds SHADER_TEXT_SDF & linear filtering for FontQuad::sdf quads (sdf_end() restores the previous state)
+	extern void sdf_begin();
+	extern void sdf_end();
+
 	extern u16 insertX;
 	extern u16 insertY;
 	extern u16 lineHeight;
+	extern u32 generation; // incremented by flush() (invalidates cached glyph UVs)
 
 	extern FontGlyphEntry *data;
 
@@ -6,15 +6,18 @@
 #include <pipeline.generated.hpp>
 
 #include <manta/memory.hpp>
+#include <manta/buffer.hpp>
+#include <manta/thread.hpp>
 #include <manta/window.hpp>
+#include <manta/profiler.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 namespace bGfx
 {
-	GfxState states[2];
-	bool flip = false;
-	bool rendering = false;
+	RENDER_THREAD_LOCAL GfxState states[2];
+	RENDER_THREAD_LOCAL bool flip = false;
+	RENDER_THREAD_LOCAL bool rendering = false;
 
 	GfxTexture2D textures[Assets::texturesCount];
 	GfxShader shaders[Gfx::shadersCount];
@@ -22,10 +25,10 @@ namespace bGfx
 	GfxSwapChain swapchain;
 	GfxViewport viewport;
 
-	Matrix matrixModel;
-	Matrix matrixView;
-	Matrix matrixPerspective;
-	Matrix matrixMVP;
+	RENDER_THREAD_LOCAL Matrix matrixModel;
+	RENDER_THREAD_LOCAL Matrix matrixView;
+	RENDER_THREAD_LOCAL Matrix matrixPerspective;
+	RENDER_THREAD_LOCAL Matrix matrixMVP;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -95,10 +98,16 @@ void debug_overlay_gfx( const float x, const float y )
 	draw_text_f( fnt_consolas, 14, drawX, drawY, c_white, "Triangles: %s", buffer );
 	drawY += 20.0f;
 
+	draw_text_f( fnt_consolas, 14, drawX, drawY, c_white, "Quads: %d (cached: %d, layer rebuilds: %d)",
+	             stats.frame.quadCount, stats.frame.layerQuadsCached, stats.frame.layerRebuilds );
+	drawY += 20.0f;
+
 	draw_text_f( fnt_consolas, 14, drawX, drawY, c_white, "Texture Binds: %d", stats.frame.textureBinds );
 	drawY += 20.0f;
 	draw_text_f( fnt_consolas, 14, drawX, drawY, c_white, "Shader Binds: %d", stats.frame.shaderBinds );
 	drawY += 20.0f;
+	draw_text_f( fnt_consolas, 14, drawX, drawY, c_white, "Render Target Binds: %d", stats.frame.renderTargetBinds );
+	drawY += 20.0f;
 
 	drawY += 20.0f;
 	draw_text_f( fnt_consolas, 14, drawX, drawY, c_yellow, "GPU Memory Total: %.2f mb", MB( stats.total_memory() ) );
@@ -107,6 +116,8 @@ void debug_overlay_gfx( const float x, const float y )
 	drawY += 20.0f;
 	draw_text_f( fnt_consolas, 14, drawX, drawY, c_white, "  Textures: %.2f mb", MB( stats.gpuMemoryTextures ) );
 	drawY += 20.0f;
+	draw_text_f( fnt_consolas, 14, drawX, drawY, c_white, "  Render Targets: %.2f mb", MB( stats.gpuMemoryRenderTargets ) );
+	drawY += 20.0f;
 	draw_text_f( fnt_consolas, 14, drawX, drawY, c_white, "  Vertex Buffers: %.2f mb", MB( stats.gpuMemoryVertexBuffers ) );
 	drawY += 20.0f;
 	draw_text_f( fnt_consolas, 14, drawX, drawY, c_white, "  Index Buffers: %.2f mb", MB( stats.gpuMemoryIndexBuffers ) );
@@ -121,6 +132,9 @@ void debug_overlay_gfx( const float x, const float y )
 
 static inline void draw_call()
 {
+	// Recorded state changes break the batch when they are replayed
+	if( fGfx::recording ) { return; }
+
 	// TODO: Refactor this
 	Gfx::quad_batch_break(); // Break the quad batch
 	// TODO ... break any other batch?
@@ -145,12 +159,21 @@ bool fGfx::init()
 	// Initialize Quad Batch
 	ErrorIf( !fGfx::quad_batch_init(), "%s: Failed to initialize quad batch!", __FUNCTION__ );
 
+	// Initialize Command Recording
+	ErrorIf( !fGfx::record_init(), "%s: Failed to initialize command recording!", __FUNCTION__ );
+
 	// Success
 	return true;
 }
 
 bool fGfx::free()
 {
+	// Free Command Recording
+	ErrorIf( !fGfx::record_free(), "%s: Failed to free command recording!", __FUNCTION__ );
+
+	// Free Render Target Pool
+	ErrorIf( !fGfx::render_target_pool_free(), "%s: Failed to free render target pool!", __FUNCTION__ );
+
 	// Free Quad Batch
 	ErrorIf( !fGfx::quad_batch_free(), "%s: Failed to free quad batch!", __FUNCTION__ );
 
@@ -173,11 +196,16 @@ bool fGfx::free()
 
 bool fGfx::init_textures()
 {
+	// DiskTexture::compression (build/assets/textures.hpp)
+	static const GfxColorFormat formats[] = { GfxColorFormat_R8G8B8A8, GfxColorFormat_BC1, GfxColorFormat_BC3 };
+
 	// Load Textures
 	for( u32 i = 0; i < Assets::texturesCount; i++ )
 	{
 		const DiskTexture &diskTexture = Assets::textures[i];
-		bGfx::textures[i].init( Assets::binary.data + diskTexture.offset, diskTexture.width, diskTexture.height, GfxColorFormat_R8G8B8A8 );
+		Assert( diskTexture.compression < ARRAY_LENGTH( formats ) );
+		bGfx::textures[i].init( Assets::binary.data + diskTexture.offset, diskTexture.width, diskTexture.height,
+			formats[diskTexture.compression], diskTexture.levels );
 	}
 
 	// Success
@@ -248,6 +276,15 @@ void fGfx::state_apply( const bool dirty )
 	GfxState &current = bGfx::states[bGfx::flip];
 	GfxState &previous = bGfx::states[!bGfx::flip];
 
+	// Render Target Binding
+	if( GFX_STATE_CHECK( current.renderTargetResource != previous.renderTargetResource ) )
+	{
+		if( current.renderTargetResource != nullptr )
+			{ bGfx::rb_render_target_2d_bind( current.renderTargetResource, 0 ); }
+		else
+			{ bGfx::rb_render_target_2d_release(); }
+	}
+
 	// Raster State
 	if( dirty || GFX_STATE_CHECK( current.raster != previous.raster ) )
 		{ bGfx::rb_set_raster_state( current.raster ); }
@@ -275,6 +312,168 @@ void fGfx::state_apply( const bool dirty )
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+enum_type( GfxCommand, u8 )
+{
+	GfxCommand_FrameBegin = 0,
+	GfxCommand_FrameEnd,
+	GfxCommand_ClearColor,
+	GfxCommand_ClearDepth,
+	GfxCommand_ShaderGlobals,
+	GfxCommand_RasterState,
+	GfxCommand_SamplerState,
+	GfxCommand_BlendState,
+	GfxCommand_DepthState,
+	GfxCommand_ShaderBind,
+	GfxCommand_TextureBind,
+	GfxCommand_Quads,
+	GfxCommand_QuadBatchBreak,
+	GfxCommand_TextureInit,
+	GfxCommand_TextureFree,
+	GfxCommand_SwapchainSize,
+	GfxCommand_ViewportSize,
+	GFXCOMMAND_COUNT,
+};
+
+
+struct GfxCommandTextureBind
+{
+	const GfxTexture2D *texture;
+	int slot;
+};
+
+
+struct GfxCommandTextureInit
+{
+	GfxTexture2D *texture;
+	usize size; // bytes of pixel data following the command (0: no data)
+	u16 width;
+	u16 height;
+	GfxColorFormat format;
+	u16 levels;
+};
+
+
+#define RENDER_COMMAND_STREAMS ( RENDER_THREAD ? RENDER_THREAD_FRAMES : 1 )
+
+
+namespace fGfx
+{
+	RENDER_THREAD_LOCAL bool recording = false;
+
+	// Ring of command streams: the recording thread publishes at 'head', the replaying thread consumes at 'tail'
+	static Buffer commands[RENDER_COMMAND_STREAMS];
+	static Buffer *commandsRecording = nullptr;
+	static volatile i32 commandsHead = 0;
+	static volatile i32 commandsTail = 0;
+
+	static usize commandsQuadRunTell = USIZE_MAX; // tell of the open GfxCommand_Quads count (USIZE_MAX: none)
+	static u32 commandsQuadRunCount = 0;
+
+#if RENDER_THREAD
+	static void *renderThread = nullptr;
+	static volatile i32 renderThreadRunning = 0;
+	static Mutex renderThreadMutex;
+	static Condition renderThreadCondition; // signaled when a stream is published or consumed
+#endif
+}
+
+
+static inline u32 commands_pending()
+{
+	return static_cast<u32>( atomic_load( &fGfx::commandsHead ) ) - static_cast<u32>( atomic_load( &fGfx::commandsTail ) );
+}
+
+
+static void record_command( const GfxCommand command )
+{
+	fGfx::commandsQuadRunTell = USIZE_MAX;
+	fGfx::commandsRecording->write( command );
+}
+
+
+template <typename T> static void record_command( const GfxCommand command, const T &payload )
+{
+	record_command( command );
+	fGfx::commandsRecording->write( payload );
+}
+
+
+static void record_quad( const GfxBuiltInQuad &quad )
+{
+	// Consecutive quads share one command header: [GfxCommand_Quads][u32 count][quad * count]
+	Buffer &stream = *fGfx::commandsRecording;
+	if( fGfx::commandsQuadRunTell == USIZE_MAX )
+	{
+		stream.write( GfxCommand_Quads );
+		fGfx::commandsQuadRunTell = stream.current;
+		fGfx::commandsQuadRunCount = 0;
+		stream.write( fGfx::commandsQuadRunCount );
+	}
+
+	stream.write( quad );
+	stream.poke( fGfx::commandsQuadRunTell, ++fGfx::commandsQuadRunCount );
+}
+
+
+bool fGfx::record_init()
+{
+	for( Buffer &stream : commands )
+	{
+		stream.init( RENDER_COMMAND_BUFFER_SIZE, true );
+		ErrorReturnIf( stream.data == nullptr, false, "%s: Failed to allocate command buffer", __FUNCTION__ );
+	}
+
+	// Success
+	return true;
+}
+
+
+bool fGfx::record_free()
+{
+	for( Buffer &stream : commands ) { stream.free(); }
+	return true;
+}
+
+
+void fGfx::record_begin()
+{
+	Assert( !recording );
+
+#if RENDER_THREAD
+	// Wait for a free stream (the render thread is RENDER_THREAD_FRAMES frames behind)
+	if( commands_pending() >= RENDER_COMMAND_STREAMS )
+	{
+		renderThreadMutex.lock();
+		while( commands_pending() >= RENDER_COMMAND_STREAMS ) { renderThreadCondition.sleep( renderThreadMutex ); }
+		renderThreadMutex.unlock();
+	}
+#else
+	AssertMsg( commands_pending() == 0, "Recording over a stream that has not been replayed!" );
+#endif
+
+	commandsRecording = &commands[static_cast<u32>( commandsHead ) % RENDER_COMMAND_STREAMS];
+	commandsRecording->clear();
+	commandsQuadRunTell = USIZE_MAX;
+	recording = true;
+}
+
+
+void fGfx::record_end()
+{
+	Assert( recording );
+	recording = false;
+
+	// Publish
+	atomic_add( &commandsHead, 1 );
+#if RENDER_THREAD
+	renderThreadMutex.lock();
+	renderThreadCondition.wake_all();
+	renderThreadMutex.unlock();
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 namespace fGfx
 {
 	GfxIndexBuffer quadBatchIndexBuffer;
@@ -329,6 +528,7 @@ void fGfx::quad_batch_begin()
 
 void fGfx::quad_batch_end()
 {
+	PROFILE_ZONE( "fGfx::quad_batch_end" );
 	quadBatchVertexBuffer.write_end();
 	quadBatchVertexBuffer.draw( quadBatchIndexBuffer );
 }
@@ -336,6 +536,8 @@ void fGfx::quad_batch_end()
 
 void Gfx::quad_batch_break()
 {
+	if( fGfx::recording ) { record_command( GfxCommand_QuadBatchBreak ); return; }
+
 	if( fGfx::quadBatchVertexBuffer.current() > 0 )
 	{
 		fGfx::quad_batch_end();
@@ -346,6 +548,7 @@ void Gfx::quad_batch_break()
 
 bool Gfx::quad_batch_can_break()
 {
+	if( fGfx::recording ) { return false; }
 	return UNLIKELY( fGfx::quadBatchVertexBuffer.current() >= RENDER_QUAD_BATCH_SIZE * sizeof( GfxBuiltInQuad ) );
 }
 
@@ -359,16 +562,26 @@ void Gfx::quad_batch_break_check()
 }
 
 
-void Gfx::quad_batch_write( const GfxBuiltInQuad &quad, const GfxTexture2D *const texture )
+static inline void quad_batch_write_quad( const GfxBuiltInQuad &quad )
 {
-	// Bind Texture
-	if( LIKELY( texture != nullptr ) ) { texture->bind( 0 ); }
+	if( fGfx::recording ) { record_quad( quad ); return; }
 
 	// Break Batch
 	Gfx::quad_batch_break_check();
 
 	// Write Quad
 	fGfx::quadBatchVertexBuffer.write( quad );
+	PROFILE_GFX( Gfx::stats.frame.quadCount++ );
+}
+
+
+void Gfx::quad_batch_write( const GfxBuiltInQuad &quad, const GfxTexture2D *const texture )
+{
+	// Bind Texture
+	if( LIKELY( texture != nullptr ) ) { texture->bind( 0 ); }
+
+	// Write Quad
+	quad_batch_write_quad( quad );
 }
 
 
@@ -378,9 +591,6 @@ void Gfx::quad_batch_write( const float x1, const float y1, const float x2, cons
 	// Bind Texture
 	if( LIKELY( texture != nullptr ) ) { texture->bind( 0 ); }
 
-	// Break Batch
-	Gfx::quad_batch_break_check();
-
 	// Write Quad
 	const GfxBuiltInQuad quad =
 	{
@@ -390,7 +600,7 @@ void Gfx::quad_batch_write( const float x1, const float y1, const float x2, cons
 		{ { x2, y2, depth }, { u2, v2 }, { c4.r, c4.g, c4.b, c4.a } },
 	};
 
-	fGfx::quadBatchVertexBuffer.write( quad );
+	quad_batch_write_quad( quad );
 }
 
 
@@ -401,9 +611,6 @@ void Gfx::quad_batch_write( const float x1, const float y1, const float x2, cons
 	// Bind Texture
 	if( LIKELY( texture != nullptr ) ) { texture->bind( 0 ); }
 
-	// Break Batch
-	Gfx::quad_batch_break_check();
-
 	// Write Quad
 	const GfxBuiltInQuad quad =
 	{
@@ -413,7 +620,7 @@ void Gfx::quad_batch_write( const float x1, const float y1, const float x2, cons
 		{ { x4, y4, depth }, { u2, v2 }, { c4.r, c4.g, c4.b, c4.a } },
 	};
 
-	fGfx::quadBatchVertexBuffer.write( quad );
+	quad_batch_write_quad( quad );
 }
 
 
@@ -423,9 +630,6 @@ void Gfx::quad_batch_write( const float x1, const float y1, const float x2, cons
 	// Bind Texture
 	if( LIKELY( texture != nullptr ) ) { texture->bind( 0 ); }
 
-	// Break Batch
-	Gfx::quad_batch_break_check();
-
 	// Write Quad
 	const GfxBuiltInQuad quad =
 	{
@@ -435,7 +639,7 @@ void Gfx::quad_batch_write( const float x1, const float y1, const float x2, cons
 		{ { x2, y2, depth }, { u2, v2 }, { color.r, color.g, color.b, color.a } },
 	};
 
-	fGfx::quadBatchVertexBuffer.write( quad );
+	quad_batch_write_quad( quad );
 }
 
 
@@ -445,9 +649,6 @@ void Gfx::quad_batch_write( const float x1, const float y1, const float x2, cons
 	// Bind Texture
 	if( LIKELY( texture != nullptr ) ) { texture->bind( 0 ); }
 
-	// Break Batch
-	quad_batch_break_check();
-
 	// Write Quad
 	const GfxBuiltInQuad quad =
 	{
@@ -457,31 +658,62 @@ void Gfx::quad_batch_write( const float x1, const float y1, const float x2, cons
 		{ { x4, y4, depth }, { u2, v2 }, { color.r, color.g, color.b, color.a } },
 	};
 
-	fGfx::quadBatchVertexBuffer.write( quad );
+	quad_batch_write_quad( quad );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void GfxTexture2D::init( void *data, const u16 width, const u16 height, const GfxColorFormat &format )
+void GfxTexture2D::init( void *data, const u16 width, const u16 height, const GfxColorFormat &format, const u16 levels )
 {
-	ErrorIf( !bGfx::rb_texture_2d_init( resource, data, width, height, format ), "Failed to init Texture2D!" );
+	Assert( levels >= 1 );
+	if( fGfx::recording )
+	{
+		// Copy the pixels: the caller may modify (or free) 'data' before the stream is replayed
+		const usize size = data == nullptr ? 0 : bGfx::mip_chain_size_bytes( width, height, levels, format );
+		record_command( GfxCommand_TextureInit, GfxCommandTextureInit { this, size, width, height, format, levels } );
+		if( size > 0 ) { fGfx::commandsRecording->write( data, size ); }
+		return;
+	}
+
+	ErrorIf( !bGfx::rb_texture_2d_init( resource, data, width, height, format, levels ), "Failed to init Texture2D!" );
 }
 
 
 void GfxTexture2D::free()
 {
+	if( fGfx::recording )
+	{
+		// The resource may not exist yet (init recorded this frame); replay skips the free if it doesn't
+		for( const GfxTexture2D *&slot : Gfx::state().texture ) { if( slot == this ) { slot = nullptr; } }
+		record_command( GfxCommand_TextureFree, this );
+		return;
+	}
+
 	if( resource == nullptr ) { return; }
+
+	// Unbind (the next bind must not be filtered against a freed resource)
+	for( GfxTexture2DResource *&slot : Gfx::state().textureResource ) { if( slot == resource ) { slot = nullptr; } }
+
 	ErrorIf( !bGfx::rb_texture_2d_free( resource ), "Failed to free Texture2D!" );
 }
 
 
 void GfxTexture2D::bind( const int slot ) const
 {
+	GfxState &state = Gfx::state();
+	if( fGfx::recording )
+	{
+		if( state.texture[slot] == this ) { return; }
+		state.texture[slot] = this;
+		record_command( GfxCommand_TextureBind, GfxCommandTextureBind { this, slot } );
+		return;
+	}
+
 	// Texture binding forces a batch break
-	if( Gfx::state().textureResource[slot] == resource ) { return; }
+	if( state.textureResource[slot] == resource ) { return; }
 	draw_call();
 
-	Gfx::state().textureResource[slot] = resource;
+	state.textureResource[slot] = resource;
 	ErrorIf( !bGfx::rb_texture_2d_bind( resource, slot ), "Failed to bind Texture2D to slot %d!", slot );
 }
 
@@ -503,6 +735,7 @@ static GfxBlendState RT_CACHE_BLEND_STATE;
 
 void GfxRenderTarget2D::init( const u16 width, const u16 height, const GfxRenderTargetDescription &desc )
 {
+	AssertMsg( bGfx::colorFormatBlockSizeBytes[desc.colorFormat] == 0, "Render targets can't use block-compressed formats" );
 	ErrorIf( !bGfx::rb_render_target_2d_init( resource, textureColor.resource, textureDepth.resource, width, height, desc ),
 	         "Failed to init RenderTarget2D!" );
 
@@ -514,6 +747,15 @@ void GfxRenderTarget2D::init( const u16 width, const u16 height, const GfxRender
 void GfxRenderTarget2D::free()
 {
 	if( resource == nullptr ) { return; }
+
+	// Unbind (the next bind must not be filtered against a freed resource)
+	GfxState &state = Gfx::state();
+	AssertMsg( state.renderTargetResource != resource, "Trying to free a render target that is bound!" );
+	for( GfxTexture2DResource *&slot : state.textureResource )
+	{
+		if( slot == textureColor.resource || slot == textureDepth.resource ) { slot = nullptr; }
+	}
+
 	ErrorIf( !bGfx::rb_render_target_2d_free( resource, textureColor.resource, textureDepth.resource ),
 	         "Failed to free RenderTarget2D!" );
 }
@@ -521,14 +763,16 @@ void GfxRenderTarget2D::free()
 
 void GfxRenderTarget2D::bind( const int slot ) const
 {
+	AssertMsg( !fGfx::recording, "Render targets can not be recorded!" );
 	AssertMsg( !RENDER_TARGET_BOUND, "Trying to bind render target to slot that is already bound!" );
 	RENDER_TARGET_BOUND = true;
 
 	// Render target binding forces draw call
 	draw_call();
 
-	// Backend
-	ErrorIf( !bGfx::rb_render_target_2d_bind( resource, 0 ), "Failed to bind RenderTarget2D!" );
+	// Backend (applied by state_apply; redundant framebuffer switches are filtered there)
+	Assert( resource != nullptr );
+	Gfx::state().renderTargetResource = resource;
 
 	// MVP Matrix
 	RT_CACHE_MATRIX_MODEL = Gfx::get_matrix_model();
@@ -536,7 +780,12 @@ void GfxRenderTarget2D::bind( const int slot ) const
 	RT_CACHE_MATRIX_VIEW = Gfx::get_matrix_view();
 	Gfx::set_matrix_view( matrix_build_identity() );
 	RT_CACHE_MATRIX_PERSPECTIVE = Gfx::get_matrix_perspective();
+#if GRAPHICS_OPENGL
+	// OpenGL framebuffer textures store their bottom row first; flip so texture v = 0 is the top of the target
+	Gfx::set_matrix_perspective( matrix_build_orthographic( 0.0f, width, height, 0.0f, 0.0f, 1.0f ) );
+#else
 	Gfx::set_matrix_perspective( matrix_build_orthographic( 0.0f, width, 0.0f, height, 0.0f, 1.0f ) );
+#endif
 
 	// Viewport
 	RT_CACHE_VIEWPORT = bGfx::viewport;
@@ -564,8 +813,8 @@ void GfxRenderTarget2D::release() const
 	// Render target releasing forces draw call
 	draw_call();
 
-	// Backend
-	ErrorIf( !bGfx::rb_render_target_2d_release(), "Failed to release RenderTarget2D!" );
+	// Backend (applied by state_apply)
+	Gfx::state().renderTargetResource = nullptr;
 
 	// MVP Matrix
 	Gfx::set_matrix_model( RT_CACHE_MATRIX_MODEL );
@@ -582,6 +831,145 @@ void GfxRenderTarget2D::release() const
 	fGfx::state_apply();
 }
 
+
+bool GfxRenderTarget2D::read_color( void *buffer, const u32 size )
+{
+	AssertMsg( !fGfx::recording, "Render targets can not be recorded!" );
+	Assert( resource != nullptr );
+
+	// Flush draws still batched for this target
+	draw_call();
+
+	return bGfx::rb_render_target_2d_buffer_read_color( resource, textureColor.resource, buffer, size );
+}
+
+
+bool GfxRenderTarget2D::read_depth( void *buffer, const u32 size )
+{
+	AssertMsg( !fGfx::recording, "Render targets can not be recorded!" );
+	Assert( resource != nullptr && textureDepth.resource != nullptr );
+
+	// Flush draws still batched for this target
+	draw_call();
+
+	return bGfx::rb_render_target_2d_buffer_read_depth( resource, textureDepth.resource, buffer, size );
+}
+
+
+bool Gfx::request_readback( GfxRenderTarget2D &target, GfxReadbackCallback callback, void *userData )
+{
+	AssertMsg( !fGfx::recording, "Render targets can not be recorded!" );
+	Assert( target.resource != nullptr );
+	Assert( callback != nullptr );
+
+	// Flush draws still batched for this target
+	draw_call();
+
+	return bGfx::rb_render_target_2d_readback_request( target.resource, target.textureColor.resource, callback, userData );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Render Target Pool
+//
+// Entries are matched on (width, height, color format, depth format, cpu access). Acquired entries are returned to
+// the pool at the end of every frame; entries left unused for GFX_RENDER_TARGET_POOL_FRAMES frames are freed, and
+// the least recently used entry is evicted when the pool is full.
+
+struct GfxRenderTargetPoolEntry
+{
+	GfxRenderTarget2D target;
+	GfxRenderTargetDescription desc;
+	u32 frameUsed = 0;
+	bool acquired = false;
+};
+
+static GfxRenderTargetPoolEntry renderTargetPool[GFX_RENDER_TARGET_POOL_SIZE];
+static u32 renderTargetPoolFrame = 0;
+
+
+static bool render_target_pool_match( const GfxRenderTargetPoolEntry &entry, const u16 width, const u16 height,
+                                      const GfxRenderTargetDescription &desc )
+{
+	return entry.target.resource != nullptr &&
+	       entry.target.width == width &&
+	       entry.target.height == height &&
+	       entry.desc.colorFormat == desc.colorFormat &&
+	       entry.desc.depthFormat == desc.depthFormat &&
+	       entry.desc.cpuAccess == desc.cpuAccess;
+}
+
+
+GfxRenderTarget2D *Gfx::render_target_2d_acquire( const u16 width, const u16 height, const GfxRenderTargetDescription &desc )
+{
+	AssertMsg( !fGfx::recording, "Render targets can not be recorded!" );
+
+	// Reuse
+	GfxRenderTargetPoolEntry *slot = nullptr;
+	for( GfxRenderTargetPoolEntry &entry : renderTargetPool )
+	{
+		if( entry.acquired ) { continue; }
+		if( render_target_pool_match( entry, width, height, desc ) ) { slot = &entry; break; }
+
+		// Otherwise prefer an empty entry, then the least recently used one
+		if( slot == nullptr || ( slot->target.resource != nullptr &&
+		    ( entry.target.resource == nullptr || entry.frameUsed < slot->frameUsed ) ) ) { slot = &entry; }
+	}
+	ErrorReturnIf( slot == nullptr, nullptr, "%s: render target pool exhausted (GFX_RENDER_TARGET_POOL_SIZE: %u)",
+	               __FUNCTION__, GFX_RENDER_TARGET_POOL_SIZE );
+
+	// Create (evicting a different size/format)
+	if( !render_target_pool_match( *slot, width, height, desc ) )
+	{
+		slot->target.free();
+		slot->target.init( width, height, desc );
+		slot->desc = desc;
+	}
+
+	slot->acquired = true;
+	slot->frameUsed = renderTargetPoolFrame;
+	return &slot->target;
+}
+
+
+void Gfx::render_target_2d_release( GfxRenderTarget2D *target )
+{
+	for( GfxRenderTargetPoolEntry &entry : renderTargetPool )
+	{
+		if( &entry.target != target ) { continue; }
+		entry.acquired = false;
+		return;
+	}
+
+	Error( "%s: render target was not acquired from the pool", __FUNCTION__ );
+}
+
+
+void fGfx::render_target_pool_update()
+{
+	renderTargetPoolFrame++;
+
+	for( GfxRenderTargetPoolEntry &entry : renderTargetPool )
+	{
+		entry.acquired = false;
+		if( entry.target.resource == nullptr ) { continue; }
+		if( renderTargetPoolFrame - entry.frameUsed > GFX_RENDER_TARGET_POOL_FRAMES ) { entry.target.free(); }
+	}
+}
+
+
+bool fGfx::render_target_pool_free()
+{
+	for( GfxRenderTargetPoolEntry &entry : renderTargetPool )
+	{
+		entry.target.free();
+		entry.acquired = false;
+	}
+
+	// Success
+	return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void GfxShader::init( const u32 shaderID, const DiskShader &diskShader )
@@ -599,6 +987,13 @@ void GfxShader::free()
 
 void GfxShader::bind()
 {
+	if( fGfx::recording )
+	{
+		Gfx::state().shader.resource = resource;
+		record_command( GfxCommand_ShaderBind, shaderID );
+		return;
+	}
+
 	if( Gfx::state().shader.resource != resource )
 	{
 		draw_call(); // Shader changes force batch break
@@ -624,23 +1019,34 @@ void Gfx::viewport_update()
 	// Update Viewport
 	const i32 viewportWidth = static_cast<i32>( Window::width * Window::scale );
 	const i32 viewportHeight = static_cast<i32>( Window::height * Window::scale );
-	bGfx::rb_viewport_resize( viewportWidth, viewportHeight, Window::fullscreen );
+	Gfx::set_viewport_size( viewportWidth, viewportHeight, Window::fullscreen );
 
 	// Resize Swapchain
-	bGfx::rb_swapchain_resize( Window::width, Window::height, Window::fullscreen );
+	Gfx::set_swapchain_size( Window::width, Window::height, Window::fullscreen );
 }
 
 
 void Gfx::frame_begin()
 {
-	// Reset State
-	fGfx::state_reset();
+	if( fGfx::recording )
+	{
+		// Mirror the state reset so recorded state changes are filtered exactly as they will be on replay
+		record_command( GfxCommand_FrameBegin );
+		bGfx::states[0] = { };
+		bGfx::states[1] = { };
+		bGfx::flip = false;
+	}
+	else
+	{
+		// Reset State
+		fGfx::state_reset();
 
-	// Backend
-	bGfx::rb_frame_begin();
+		// Backend
+		bGfx::rb_frame_begin();
 
-	// Quad Batch
-	fGfx::quad_batch_begin();
+		// Quad Batch
+		fGfx::quad_batch_begin();
+	}
 
 	// Reset Matrices
 	const Matrix identity = matrix_build_identity();
@@ -657,6 +1063,7 @@ void Gfx::frame_end()
 {
 	// Stop Rendering
 	bGfx::rendering = false;
+	if( fGfx::recording ) { record_command( GfxCommand_FrameEnd ); return; }
 
 	// Quad Batch
 	fGfx::quad_batch_end();
@@ -664,6 +1071,9 @@ void Gfx::frame_end()
 	// Backend
 	bGfx::rb_frame_end();
 
+	// Render Target Pool
+	fGfx::render_target_pool_update();
+
 	// Statistics
 #if PROFILING_GFX
 	Gfx::statsPrevious = Gfx::stats;
@@ -674,24 +1084,28 @@ void Gfx::frame_end()
 
 void Gfx::clear_color( const Color color )
 {
+	if( fGfx::recording ) { record_command( GfxCommand_ClearColor, color ); return; }
 	bGfx::rb_clear_color( color );
 }
 
 
 void Gfx::clear_depth( const float depth )
 {
+	if( fGfx::recording ) { record_command( GfxCommand_ClearDepth, depth ); return; }
 	bGfx::rb_clear_depth( depth );
 }
 
 
 void Gfx::set_swapchain_size( const u16 width, const u16 height, const bool fullscreen )
 {
+	if( fGfx::recording ) { record_command( GfxCommand_SwapchainSize, GfxSwapChain { width, height, fullscreen } ); return; }
 	bGfx::rb_swapchain_resize( width, height, fullscreen );
 }
 
 
 void Gfx::set_viewport_size( const u16 width, const u16 height, const bool fullscreen )
 {
+	if( fGfx::recording ) { record_command( GfxCommand_ViewportSize, GfxViewport { width, height, fullscreen } ); return; }
 	bGfx::rb_viewport_resize( width, height, fullscreen );
 }
 
@@ -701,6 +1115,7 @@ void Gfx::set_shader_globals( const bGfxCBuffer::ShaderGlobals_t &globals )
 	// Shader globals changes force a batch break
 	if( Gfx::state().shader.globals == globals ) { return; }
 	Gfx::state().shader.globals = globals;
+	if( fGfx::recording ) { record_command( GfxCommand_ShaderGlobals, globals ); return; }
 
 	draw_call();
 	globals.upload();
@@ -711,7 +1126,8 @@ static void update_matrix_mvp()
 {
 	bGfx::matrixMVP = matrix_multiply( bGfx::matrixPerspective, matrix_multiply( bGfx::matrixView, bGfx::matrixModel ) );
 
-	auto &globals = GfxCBuffer::ShaderGlobals;
+	// Copied: with RENDER_THREAD, the recording & render threads both build globals
+	bGfxCBuffer::ShaderGlobals_t globals = GfxCBuffer::ShaderGlobals;
 	globals.matrixModel = bGfx::matrixModel;
 	globals.matrixView = bGfx::matrixView;
 	globals.matrixPerspective = bGfx::matrixPerspective;
@@ -806,6 +1222,7 @@ void Gfx::set_raster_state( const GfxRasterState &state )
 	if( Gfx::state().raster == state ) { return; }
 	draw_call();
 	Gfx::state().raster = state;
+	if( fGfx::recording ) { record_command( GfxCommand_RasterState, state ); }
 }
 
 
@@ -831,6 +1248,7 @@ void Gfx::set_sampler_state( const GfxSamplerState &state )
 	if( Gfx::state().sampler == state ) { return; }
 	draw_call();
 	Gfx::state().sampler = state;
+	if( fGfx::recording ) { record_command( GfxCommand_SamplerState, state ); }
 }
 
 
@@ -856,6 +1274,7 @@ void Gfx::set_blend_state( const GfxBlendState &state )
 	if( Gfx::state().blend == state ) { return; }
 	draw_call();
 	Gfx::state().blend = state;
+	if( fGfx::recording ) { record_command( GfxCommand_BlendState, state ); }
 }
 
 
@@ -901,6 +1320,7 @@ void Gfx::set_depth_state( const GfxDepthState &state )
 	if( Gfx::state().depth == state ) { return; }
 	draw_call();
 	Gfx::state().depth = state;
+	if( fGfx::recording ) { record_command( GfxCommand_DepthState, state ); }
 }
 
 
@@ -920,3 +1340,164 @@ void Gfx::set_depth_write_mask( const GfxDepthWriteFlag &mask )
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void replay_stream( Buffer &stream )
+{
+	stream.seek_start();
+
+	while( stream.tell < stream.current )
+	{
+		switch( stream.read<GfxCommand>() )
+		{
+			case GfxCommand_FrameBegin: Gfx::frame_begin(); break;
+			case GfxCommand_FrameEnd: Gfx::frame_end(); break;
+			case GfxCommand_ClearColor: Gfx::clear_color( stream.read<Color>() ); break;
+			case GfxCommand_ClearDepth: Gfx::clear_depth( stream.read<float>() ); break;
+			case GfxCommand_ShaderGlobals: Gfx::set_shader_globals( stream.read<bGfxCBuffer::ShaderGlobals_t>() ); break;
+			case GfxCommand_RasterState: Gfx::set_raster_state( stream.read<GfxRasterState>() ); break;
+			case GfxCommand_SamplerState: Gfx::set_sampler_state( stream.read<GfxSamplerState>() ); break;
+			case GfxCommand_BlendState: Gfx::set_blend_state( stream.read<GfxBlendState>() ); break;
+			case GfxCommand_DepthState: Gfx::set_depth_state( stream.read<GfxDepthState>() ); break;
+			case GfxCommand_ShaderBind: Gfx::shader_bind( stream.read<u32>() ); break;
+			case GfxCommand_QuadBatchBreak: Gfx::quad_batch_break(); break;
+
+			case GfxCommand_TextureBind:
+			{
+				const GfxCommandTextureBind command = stream.read<GfxCommandTextureBind>();
+				command.texture->bind( command.slot );
+			}
+			break;
+
+			case GfxCommand_Quads:
+			{
+				const u32 count = stream.read<u32>();
+				for( u32 i = 0; i < count; i++ ) { quad_batch_write_quad( stream.read<GfxBuiltInQuad>() ); }
+			}
+			break;
+
+			case GfxCommand_TextureInit:
+			{
+				const GfxCommandTextureInit command = stream.read<GfxCommandTextureInit>();
+				void *data = command.size > 0 ? stream.data + stream.tell : nullptr;
+				stream.tell += command.size;
+				command.texture->init( data, command.width, command.height, command.format, command.levels );
+			}
+			break;
+
+			case GfxCommand_TextureFree: stream.read<GfxTexture2D *>()->free(); break;
+
+			case GfxCommand_SwapchainSize:
+			{
+				const GfxSwapChain command = stream.read<GfxSwapChain>();
+				Gfx::set_swapchain_size( command.width, command.height, command.fullscreen );
+			}
+			break;
+
+			case GfxCommand_ViewportSize:
+			{
+				const GfxViewport command = stream.read<GfxViewport>();
+				Gfx::set_viewport_size( command.width, command.height, command.fullscreen );
+			}
+			break;
+
+			default:
+				Error( "%s: Invalid command at %llu", __FUNCTION__, static_cast<u64>( stream.tell - 1 ) );
+			return;
+		}
+	}
+}
+
+
+void fGfx::replay()
+{
+	Assert( !recording );
+
+	while( commands_pending() > 0 )
+	{
+		replay_stream( commands[static_cast<u32>( commandsTail ) % RENDER_COMMAND_STREAMS] );
+		atomic_add( &commandsTail, 1 );
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if RENDER_THREAD
+static THREAD_FUNCTION( render_thread )
+{
+	ErrorIf( !bGfx::rb_context_acquire(), "Gfx: render thread failed to acquire the graphics context" );
+
+	for( ;; )
+	{
+		// Wait for a published stream
+		fGfx::renderThreadMutex.lock();
+		while( commands_pending() == 0 && atomic_load( &fGfx::renderThreadRunning ) )
+		{
+			fGfx::renderThreadCondition.sleep( fGfx::renderThreadMutex );
+		}
+		fGfx::renderThreadMutex.unlock();
+
+		// Stopped & drained
+		if( commands_pending() == 0 ) { break; }
+
+		// Replay
+		replay_stream( fGfx::commands[static_cast<u32>( fGfx::commandsTail ) % RENDER_COMMAND_STREAMS] );
+		atomic_add( &fGfx::commandsTail, 1 );
+
+		// Release the stream to the recording thread
+		fGfx::renderThreadMutex.lock();
+		fGfx::renderThreadCondition.wake_all();
+		fGfx::renderThreadMutex.unlock();
+	}
+
+	bGfx::rb_context_release();
+	return 0;
+}
+#endif
+
+
+bool fGfx::render_thread_init()
+{
+#if RENDER_THREAD
+	renderThreadMutex.init();
+	renderThreadCondition.init();
+
+	// Hand the graphics context over to the render thread
+	ErrorReturnIf( !bGfx::rb_context_release(), false, "%s: Failed to release the graphics context", __FUNCTION__ );
+	atomic_store( &renderThreadRunning, 1 );
+	renderThread = Thread::create( render_thread );
+	ErrorReturnIf( renderThread == nullptr, false, "%s: Failed to create the render thread", __FUNCTION__ );
+#endif
+
+	// Success
+	return true;
+}
+
+
+bool fGfx::render_thread_free()
+{
+#if RENDER_THREAD
+	if( renderThread == nullptr ) { return true; }
+
+	// Stop (published streams are replayed first)
+	renderThreadMutex.lock();
+	atomic_store( &renderThreadRunning, 0 );
+	renderThreadCondition.wake_all();
+	renderThreadMutex.unlock();
+
+	ErrorReturnIf( !Thread::join( renderThread ), false, "%s: Failed to join the render thread", __FUNCTION__ );
+	renderThread = nullptr;
+
+	renderThreadCondition.free();
+	renderThreadMutex.free();
+
+	// Take the graphics context back
+	ErrorReturnIf( !bGfx::rb_context_acquire(), false, "%s: Failed to acquire the graphics context", __FUNCTION__ );
+#endif
+
+	// Success
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -26,6 +26,10 @@ struct GfxStatisticsFrame
 	u32 bufferMaps = 0;
 	u32 textureBinds = 0;
 	u32 shaderBinds = 0;
+	u32 renderTargetBinds = 0;
+	u32 quadCount = 0;        // quads written to the quad batch
+	u32 layerQuadsCached = 0; // quads replaced by CachedLayer draws
+	u32 layerRebuilds = 0;
 };
 
 struct GfxStatistics
@@ -67,6 +71,12 @@ struct GfxStatistics
 	#define PROFILE_GFX(expr)
 #endif
 
+#if RENDER_THREAD
+	#define RENDER_THREAD_LOCAL thread_local
+#else
+	#define RENDER_THREAD_LOCAL
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 using GfxResourceID = u32;
@@ -90,6 +100,12 @@ struct GfxResource
 #define GFX_RESOURCE_COUNT_RENDER_TARGET_2D ( 1024 )
 #define GFX_RESOURCE_COUNT_RENDER_TARGET_3D ( 1024 )
 
+#define GFX_RENDER_TARGET_POOL_SIZE   ( 32 ) // transient render targets alive at once
+#define GFX_RENDER_TARGET_POOL_FRAMES ( 60 ) // frames a pooled render target may go unused before it is freed
+
+#define GFX_READBACK_RING_SIZE ( 4 ) // asynchronous readbacks in flight at once
+#define GFX_READBACK_LATENCY   ( 2 ) // minimum frames between a readback request & its callback
+
 
 struct GfxIndexBufferResource;
 struct GfxVertexBufferResource;
@@ -121,6 +137,8 @@ enum_type( GfxColorFormat, u8 )
 	GfxColorFormat_R16,
 	GfxColorFormat_R16G16,
 	GfxColorFormat_R32,
+	GfxColorFormat_BC1, // 4x4 blocks (textures only)
+	GfxColorFormat_BC3, // 4x4 blocks (textures only)
 	GFXCOLORFORMAT_COUNT,
 };
 
@@ -137,13 +155,50 @@ namespace bGfx
 		2, // GfxColorFormat_R16
 		4, // GfxColorFormat_R16G16
 		4, // GfxColorFormat_R32
+		0, // GfxColorFormat_BC1
+		0, // GfxColorFormat_BC3
 	};
 	static_assert( ARRAY_LENGTH( colorFormatPixelSizeBytes ) == GFXCOLORFORMAT_COUNT, "Missing colorFormatPixelSizeBytes!" );
+
+	// Bytes per 4x4 block (0: not block compressed)
+	constexpr u32 colorFormatBlockSizeBytes[GFXCOLORFORMAT_COUNT] =
+	{
+		0,  // GfxColorFormat_NONE
+		0,  // GfxColorFormat_R8G8B8A8
+		0,  // GfxColorFormat_R10G10B10A2
+		0,  // GfxColorFormat_R8
+		0,  // GfxColorFormat_R8G8
+		0,  // GfxColorFormat_R16
+		0,  // GfxColorFormat_R16G16
+		0,  // GfxColorFormat_R32
+		8,  // GfxColorFormat_BC1
+		16, // GfxColorFormat_BC3
+	};
+	static_assert( ARRAY_LENGTH( colorFormatBlockSizeBytes ) == GFXCOLORFORMAT_COUNT, "Missing colorFormatBlockSizeBytes!" );
 }
 
 
 #define GFX_SIZE_IMAGE_COLOR_BYTES( width, height, depth, format ) \
-	( width * height * depth * bGfx::colorFormatPixelSizeBytes[ format ] )
+	( bGfx::colorFormatBlockSizeBytes[ format ] > 0 ? \
+		( ( width + 3 ) / 4 ) * ( ( height + 3 ) / 4 ) * depth * bGfx::colorFormatBlockSizeBytes[ format ] : \
+		width * height * depth * bGfx::colorFormatPixelSizeBytes[ format ] )
+
+
+namespace bGfx
+{
+	// Size of a mip chain ('levels' halvings, each dimension clamped to 1)
+	inline usize mip_chain_size_bytes( u32 width, u32 height, const u16 levels, const GfxColorFormat format )
+	{
+		usize size = 0;
+		for( u16 i = 0; i < levels; i++ )
+		{
+			size += GFX_SIZE_IMAGE_COLOR_BYTES( width, height, 1, format );
+			width = width > 1 ? width >> 1 : 1;
+			height = height > 1 ? height >> 1 : 1;
+		}
+		return size;
+	}
+}
 
 
 enum_type( GfxDepthFormat, u8 )
@@ -560,7 +615,8 @@ struct GfxTexture2D
 {
 	GfxTexture2DResource *resource = nullptr;
 
-	void init( void *data, const u16 width, const u16 height, const GfxColorFormat &format );
+	// 'data' holds 'levels' mips back to back, each half the previous size (clamped to 1)
+	void init( void *data, const u16 width, const u16 height, const GfxColorFormat &format, const u16 levels = 1 );
 	void free();
 	void bind( const int slot = 0 ) const;
 	void release() const;
@@ -590,7 +646,8 @@ struct GfxTexture3D
 
 namespace bGfx
 {
-	extern bool rb_texture_2d_init( GfxTexture2DResource *&resource, void *data, const u16 width, const u16 height, const GfxColorFormat &format );
+	extern bool rb_texture_2d_init( GfxTexture2DResource *&resource, void *data, const u16 width, const u16 height,
+		const GfxColorFormat &format, const u16 levels );
 	extern bool rb_texture_2d_free( GfxTexture2DResource *&resource );
 	extern bool rb_texture_2d_bind( const GfxTexture2DResource *const &resource, const int slot );
 	extern bool rb_texture_2d_release( const int slot );
@@ -620,6 +677,11 @@ struct GfxRenderTargetDescription
 };
 
 
+// 'pixels' holds width * height texels in the render target's color format (top row first) and is only valid
+// for the duration of the callback
+using GfxReadbackCallback = void (*)( const void *pixels, const u16 width, const u16 height, void *userData );
+
+
 struct GfxRenderTarget2D
 {
 	GfxRenderTarget2DResource *resource = nullptr;
@@ -631,6 +693,10 @@ struct GfxRenderTarget2D
 	void free();
 	void bind( const int slot = 0 ) const;
 	void release() const;
+
+	// Synchronous readback: stalls until the GPU has finished rendering to the target (see Gfx::request_readback)
+	bool read_color( void *buffer, const u32 size );
+	bool read_depth( void *buffer, const u32 size );
 };
 
 
@@ -676,6 +742,10 @@ namespace bGfx
 	extern bool rb_render_target_2d_buffer_write_color( GfxRenderTarget2DResource *&resource, GfxTexture2DResource *&resourceColor, const void *const buffer, const u32 size );
 	extern bool rb_render_target_2d_buffer_write_depth( GfxRenderTarget2DResource *&resource, GfxTexture2DResource *&resourceDepth, const void *const buffer, const u32 size );
 
+	// Queues an asynchronous color readback; the backend invokes 'callback' from rb_frame_end once it has completed
+	extern bool rb_render_target_2d_readback_request( GfxRenderTarget2DResource *&resource, GfxTexture2DResource *&resourceColor,
+	                                                  GfxReadbackCallback callback, void *userData );
+
 	#if 0
 	extern bool rb_render_target_1d_init( GfxRenderTarget1DResource *&renderTarget1DResource, const u16 width, const GfxRenderTargetDescription &desc = { } );
 	extern bool rb_render_target_3d_init( GfxRenderTarget3DResource *&renderTarget3DResource, const u16 width, const u16 height, const u16 depth, const GfxRenderTargetDescription &desc = { } );
@@ -723,7 +793,7 @@ struct GfxState
 {
 	GfxState()
 	{
-		for( u32 i = 0; i < 32; i++ ) { textureResource[i] = nullptr; }
+		for( u32 i = 0; i < 32; i++ ) { textureResource[i] = nullptr; texture[i] = nullptr; }
 	}
 
 	GfxRasterState raster;
@@ -733,15 +803,18 @@ struct GfxState
 	GfxShaderState shader;
 
 	GfxTexture2DResource *textureResource[32];
+	const GfxTexture2D *texture[32]; // recorded binds (resources belong to the replaying thread)
+	GfxRenderTarget2DResource *renderTargetResource = nullptr;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 namespace bGfx
 {
-	extern GfxState states[2];
-	extern bool flip;
-	extern bool rendering;
+	// With RENDER_THREAD, the recording (game) thread & the render thread each track their own frontend state
+	extern RENDER_THREAD_LOCAL GfxState states[2];
+	extern RENDER_THREAD_LOCAL bool flip;
+	extern RENDER_THREAD_LOCAL bool rendering;
 
 	extern GfxTexture2D textures[Assets::texturesCount];
 	extern GfxShader shaders[Gfx::shadersCount];
@@ -749,14 +822,18 @@ namespace bGfx
 	extern GfxSwapChain swapchain;
 	extern GfxViewport viewport;
 
-	extern Matrix matrixModel;
-	extern Matrix matrixView;
-	extern Matrix matrixPerspective;
-	extern Matrix matrixMVP;
+	extern RENDER_THREAD_LOCAL Matrix matrixModel;
+	extern RENDER_THREAD_LOCAL Matrix matrixView;
+	extern RENDER_THREAD_LOCAL Matrix matrixPerspective;
+	extern RENDER_THREAD_LOCAL Matrix matrixMVP;
 
 	extern bool rb_init();
 	extern bool rb_free();
 
+	// Binds/unbinds the graphics context to the calling thread
+	extern bool rb_context_acquire();
+	extern bool rb_context_release();
+
 	extern void rb_frame_begin();
 	extern void rb_frame_end();
 
@@ -786,6 +863,27 @@ namespace fGfx
 	extern bool quad_batch_free();
 	extern void quad_batch_begin();
 	extern void quad_batch_end();
+
+	// Render Target Pool
+	extern void render_target_pool_update();
+	extern bool render_target_pool_free();
+
+	// Command Recording
+	// While recording, the Gfx:: API serializes into a command stream instead of calling the backend
+	// Only the quad batch, state, shader, clear, texture 2D, viewport & frame calls are recorded--direct vertex
+	// buffer draws are not. Texture init data is copied into the stream; recorded textures must outlive the replay
+	// The recording thread never reads GfxTexture2D::resource--binds are tracked by texture (see Gfx::texture_bound)
+	extern RENDER_THREAD_LOCAL bool recording;
+	extern bool record_init();
+	extern bool record_free();
+	extern void record_begin();
+	extern void record_end(); // publishes the stream to replay() or the render thread
+	extern void replay();     // replays all published streams on the calling thread
+
+	// Render Thread (RENDER_THREAD)
+	// Transfers the graphics context to a dedicated thread that replays published streams
+	extern bool render_thread_init();
+	extern bool render_thread_free();
 };
 
 
@@ -794,6 +892,13 @@ namespace Gfx
 	inline GfxState &state() { return bGfx::states[bGfx::flip]; }
 	extern void set_state( const GfxState &state );
 
+	// Whether 'texture' is bound to 'slot' (compared by texture while recording, by resource otherwise)
+	inline bool texture_bound( const GfxTexture2D &texture, const int slot = 0 )
+	{
+		const GfxState &current = state();
+		return fGfx::recording ? current.texture[slot] == &texture : current.textureResource[slot] == texture.resource;
+	}
+
 	extern void viewport_update();
 
 	extern void frame_begin();
@@ -842,6 +947,16 @@ namespace Gfx
 	extern void set_depth_test_mode( const GfxDepthTestMode &mode );
 	extern void set_depth_write_mask( const GfxDepthWriteFlag &mask );
 
+	// Transient render targets are recycled by (width, height, color format, depth format) instead of being created
+	// & destroyed every frame; they stay valid until render_target_2d_release() or the end of the frame
+	extern GfxRenderTarget2D *render_target_2d_acquire( const u16 width, const u16 height,
+	                                                    const GfxRenderTargetDescription &desc = { } );
+	extern void render_target_2d_release( GfxRenderTarget2D *target );
+
+	// Copies the render target's color without stalling; 'callback' runs at frame end once the copy has completed
+	// (at least GFX_READBACK_LATENCY frames later). Returns false if GFX_READBACK_RING_SIZE readbacks are in flight
+	extern bool request_readback( GfxRenderTarget2D &target, GfxReadbackCallback callback, void *userData = nullptr );
+
 	inline void shader_bind( const u32 shader ) { bGfx::shaders[shader].bind(); }
 	inline void shader_release() { bGfx::shaders[SHADER_DEFAULT].bind(); }
 
@@ -0,0 +1,352 @@
+#include <manta/jobs.hpp>
+
+#include <manta/memory.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static_assert( ( JOBS_QUEUE_CAPACITY & ( JOBS_QUEUE_CAPACITY - 1 ) ) == 0, "JOBS_QUEUE_CAPACITY must be a power of 2" );
+
+#define JOBS_QUEUE_MASK ( JOBS_QUEUE_CAPACITY - 1 )
+#define JOBS_THREADS_MAX ( 64 )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Chase-Lev work-stealing deque
+// The owning thread pushes & pops at the bottom; other threads steal from the top. Jobs are stored by value: a slot
+// is only written by push() once it is free (b - t < capacity), and pop() / steal() copy the job out before claiming
+// it -- a copy torn by a concurrent push() is discarded because the claim (CAS on 'top') then fails.
+
+struct JobDeque
+{
+	Job buffer[JOBS_QUEUE_CAPACITY];
+	volatile i64 top;
+	volatile i64 bottom;
+
+	bool push( const Job &job );
+	bool pop( Job &job );
+	bool steal( Job &job );
+};
+
+
+bool JobDeque::push( const Job &job )
+{
+	const i64 b = atomic_load( &bottom );
+	const i64 t = atomic_load( &top );
+	if( UNLIKELY( b - t >= JOBS_QUEUE_CAPACITY ) ) { return false; }
+
+	buffer[b & JOBS_QUEUE_MASK] = job;
+	atomic_store( &bottom, b + 1 );
+	return true;
+}
+
+
+bool JobDeque::pop( Job &job )
+{
+	const i64 b = atomic_load( &bottom ) - 1;
+	atomic_store( &bottom, b );
+	const i64 t = atomic_load( &top );
+
+	// Empty
+	if( t > b )
+	{
+		atomic_store( &bottom, b + 1 );
+		return false;
+	}
+
+	// Last job -- race against stealers
+	job = buffer[b & JOBS_QUEUE_MASK];
+	if( t == b )
+	{
+		const bool claimed = atomic_compare_exchange( &top, t, t + 1 );
+		atomic_store( &bottom, b + 1 );
+		return claimed;
+	}
+
+	return true;
+}
+
+
+bool JobDeque::steal( Job &job )
+{
+	const i64 t = atomic_load( &top );
+	const i64 b = atomic_load( &bottom );
+	if( t >= b ) { return false; }
+
+	job = buffer[t & JOBS_QUEUE_MASK];
+	return atomic_compare_exchange( &top, t, t + 1 ); // false: lost the race
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct JobThread
+{
+	JobDeque deque;
+	void *handle;
+};
+
+
+static JobThread *threads = nullptr;
+static u32 threadCount = 0;
+static thread_local u32 threadIndex = U32_MAX; // U32_MAX: not a job thread
+
+static volatile i32 running = 0;
+static volatile i32 jobsQueued = 0;
+static volatile i32 workersSleeping = 0;
+static Mutex sleepMutex;
+static Condition sleepCondition;
+
+static Job deferred[JOBS_DEFERRED_CAPACITY]; // jobs waiting on a dependency counter
+static u32 deferredCount = 0;
+static volatile i32 deferredPending = 0;
+static Mutex deferredMutex;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void enqueue( const Job &job )
+{
+	JobThread &thread = threads[threadIndex];
+	ErrorIf( !thread.deque.push( job ), "Jobs: queue full on thread %u (JOBS_QUEUE_CAPACITY: %d)", threadIndex, JOBS_QUEUE_CAPACITY );
+
+	// Wake a sleeping worker
+	atomic_add( &jobsQueued, 1 );
+	if( atomic_load( &workersSleeping ) > 0 )
+	{
+		sleepMutex.lock();
+		sleepCondition.wake();
+		sleepMutex.unlock();
+	}
+}
+
+
+static bool defer( const Job &job )
+{
+	// 'deferredPending' is raised before checking the dependency so that a concurrent release_deferred() either sees
+	// this job or we see the dependency has already finished
+	deferredMutex.lock();
+	atomic_add( &deferredPending, 1 );
+
+	if( atomic_load( &job.dependency->value ) > 0 )
+	{
+		ErrorIf( deferredCount == JOBS_DEFERRED_CAPACITY, "Jobs: too many deferred jobs (JOBS_DEFERRED_CAPACITY: %d)", JOBS_DEFERRED_CAPACITY );
+		deferred[deferredCount++] = job;
+		deferredMutex.unlock();
+		return true;
+	}
+
+	atomic_add( &deferredPending, -1 );
+	deferredMutex.unlock();
+	return false;
+}
+
+
+static void release_deferred( const JobCounter *counter )
+{
+	if( atomic_load( &deferredPending ) == 0 ) { return; }
+
+	deferredMutex.lock();
+	for( u32 i = 0; i < deferredCount; )
+	{
+		if( deferred[i].dependency != counter ) { i++; continue; }
+
+		enqueue( deferred[i] );
+		deferred[i] = deferred[--deferredCount];
+		atomic_add( &deferredPending, -1 );
+	}
+	deferredMutex.unlock();
+}
+
+
+static bool next_job( Job &job )
+{
+	// Own queue first (LIFO for cache locality), then steal (FIFO) from the others
+	bool found = threads[threadIndex].deque.pop( job );
+
+	for( u32 i = 1; !found && i < threadCount; i++ )
+	{
+		found = threads[( threadIndex + i ) % threadCount].deque.steal( job );
+	}
+
+	if( found ) { atomic_add( &jobsQueued, -1 ); }
+	return found;
+}
+
+
+static void execute( const Job &job )
+{
+	job.function( job.data, job.begin, job.end );
+
+	if( job.counter != nullptr && atomic_add( &job.counter->value, -1 ) == 1 )
+	{
+		release_deferred( job.counter );
+	}
+}
+
+
+static THREAD_FUNCTION( worker )
+{
+	threadIndex = static_cast<u32>( reinterpret_cast<usize>( argument ) );
+
+	while( atomic_load( &running ) )
+	{
+		// Work
+		Job job;
+		if( next_job( job ) ) { execute( job ); continue; }
+
+		// Sleep until jobs are queued
+		sleepMutex.lock();
+		atomic_add( &workersSleeping, 1 );
+		while( atomic_load( &jobsQueued ) <= 0 && atomic_load( &running ) ) { sleepCondition.sleep( sleepMutex ); }
+		atomic_add( &workersSleeping, -1 );
+		sleepMutex.unlock();
+	}
+
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool iJobs::init()
+{
+	// Thread Count
+	const u32 cores = Thread::core_count();
+	u32 workers = JOBS_WORKER_COUNT < 0 ? cores - 1 : static_cast<u32>( JOBS_WORKER_COUNT );
+	workers = workers > JOBS_THREADS_MAX - 1 ? JOBS_THREADS_MAX - 1 : workers;
+	threadCount = workers + 1;
+
+	// Thread State
+	threads = reinterpret_cast<JobThread *>( memory_alloc( threadCount * sizeof( JobThread ) ) );
+	ErrorReturnIf( threads == nullptr, false, "Jobs: failed to allocate job threads" );
+	memory_set( threads, 0, threadCount * sizeof( JobThread ) );
+
+	sleepMutex.init();
+	sleepCondition.init();
+	deferredMutex.init();
+	deferredCount = 0;
+
+	// Main Thread
+	threadIndex = 0;
+	atomic_store( &running, 1 );
+
+	// Worker Threads (core 0 is left to the main thread)
+	for( u32 i = 1; i < threadCount; i++ )
+	{
+		threads[i].handle = Thread::create( worker, reinterpret_cast<void *>( static_cast<usize>( i ) ) );
+		ErrorReturnIf( threads[i].handle == nullptr, false, "Jobs: failed to create worker thread %u", i );
+		if( cores > 1 ) { Thread::pin( threads[i].handle, i % cores ); }
+	}
+
+	// Success
+	return true;
+}
+
+
+bool iJobs::free()
+{
+	if( threads == nullptr ) { return true; }
+
+	// Finish outstanding work
+	Job job;
+	while( next_job( job ) ) { execute( job ); }
+
+	// Stop Workers
+	sleepMutex.lock();
+	atomic_store( &running, 0 );
+	sleepCondition.wake_all();
+	sleepMutex.unlock();
+
+	for( u32 i = 1; i < threadCount; i++ )
+	{
+		ErrorReturnIf( !Thread::join( threads[i].handle ), false, "Jobs: failed to join worker thread %u", i );
+	}
+
+	// Free State
+	deferredMutex.free();
+	sleepCondition.free();
+	sleepMutex.free();
+
+	memory_free( threads );
+	threads = nullptr;
+	threadCount = 0;
+
+	// Success
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Jobs::submit( const Job &job )
+{
+	Assert( threads != nullptr );
+	Assert( threadIndex < threadCount ); // Jobs may only be submitted from the main thread or workers
+	Assert( job.function != nullptr );
+
+	if( job.counter != nullptr ) { atomic_add( &job.counter->value, 1 ); }
+	if( job.dependency != nullptr && defer( job ) ) { return; }
+	enqueue( job );
+}
+
+
+void Jobs::submit( JobFunction function, void *data, JobCounter *counter, JobCounter *dependency )
+{
+	Job job;
+	job.function = function;
+	job.data = data;
+	job.counter = counter;
+	job.dependency = dependency;
+	submit( job );
+}
+
+
+void Jobs::wait( JobCounter &counter )
+{
+	Assert( threadIndex < threadCount );
+
+	while( !counter.done() )
+	{
+		Job job;
+		if( next_job( job ) ) { execute( job ); continue; }
+		Thread::yield();
+	}
+}
+
+
+void Jobs::parallel_for( const u32 count, const u32 batchSize, JobFunction function, void *data,
+                         JobCounter &counter, JobCounter *dependency )
+{
+	const u32 batch = batchSize == 0 ? 1 : batchSize;
+
+	Job job;
+	job.function = function;
+	job.data = data;
+	job.counter = &counter;
+	job.dependency = dependency;
+
+	for( u32 begin = 0; begin < count; begin += batch )
+	{
+		job.begin = begin;
+		job.end = count - begin > batch ? begin + batch : count;
+		submit( job );
+	}
+}
+
+
+void Jobs::parallel_for( const u32 count, const u32 batchSize, JobFunction function, void *data )
+{
+	JobCounter counter;
+	parallel_for( count, batchSize, function, data, counter );
+	wait( counter );
+}
+
+
+u32 Jobs::worker_count()
+{
+	return threadCount > 0 ? threadCount - 1 : 0;
+}
+
+
+u32 Jobs::thread_index()
+{
+	return threadIndex;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
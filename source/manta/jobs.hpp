@@ -0,0 +1,60 @@
+#pragma once
+
+#include <config.hpp>
+#include <types.hpp>
+#include <debug.hpp>
+
+#include <manta/thread.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Processes the index range [begin, end)
+using JobFunction = void (*)( void *data, const u32 begin, const u32 end );
+
+
+struct JobCounter
+{
+	volatile i32 value = 0; // number of outstanding jobs
+
+	inline bool done() const { return atomic_load( &value ) == 0; }
+};
+
+
+struct Job
+{
+	JobFunction function = nullptr;
+	void *data = nullptr;
+	u32 begin = 0;
+	u32 end = 1;
+	JobCounter *counter = nullptr;    // decremented when this job finishes (optional)
+	JobCounter *dependency = nullptr; // job is held back until this counter reaches zero (optional)
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace iJobs
+{
+	extern bool init();
+	extern bool free();
+}
+
+
+namespace Jobs
+{
+	// Queue a job on the calling thread (workers steal from each other when idle)
+	extern void submit( const Job &job );
+	extern void submit( JobFunction function, void *data, JobCounter *counter = nullptr, JobCounter *dependency = nullptr );
+
+	// Blocks until 'counter' reaches zero, executing queued jobs while waiting
+	extern void wait( JobCounter &counter );
+
+	// Splits [0, count) into jobs of 'batchSize' indices
+	extern void parallel_for( const u32 count, const u32 batchSize, JobFunction function, void *data );
+	extern void parallel_for( const u32 count, const u32 batchSize, JobFunction function, void *data,
+	                          JobCounter &counter, JobCounter *dependency = nullptr ); // non-blocking
+
+	extern u32 worker_count(); // excludes the main thread
+	extern u32 thread_index(); // 0: main thread, 1..worker_count(): workers
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
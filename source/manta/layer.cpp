@@ -0,0 +1,65 @@
+#include <manta/layer.hpp>
+
+#include <manta/draw.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void CachedLayer::init( const u16 width, const u16 height, const GfxRenderTargetDescription &desc )
+{
+	free();
+	target.init( width, height, desc );
+	dirty = true;
+}
+
+
+void CachedLayer::free()
+{
+	AssertMsg( !building, "Trying to free a CachedLayer between begin() and end()!" );
+	target.free();
+	dirty = true;
+}
+
+
+bool CachedLayer::begin( const u32 hash )
+{
+	AssertMsg( target.resource != nullptr, "CachedLayer must be initialized before begin()!" );
+	AssertMsg( !building, "CachedLayer::begin() called twice without end()!" );
+	if( !dirty && hash == contentHash ) { return false; }
+
+	// Rebuild
+	contentHash = hash;
+	building = true;
+	target.bind();
+	Gfx::clear_color( { 0, 0, 0, 0 } );
+	if( target.textureDepth.resource != nullptr ) { Gfx::clear_depth(); }
+	PROFILE_GFX( quads = Gfx::stats.frame.quadCount );
+	return true;
+}
+
+
+void CachedLayer::end()
+{
+	AssertMsg( building, "CachedLayer::end() called without begin()!" );
+	target.release();
+	building = false;
+	dirty = false;
+	rebuilt = true;
+
+	PROFILE_GFX( quads = Gfx::stats.frame.quadCount - quads );
+	PROFILE_GFX( Gfx::stats.frame.layerRebuilds++ );
+}
+
+
+void CachedLayer::draw( const float x, const float y, const Color color, const float depth )
+{
+	AssertMsg( !building, "CachedLayer drawn between begin() and end()!" );
+	if( target.resource == nullptr ) { return; }
+
+	draw_render_target_2d( target, x, y, 1.0f, 1.0f, color, depth );
+
+	// Only draws that skipped a rebuild saved quads
+	PROFILE_GFX( if( !rebuilt ) { Gfx::stats.frame.layerQuadsCached += quads; } );
+	rebuilt = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <types.hpp>
+#include <debug.hpp>
+
+#include <manta/gfx.hpp>
+#include <manta/color.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Cached layers
+//
+// CachedLayer renders a group of draw calls once into an offscreen GfxRenderTarget2D and is otherwise drawn as a
+// single quad, so static content (HUD frames, tile backgrounds) costs one quad per frame instead of one per sprite.
+// The content is redrawn after mark_dirty() or when the hash passed to begin() changes. Layers can not be nested.
+// Render targets (and readback) can not be recorded, so layers are unavailable whenever fGfx::recording is set, which
+// is the case under both RENDER_THREAD and FRAME_PIPELINING.
+//
+//     static CachedLayer background;
+//     if( background.begin( tilesChecksum ) )
+//     {
+//         for( ... ) { draw_sprite( ... ); }
+//         background.end();
+//     }
+//     background.draw( 0.0f, 0.0f );
+
+class CachedLayer
+{
+public:
+	void init( const u16 width, const u16 height, const GfxRenderTargetDescription &desc = { } );
+	void free();
+
+	// Returns true if the content must be redrawn: draw it, then call end()
+	bool begin( const u32 hash = 0 );
+	void end();
+
+	void draw( const float x, const float y, const Color color = c_white, const float depth = 0.0f );
+	void mark_dirty() { dirty = true; }
+
+	u16 width() const { return target.width; }
+	u16 height() const { return target.height; }
+
+private:
+	GfxRenderTarget2D target;
+	u32 contentHash = 0;
+	u32 quads = 0; // quads drawn into the layer by the last rebuild (PROFILING_GFX)
+	bool dirty = true;
+	bool building = false;
+	bool rebuilt = false; // rebuilt since the last draw() (its quads were already counted in quadCount)
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,130 @@
+#include <manta/network.hpp>
+
+#include <manta/memory.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define LOOPBACK_SOCKETS_MAX ( 16 )
+#define LOOPBACK_QUEUE_LENGTH ( 64 ) // datagrams (oldest are dropped when full)
+
+struct LoopbackDatagram
+{
+	u16 port; // sender port
+	u16 size;
+	byte data[NETWORK_PACKET_SIZE];
+};
+
+
+struct LoopbackQueue
+{
+	LoopbackDatagram *datagrams = nullptr;
+	u16 port = 0; // 0: unused
+	u16 head = 0;
+	u16 count = 0;
+};
+
+
+static LoopbackQueue loopbackQueues[LOOPBACK_SOCKETS_MAX];
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static LoopbackQueue *loopback_find( const u16 port )
+{
+	for( LoopbackQueue &queue : loopbackQueues ) { if( queue.port == port ) { return &queue; } }
+	return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool Network::open( NetSocket &socket, const u16 port )
+{
+	Assert( socket.handle < 0 );
+	socket.loopback = false;
+	return bNetwork::socket_open( socket, port );
+}
+
+
+bool Network::open_loopback( NetSocket &socket, const u16 port )
+{
+	Assert( socket.handle < 0 );
+	ErrorReturnIf( port == 0, false, "Network: loopback sockets require a port" );
+	ErrorReturnIf( loopback_find( port ) != nullptr, false, "Network: loopback port %u is in use", port );
+
+	LoopbackQueue *queue = loopback_find( 0 );
+	ErrorReturnIf( queue == nullptr, false, "Network: exceeded %u loopback sockets", LOOPBACK_SOCKETS_MAX );
+	queue->datagrams = reinterpret_cast<LoopbackDatagram *>( memory_alloc( LOOPBACK_QUEUE_LENGTH * sizeof( LoopbackDatagram ) ) );
+	ErrorReturnIf( queue->datagrams == nullptr, false, "Network: failed to allocate loopback queue (port %u)", port );
+	queue->port = port;
+	queue->head = 0;
+	queue->count = 0;
+
+	socket.handle = static_cast<i64>( queue - loopbackQueues );
+	socket.port = port;
+	socket.loopback = true;
+
+	// Success
+	return true;
+}
+
+
+void Network::close( NetSocket &socket )
+{
+	if( socket.handle < 0 ) { return; }
+
+	if( socket.loopback )
+	{
+		LoopbackQueue &queue = loopbackQueues[socket.handle];
+		if( queue.datagrams != nullptr ) { memory_free( queue.datagrams ); }
+		queue = LoopbackQueue { };
+	}
+	else
+	{
+		bNetwork::socket_close( socket );
+	}
+
+	socket = NetSocket { };
+}
+
+
+bool Network::send( NetSocket &socket, const NetAddress &address, const void *data, const usize size )
+{
+	Assert( socket.handle >= 0 );
+	ErrorReturnIf( size > NETWORK_PACKET_SIZE, false, "Network: datagram exceeds NETWORK_PACKET_SIZE (%llu bytes)", size );
+	if( !socket.loopback ) { return bNetwork::socket_send( socket, address, data, size ); }
+
+	// Loopback datagrams to unknown ports are dropped (like UDP)
+	if( address.host != NET_HOST_LOCALHOST || address.port == 0 ) { return false; }
+	LoopbackQueue *queue = loopback_find( address.port );
+	if( queue == nullptr ) { return true; }
+
+	if( queue->count == LOOPBACK_QUEUE_LENGTH ) { queue->head = ( queue->head + 1 ) % LOOPBACK_QUEUE_LENGTH; queue->count--; }
+	LoopbackDatagram &datagram = queue->datagrams[( queue->head + queue->count ) % LOOPBACK_QUEUE_LENGTH];
+	datagram.port = socket.port;
+	datagram.size = static_cast<u16>( size );
+	memory_copy( datagram.data, data, size );
+	queue->count++;
+
+	// Success
+	return true;
+}
+
+
+usize Network::receive( NetSocket &socket, NetAddress &address, void *data, const usize capacity )
+{
+	Assert( socket.handle >= 0 );
+	if( !socket.loopback ) { return bNetwork::socket_receive( socket, address, data, capacity ); }
+
+	LoopbackQueue &queue = loopbackQueues[socket.handle];
+	if( queue.count == 0 ) { return 0; }
+
+	// Datagrams that exceed 'capacity' are truncated (like UDP)
+	const LoopbackDatagram &datagram = queue.datagrams[queue.head];
+	const usize size = datagram.size < capacity ? datagram.size : capacity;
+	memory_copy( data, datagram.data, size );
+	address = NetAddress { NET_HOST_LOCALHOST, datagram.port };
+	queue.head = ( queue.head + 1 ) % LOOPBACK_QUEUE_LENGTH;
+	queue.count--;
+	return size;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
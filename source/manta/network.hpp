@@ -1,3 +1,70 @@
 #pragma once
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
\ No newline at end of file
+#include <config.hpp>
+#include <types.hpp>
+#include <debug.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define NET_HOST_ANY ( 0x00000000 )
+#define NET_HOST_LOCALHOST ( 0x7F000001 ) // 127.0.0.1
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// IPv4 address & port (host byte order)
+struct NetAddress
+{
+	NetAddress() : host( 0 ), port( 0 ) { }
+	NetAddress( const u32 host, const u16 port ) : host( host ), port( port ) { }
+	NetAddress( const u8 a, const u8 b, const u8 c, const u8 d, const u16 port ) :
+		host( ( static_cast<u32>( a ) << 24 ) | ( static_cast<u32>( b ) << 16 ) | ( static_cast<u32>( c ) << 8 ) | d ),
+		port( port ) { }
+
+	u32 host;
+	u16 port;
+
+	bool operator==( const NetAddress &other ) const { return host == other.host && port == other.port; }
+	bool operator!=( const NetAddress &other ) const { return !( *this == other ); }
+};
+
+
+// Connectionless, non-blocking datagram socket
+// Loopback sockets never touch the OS: datagrams are queued in-process between sockets addressed as
+// NET_HOST_LOCALHOST:port, so a server & client can run inside one executable (or where no backend exists)
+struct NetSocket
+{
+	i64 handle = -1;
+	u16 port = 0;
+	bool loopback = false;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace bNetwork
+{
+	extern bool socket_open( NetSocket &socket, const u16 port );
+	extern void socket_close( NetSocket &socket );
+	extern bool socket_send( NetSocket &socket, const NetAddress &address, const void *data, const usize size );
+	extern usize socket_receive( NetSocket &socket, NetAddress &address, void *data, const usize capacity );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace Network
+{
+	// Opens a UDP socket bound to 'port' on all interfaces (0: any free port)
+	extern bool open( NetSocket &socket, const u16 port );
+
+	// Opens an in-process loopback socket (port must be non-zero and unused by other loopback sockets)
+	extern bool open_loopback( NetSocket &socket, const u16 port );
+
+	extern void close( NetSocket &socket );
+
+	// Datagrams larger than NETWORK_PACKET_SIZE are rejected
+	extern bool send( NetSocket &socket, const NetAddress &address, const void *data, const usize size );
+
+	// Returns the size of the next pending datagram written to 'data' (0: none pending)
+	extern usize receive( NetSocket &socket, NetAddress &address, void *data, const usize capacity );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -10,6 +10,51 @@
 #define NULL_BUCKET ( 0 )
 #define NULL_TYPE ( 0 )
 
+#define OBJECT_SNAPSHOT_MAGIC ( 0x504E534F ) // "OSNP"
+
+enum ObjectCommandType
+{
+	ObjectCommandType_CreateDefault,
+	ObjectCommandType_CreateManual,
+	ObjectCommandType_Destroy,
+};
+
+struct ObjectSnapshotHeader
+{
+	u32 magic;
+	u16 typeCount;
+	u16 bucketCount;
+};
+
+
+struct ObjectSnapshotType
+{
+	u16 version;
+	u16 size;
+	u16 sizeHot;
+	u16 capacity;
+};
+
+
+struct ObjectSnapshotBucket
+{
+	u16 type;
+	u16 bucketIDNext;
+	u16 bottom;
+	u16 top;
+	u16 initialized;
+};
+
+
+static usize snapshot_payload_size( const ObjectSnapshotBucket &info )
+{
+	// Instances & HOT field arrays in the range [bottom, top)
+	if( !info.initialized ) { return 0; }
+	usize size = iObjects::OBJECT_TYPE_SIZE[info.type];
+	for( u16 i = 0; i < iObjects::OBJECT_TYPE_HOT_FIELD_COUNT[info.type]; i++ ) { size += iObjects::OBJECT_TYPE_HOT_FIELDS[info.type][i].size; }
+	return size * ( info.top - info.bottom );
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 bool ObjectContext::init()
@@ -32,12 +77,17 @@ bool ObjectContext::init()
 		bucket->bucketID = bucketID;
 		bucket->type = bucketID;
 		bucket->bucketIDNext = i == capacity ? NULL_BUCKET : i;
-		bucketCache[bucketID] = bucketID;
+		bucketAvailable[bucketID] = bucketID; // lazy initialized in new_object_bucket()
 	}
 
 	// Object Instances
 	memory_set( objectCountType, 0, sizeof( objectCountType ) );
 
+	// Deferred Commands
+	commands.init( 1024, true );
+	commandCount = 0;
+	deferred = false;
+
 	// Success
 	return true;
 }
@@ -49,7 +99,10 @@ void ObjectContext::free()
 	if( buckets == nullptr ) { return; }
 
 	// Destroy all objects
+	deferred = false;
 	destroy_all();
+	commands.free();
+	commandCount = 0;
 
 	// Free ObjectBucket's
 	for( u16 bucketID = 0; bucketID < current; bucketID++ ) { buckets[bucketID].free(); }
@@ -120,43 +173,48 @@ ObjectContext::ObjectBucket *ObjectContext::new_object_bucket( const u16 type )
 		return nullptr;
 	}
 
-	// Lazy initialize first bucket for each object type
-	ObjectBucket *bucket = &buckets[bucketCache[type]];
-	if( bucket->data == nullptr ) { bucket->init( type ); }
-
-	// Find first bucket with room
-	for( ;; )
+	// Take the first bucket with room
+	u16 bucketID = bucketAvailable[type];
+	if( LIKELY( bucketID != NULL_BUCKET ) )
 	{
-		// Early out if the bucket still has capacity
-		if( LIKELY( bucket->current < iObjects::OBJECT_TYPE_BUCKET_CAPACITY[type] ) ) { break; }
-
-		// This bucket is full, but a 'next' bucket of our type already exists
-		if( bucket->bucketIDNext != NULL_BUCKET && buckets[bucket->bucketIDNext].type == bucket->type )
+		// Lazy initialize first bucket for each object type
+		ObjectBucket *bucket = &buckets[bucketID];
+		if( UNLIKELY( bucket->data == nullptr ) )
 		{
-			bucket = &buckets[bucket->bucketIDNext];
-			continue;
+			if( !bucket->init( type ) ) { return nullptr; }
 		}
-		// No existing buckets with room, lets make a new bucket
-		const u16 bucketIDPre = bucket->bucketID; // Store this since new_bucket can cause pointer invalidation (realloc)
-		const u16 bucketIDNew = new_bucket( type );
-		if( UNLIKELY( bucketIDNew == NULL_BUCKET ) ) { return nullptr; } // ObjectContext must be completely full of buckets
-		bucket = &buckets[bucketIDNew];
+		return bucket;
+	}
 
-		// Update bucket links
-		bucket->bucketIDNext = buckets[bucketIDPre].bucketIDNext;
-		buckets[bucketIDPre].bucketIDNext = bucketIDNew;
+	// No existing buckets with room, lets make a new bucket
+	bucketID = new_bucket( type );
+	if( UNLIKELY( bucketID == NULL_BUCKET ) ) { return nullptr; } // ObjectContext must be completely full of buckets
+	ObjectBucket *bucket = &buckets[bucketID];
 
-		// End loop
-		break;
-	}
+	// Link after the first bucket of this type (buckets of the same type stay contiguous)
+	bucket->bucketIDNext = buckets[type].bucketIDNext;
+	buckets[type].bucketIDNext = bucketID;
+
+	// Add to available buckets
+	bucket->bucketIDAvailable = NULL_BUCKET;
+	bucketAvailable[type] = bucketID;
 
-	// Add object
+	// Success
 	return bucket;
 }
 
 
 Object ObjectContext::create_default_constructor( const u16 type )
 {
+	// Deferred?
+	if( deferred )
+	{
+		const ObjectCommand command { ObjectCommandType_CreateDefault, type, NULL_OBJECT, 0 };
+		commands.write( command );
+		commandCount++;
+		return NULL_OBJECT;
+	}
+
 	ObjectBucket *bucket = new_object_bucket( type );
 	if( UNLIKELY( bucket == nullptr ) ) { return NULL_OBJECT; }
 	return bucket->new_object( true );
@@ -165,6 +223,22 @@ Object ObjectContext::create_default_constructor( const u16 type )
 
 Object ObjectContext::create_manual_constructor( const u16 type )
 {
+	// Deferred? (the constructor already ran, so store the prototype instance & HOT record)
+	if( deferred )
+	{
+		const u32 size = iObjects::OBJECT_TYPE_SIZE[type];
+		const u32 sizeHot = iObjects::OBJECT_TYPE_HOT_SIZE[type];
+		const ObjectCommand command { ObjectCommandType_CreateManual, type, NULL_OBJECT, size + sizeHot };
+		commands.write( command );
+		commands.write( iObjects::OBJECT_CTOR_MANUAL_BUFFER + iObjects::OBJECT_CTOR_BUFFER_OFFSET[type], size );
+		if( sizeHot > 0 )
+		{
+			commands.write( iObjects::OBJECT_CTOR_HOT_MANUAL_BUFFER + iObjects::OBJECT_CTOR_HOT_OFFSET[type], sizeHot );
+		}
+		commandCount++;
+		return NULL_OBJECT;
+	}
+
 	ObjectBucket *bucket = new_object_bucket( type );
 	if( UNLIKELY( bucket == nullptr ) ) { return NULL_OBJECT; }
 	return bucket->new_object( false );
@@ -174,10 +248,18 @@ Object ObjectContext::create_manual_constructor( const u16 type )
 bool ObjectContext::destroy( Object &object )
 {
 	// Fetch Bucket
-	if( UNLIKELY( object.bucketID >= current ) ) { return false; }
-	ObjectBucket *bucket = &buckets[ object.bucketID ];
-	if( UNLIKELY( object.type == NULL_TYPE || bucket->type != object.type ) ) { return false; }
-	if( UNLIKELY( bucket->data == nullptr ) ) { return false; }
+	ObjectBucket *bucket = object_bucket( object );
+	if( UNLIKELY( bucket == nullptr ) ) { return false; }
+
+	// Deferred?
+	if( deferred )
+	{
+		if( bucket->get_object( object.index, object.generation ) == nullptr ) { return false; }
+		const ObjectCommand command { ObjectCommandType_Destroy, object.type, object, 0 };
+		commands.write( command );
+		commandCount++;
+		return true;
+	}
 
 	// Remove Object
 	const bool success = bucket->delete_object( object.index, object.generation );
@@ -185,6 +267,74 @@ bool ObjectContext::destroy( Object &object )
 }
 
 
+void ObjectContext::defer_begin()
+{
+	Assert( buckets != nullptr );
+	Assert( !deferred );
+	deferred = true;
+}
+
+
+void ObjectContext::defer_end()
+{
+	Assert( deferred );
+	deferred = false;
+	if( commandCount == 0 ) { return; }
+
+	// Commands issued by events below (event_destroy, event_create) apply immediately
+	ObjectCommand command;
+
+	// Destroy objects (bottom & top are recomputed once per bucket below)
+	for( usize tell = 0; tell < commands.current; tell += sizeof( ObjectCommand ) + command.size )
+	{
+		memory_copy( &command, commands.data + tell, sizeof( ObjectCommand ) );
+		if( command.command != ObjectCommandType_Destroy ) { continue; }
+
+		ObjectBucket *bucket = object_bucket( command.object );
+		if( UNLIKELY( bucket == nullptr ) ) { continue; } // destroyed by destroy_all()
+		if( bucket->delete_object( command.object.index, command.object.generation, false ) ) { bucket->dirty = true; }
+	}
+
+	for( u16 bucketID = 0; bucketID < current; bucketID++ )
+	{
+		if( buckets[bucketID].dirty ) { buckets[bucketID].update_bounds(); }
+	}
+
+	// Create objects
+	for( usize tell = 0; tell < commands.current; tell += sizeof( ObjectCommand ) + command.size )
+	{
+		memory_copy( &command, commands.data + tell, sizeof( ObjectCommand ) );
+		const byte *const payload = commands.data + tell + sizeof( ObjectCommand );
+
+		switch( command.command )
+		{
+			case ObjectCommandType_CreateDefault:
+				create_default_constructor( command.type );
+			break;
+
+			case ObjectCommandType_CreateManual:
+			{
+				// Restore the constructed prototype
+				const u32 size = iObjects::OBJECT_TYPE_SIZE[command.type];
+				const u32 sizeHot = iObjects::OBJECT_TYPE_HOT_SIZE[command.type];
+				memory_copy( iObjects::OBJECT_CTOR_MANUAL_BUFFER + iObjects::OBJECT_CTOR_BUFFER_OFFSET[command.type], payload, size );
+				if( sizeHot > 0 )
+				{
+					memory_copy( iObjects::OBJECT_CTOR_HOT_MANUAL_BUFFER + iObjects::OBJECT_CTOR_HOT_OFFSET[command.type],
+						payload + size, sizeHot );
+				}
+				create_manual_constructor( command.type );
+			}
+			break;
+		}
+	}
+
+	// Reset command buffer
+	commands.clear();
+	commandCount = 0;
+}
+
+
 void ObjectContext::destroy_all()
 {
 	// Free all buckets
@@ -201,9 +351,9 @@ void ObjectContext::destroy_all()
 		// Reset ObjectBucket state
 		memory_copy( bucket, &bucketPrototype, sizeof( ObjectBucket ) );
 		bucket->bucketID = bucketID;
-		bucket->bucketIDNext = i == capacity ? NULL_BUCKET : i;
+		bucket->bucketIDNext = i == OBJECT_TYPE_COUNT ? NULL_BUCKET : i;
 		bucket->type = bucketID;
-		bucketCache[bucketID] = bucketID;
+		if( bucketID < OBJECT_TYPE_COUNT ) { bucketAvailable[bucketID] = bucketID; }
 	}
 
 	// Reset current
@@ -222,7 +372,244 @@ void ObjectContext::destroy_all_type( const u16 type )
 }
 
 
-byte * ObjectContext::object_pointer( const Object &object ) const
+bool ObjectContext::snapshot( Buffer &buffer )
+{
+	Assert( buckets != nullptr );
+	Assert( !deferred );
+	buffer.clear();
+
+	// Header
+	const ObjectSnapshotHeader header { OBJECT_SNAPSHOT_MAGIC, OBJECT_TYPE_COUNT, current };
+	buffer.write( header );
+
+	// Types
+	for( u16 type = 0; type < OBJECT_TYPE_COUNT; type++ )
+	{
+		const ObjectSnapshotType info { iObjects::OBJECT_TYPE_VERSION[type], iObjects::OBJECT_TYPE_SIZE[type],
+			iObjects::OBJECT_TYPE_HOT_SIZE[type], iObjects::OBJECT_TYPE_BUCKET_CAPACITY[type] };
+		buffer.write( info );
+	}
+
+	// Buckets
+	for( u16 bucketID = 0; bucketID < current; bucketID++ )
+	{
+		const ObjectBucket &bucket = buckets[bucketID];
+		const ObjectSnapshotBucket info { bucket.type, bucket.bucketIDNext, bucket.bottom, bucket.top, bucket.data != nullptr };
+		buffer.write( info );
+		if( bucket.data == nullptr || bucket.top == 0 ) { continue; }
+
+		// Instances
+		const usize size = iObjects::OBJECT_TYPE_SIZE[bucket.type];
+		const usize count = bucket.top - bucket.bottom;
+		const usize start = buffer.current;
+		buffer.write( bucket.data + bucket.bottom * size, count * size );
+
+		// HOT field arrays
+		const usize capacity = iObjects::OBJECT_TYPE_BUCKET_CAPACITY[bucket.type];
+		byte *const arrays = bucket.data + capacity * size;
+		for( u16 i = 0; i < iObjects::OBJECT_TYPE_HOT_FIELD_COUNT[bucket.type]; i++ )
+		{
+			const iObjects::HotFieldInfo &field = iObjects::OBJECT_TYPE_HOT_FIELDS[bucket.type][i];
+			buffer.write( arrays + capacity * field.recordOffset + bucket.bottom * field.size, count * field.size );
+		}
+
+		// EVENT_SAVE
+		const iObjects::SnapshotEvent event = iObjects::OBJECT_TYPE_EVENT_SAVE[bucket.type];
+		if( event == nullptr ) { continue; }
+		for( u16 index = bucket.bottom; index < bucket.top; index++ )
+		{
+			byte *const objectPtr = bucket.data + index * size;
+			if( reinterpret_cast<iObjects::OBJECT_BASE_t *>( objectPtr )->id.alive == false ) { continue; }
+			event( objectPtr, buffer.data + start + ( index - bucket.bottom ) * size );
+		}
+	}
+
+	// Success
+	return true;
+}
+
+
+bool ObjectContext::restore( Buffer &buffer )
+{
+	Assert( buckets != nullptr );
+	Assert( !deferred );
+	usize tell = 0;
+
+	// Header
+	ObjectSnapshotHeader header;
+	ErrorReturnIf( buffer.current < sizeof( ObjectSnapshotHeader ), false, "ObjectContext: snapshot is empty" );
+	memory_copy( &header, buffer.data, sizeof( ObjectSnapshotHeader ) );
+	tell += sizeof( ObjectSnapshotHeader );
+	ErrorReturnIf( header.magic != OBJECT_SNAPSHOT_MAGIC, false, "ObjectContext: invalid snapshot" );
+	ErrorReturnIf( header.typeCount != OBJECT_TYPE_COUNT, false,
+		"ObjectContext: snapshot has %u object types (expected %u)", header.typeCount, OBJECT_TYPE_COUNT );
+	ErrorReturnIf( header.bucketCount < OBJECT_TYPE_COUNT, false, "ObjectContext: snapshot has too few buckets" );
+
+	// Types
+	ErrorReturnIf( tell + OBJECT_TYPE_COUNT * sizeof( ObjectSnapshotType ) > buffer.current, false, "ObjectContext: snapshot is truncated" );
+	for( u16 type = 0; type < OBJECT_TYPE_COUNT; type++ )
+	{
+		ObjectSnapshotType info;
+		memory_copy( &info, buffer.data + tell, sizeof( ObjectSnapshotType ) );
+		tell += sizeof( ObjectSnapshotType );
+
+		ErrorReturnIf( info.version != iObjects::OBJECT_TYPE_VERSION[type], false,
+			"ObjectContext: snapshot of object type %u is version %u (expected %u)", type, info.version, iObjects::OBJECT_TYPE_VERSION[type] );
+		ErrorReturnIf( info.size != iObjects::OBJECT_TYPE_SIZE[type] || info.sizeHot != iObjects::OBJECT_TYPE_HOT_SIZE[type] ||
+			info.capacity != iObjects::OBJECT_TYPE_BUCKET_CAPACITY[type], false, "ObjectContext: snapshot of object type %u has a different layout", type );
+	}
+	const usize tellBuckets = tell;
+
+	// Validate buckets (the context is left untouched on failure)
+	for( u16 bucketID = 0; bucketID < header.bucketCount; bucketID++ )
+	{
+		ObjectSnapshotBucket info;
+		ErrorReturnIf( tell + sizeof( ObjectSnapshotBucket ) > buffer.current, false, "ObjectContext: snapshot is truncated" );
+		memory_copy( &info, buffer.data + tell, sizeof( ObjectSnapshotBucket ) );
+		tell += sizeof( ObjectSnapshotBucket );
+
+		ErrorReturnIf( info.type >= OBJECT_TYPE_COUNT || ( bucketID < OBJECT_TYPE_COUNT && info.type != bucketID ) ||
+			info.bucketIDNext >= header.bucketCount || info.bottom > info.top ||
+			info.top > iObjects::OBJECT_TYPE_BUCKET_CAPACITY[info.type], false, "ObjectContext: snapshot bucket %u is invalid", bucketID );
+
+		tell += snapshot_payload_size( info );
+		ErrorReturnIf( tell > buffer.current, false, "ObjectContext: snapshot is truncated" );
+	}
+
+	// Allocate the restored buckets before releasing the existing ones (the context is left untouched on failure)
+	while( capacity < header.bucketCount ) { ErrorReturnIf( !grow(), false, "ObjectContext: failed to grow buckets" ); }
+	const ObjectBucket bucketPrototype { *this };
+	ObjectBucket *staged = reinterpret_cast<ObjectBucket *>( memory_alloc( header.bucketCount * sizeof( ObjectBucket ) ) );
+	ErrorReturnIf( staged == nullptr, false, "ObjectContext: failed to allocate buckets" );
+	tell = tellBuckets;
+	for( u16 bucketID = 0; bucketID < header.bucketCount; bucketID++ )
+	{
+		ObjectSnapshotBucket info;
+		memory_copy( &info, buffer.data + tell, sizeof( ObjectSnapshotBucket ) );
+		tell += sizeof( ObjectSnapshotBucket ) + snapshot_payload_size( info );
+
+		ObjectBucket &bucket = staged[bucketID];
+		memory_copy( &bucket, &bucketPrototype, sizeof( ObjectBucket ) );
+		if( !info.initialized || bucket.init( info.type ) ) { continue; }
+
+		for( u16 i = 0; i < bucketID; i++ ) { staged[i].free(); }
+		memory_free( staged );
+		ErrorReturnMsg( false, "ObjectContext: failed to allocate bucket %u", bucketID );
+	}
+
+	// Restore buckets
+	memory_set( objectCountType, 0, sizeof( objectCountType ) );
+	objectCountTotal = 0;
+	tell = tellBuckets;
+	for( u16 bucketID = 0; bucketID < header.bucketCount; bucketID++ )
+	{
+		ObjectSnapshotBucket info;
+		memory_copy( &info, buffer.data + tell, sizeof( ObjectSnapshotBucket ) );
+		tell += sizeof( ObjectSnapshotBucket );
+
+		ObjectBucket &bucket = staged[bucketID];
+		bucket.bucketID = bucketID;
+		bucket.bucketIDNext = info.bucketIDNext;
+		bucket.type = info.type;
+		if( !info.initialized ) { continue; }
+		bucket.bottom = info.bottom;
+		bucket.top = info.top;
+
+		// Instances
+		const usize size = iObjects::OBJECT_TYPE_SIZE[info.type];
+		const usize count = info.top - info.bottom;
+		memory_copy( bucket.data + info.bottom * size, buffer.data + tell, count * size );
+		tell += count * size;
+
+		// HOT field arrays
+		const usize capacity = iObjects::OBJECT_TYPE_BUCKET_CAPACITY[info.type];
+		byte *const arrays = bucket.data + capacity * size;
+		for( u16 i = 0; i < iObjects::OBJECT_TYPE_HOT_FIELD_COUNT[info.type]; i++ )
+		{
+			const iObjects::HotFieldInfo &field = iObjects::OBJECT_TYPE_HOT_FIELDS[info.type][i];
+			memory_copy( arrays + capacity * field.recordOffset + info.bottom * field.size, buffer.data + tell, count * field.size );
+			tell += count * field.size;
+		}
+
+		// Restore vtable pointers (snapshots may come from another process) & rebuild the free slot stack
+		// Dead slots keep the newer of their snapshot & current generations, so handles taken before the restore can
+		// not match objects created after it
+		const ObjectBucket &existing = buckets[bucketID];
+		const bool generations = bucketID < current && existing.data != nullptr && existing.type == info.type;
+		const byte *const prototype = iObjects::OBJECT_CTOR_DEFAULT_BUFFER + iObjects::OBJECT_CTOR_BUFFER_OFFSET[info.type];
+		bucket.freeCount = 0;
+		for( u16 i = static_cast<u16>( capacity ); i > 0; i-- )
+		{
+			const u16 index = i - 1;
+			byte *const objectPtr = bucket.data + index * size;
+			if( index >= info.bottom && index < info.top ) { memory_copy( objectPtr, prototype, sizeof( void * ) ); }
+			Object &id = reinterpret_cast<iObjects::OBJECT_BASE_t *>( objectPtr )->id;
+			if( id.alive )
+			{
+				objectCountType[info.type]++;
+				objectCountTotal++;
+				continue;
+			}
+			if( generations )
+			{
+				const Object &previous = reinterpret_cast<iObjects::OBJECT_BASE_t *>( existing.data + index * size )->id;
+				id.generation = previous.generation > id.generation ? previous.generation : id.generation;
+			}
+			bucket.freeSlots[bucket.freeCount++] = index;
+		}
+	}
+
+	// Release existing buckets (no destroy events) & move the restored ones in
+	for( u16 bucketID = 0; bucketID < current; bucketID++ ) { buckets[bucketID].free(); }
+	memory_copy( buckets, staged, header.bucketCount * sizeof( ObjectBucket ) );
+	memory_free( staged );
+
+	// Reset unused buckets
+	for( u16 bucketID = header.bucketCount; bucketID < current; bucketID++ )
+	{
+		memory_copy( &buckets[bucketID], &bucketPrototype, sizeof( ObjectBucket ) );
+	}
+	current = header.bucketCount;
+
+	// Rebuild available bucket lists (lowest bucketID first)
+	for( u16 type = 0; type < OBJECT_TYPE_COUNT; type++ ) { bucketAvailable[type] = NULL_BUCKET; }
+	for( u16 i = current; i > 0; i-- )
+	{
+		ObjectBucket &bucket = buckets[i - 1];
+		const bool lazy = bucket.data == nullptr && bucket.bucketID < OBJECT_TYPE_COUNT;
+		if( !lazy && bucket.freeCount == 0 ) { continue; }
+		bucket.bucketIDAvailable = bucketAvailable[bucket.type];
+		bucketAvailable[bucket.type] = bucket.bucketID;
+	}
+
+	// EVENT_LOAD
+	tell = tellBuckets;
+	for( u16 bucketID = 0; bucketID < current; bucketID++ )
+	{
+		ObjectSnapshotBucket info;
+		memory_copy( &info, buffer.data + tell, sizeof( ObjectSnapshotBucket ) );
+		tell += sizeof( ObjectSnapshotBucket );
+		const usize start = tell;
+		tell += snapshot_payload_size( info );
+
+		const iObjects::SnapshotEvent event = iObjects::OBJECT_TYPE_EVENT_LOAD[info.type];
+		if( event == nullptr || !info.initialized ) { continue; }
+		const ObjectBucket &bucket = buckets[bucketID];
+		const usize size = iObjects::OBJECT_TYPE_SIZE[info.type];
+		for( u16 index = info.bottom; index < info.top; index++ )
+		{
+			byte *const objectPtr = bucket.data + index * size;
+			if( reinterpret_cast<iObjects::OBJECT_BASE_t *>( objectPtr )->id.alive == false ) { continue; }
+			event( objectPtr, buffer.data + start + ( index - info.bottom ) * size );
+		}
+	}
+
+	// Success
+	return true;
+}
+
+
+ObjectContext::ObjectBucket *ObjectContext::object_bucket( const Object &object ) const
 {
 	// Fetch Bucket
 	Assert( buckets != nullptr );
@@ -230,25 +617,80 @@ byte * ObjectContext::object_pointer( const Object &object ) const
 	ObjectBucket *bucket = &buckets[ object.bucketID ];
 	if( UNLIKELY( object.type == NULL_TYPE || bucket->type != object.type ) ) { return nullptr; } // invalid object type or Object<->ObjectBucket missmatch
 	if( UNLIKELY( bucket->data == nullptr ) ) { return nullptr; } // ObjectBucket isn't initialized
+	return bucket;
+}
+
+
+byte * ObjectContext::object_pointer( const Object &object ) const
+{
+	// Fetch Bucket
+	ObjectBucket *bucket = object_bucket( object );
+	if( UNLIKELY( bucket == nullptr ) ) { return nullptr; }
 
 	// Get Object Pointer
 	return bucket->get_object( object.index, object.generation );
 }
 
+
+u16 ObjectContext::fields_bucket( const u16 type, u16 bucketID ) const
+{
+	// Buckets of the same type are linked contiguously, starting from the bucket with bucketID == type
+	while( bucketID != NULL_BUCKET && buckets[bucketID].type == type )
+	{
+		const ObjectBucket &bucket = buckets[bucketID];
+		if( bucket.data != nullptr && bucket.top > 0 ) { return bucketID; }
+		bucketID = bucket.bucketIDNext;
+	}
+
+	return NULL_BUCKET;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+byte *iObjects::object_hot_prototype( const byte *object, const u16 recordOffset )
+{
+	// Constructors run on the prototypes in OBJECT_CTOR_*_BUFFER, so HOT fields resolve to the matching record in
+	// OBJECT_CTOR_HOT_*_BUFFER (copied into the bucket's field arrays by ObjectBucket::new_object)
+	const bool manual = object >= OBJECT_CTOR_MANUAL_BUFFER && object < OBJECT_CTOR_MANUAL_BUFFER + OBJECT_CTOR_BUFFER_SIZE;
+	const bool prototype = manual || ( object >= OBJECT_CTOR_DEFAULT_BUFFER && object < OBJECT_CTOR_DEFAULT_BUFFER + OBJECT_CTOR_BUFFER_SIZE );
+	AssertMsg( prototype, "Accessed a HOT field of a destroyed object (%p)", object );
+
+	const u32 offset = static_cast<u32>( object - ( manual ? OBJECT_CTOR_MANUAL_BUFFER : OBJECT_CTOR_DEFAULT_BUFFER ) );
+	byte *const records = manual ? OBJECT_CTOR_HOT_MANUAL_BUFFER : OBJECT_CTOR_HOT_DEFAULT_BUFFER;
+	for( u16 type = 0; type < OBJECT_TYPE_COUNT; type++ )
+	{
+		if( OBJECT_CTOR_BUFFER_OFFSET[type] == offset && OBJECT_TYPE_HOT_SIZE[type] > 0 )
+		{
+			return records + OBJECT_CTOR_HOT_OFFSET[type] + recordOffset;
+		}
+	}
+
+	AssertMsg( false, "Failed to resolve HOT field prototype (%p)", object );
+	return nullptr;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 bool ObjectContext::ObjectBucket::init( const u16 type )
 {
 	// State
+	const u16 capacity = iObjects::OBJECT_TYPE_BUCKET_CAPACITY[type];
 	this->type = type;
-	this->current = 0;
 	this->top = 0;
 	this->bottom = 0;
 
-	// Allocate Memory
-	data = reinterpret_cast<byte *>( memory_alloc( iObjects::OBJECT_TYPE_BUCKET_CAPACITY[type] * iObjects::OBJECT_TYPE_SIZE[type] ) );
-	if( data != nullptr ) { memory_set( data, 0, iObjects::OBJECT_TYPE_BUCKET_CAPACITY[type] * iObjects::OBJECT_TYPE_SIZE[type] ); return true; }
-	return false;
+	// Allocate Memory (instances followed by HOT field arrays, then the free slot stack)
+	const usize size = capacity * ( static_cast<usize>( iObjects::OBJECT_TYPE_SIZE[type] ) + iObjects::OBJECT_TYPE_HOT_SIZE[type] );
+	data = reinterpret_cast<byte *>( memory_alloc( size + capacity * sizeof( u16 ) ) );
+	if( data == nullptr ) { return false; }
+	memory_set( data, 0, size );
+
+	// Free slots (popped lowest index first)
+	freeSlots = reinterpret_cast<u16 *>( data + size );
+	for( freeCount = 0; freeCount < capacity; freeCount++ ) { freeSlots[freeCount] = capacity - 1 - freeCount; }
+
+	// Success
+	return true;
 }
 
 
@@ -258,6 +700,8 @@ void ObjectContext::ObjectBucket::free()
 	if( data == nullptr ) { return; }
 	memory_free( data );
 	data = nullptr;
+	freeSlots = nullptr;
+	freeCount = 0;
 }
 
 
@@ -277,10 +721,21 @@ Object ObjectContext::ObjectBucket::new_object( const bool defaultConstructor )
 {
 	// At capacity?
 	Assert( data != nullptr );
-	if( UNLIKELY( current == iObjects::OBJECT_TYPE_BUCKET_CAPACITY[type] ) ) { return NULL_OBJECT; }
+	if( UNLIKELY( freeCount == 0 ) ) { return NULL_OBJECT; }
+
+	// Pop free slot
+	const u16 index = freeSlots[--freeCount];
+
+	// Bucket full? (new_object_bucket() always returns the head of the available list)
+	if( freeCount == 0 )
+	{
+		Assert( context.bucketAvailable[type] == bucketID );
+		context.bucketAvailable[type] = bucketIDAvailable;
+		bucketIDAvailable = NULL_BUCKET;
+	}
 
 	// Object Constructor
-	byte *const objectPtr = data + current * iObjects::OBJECT_TYPE_SIZE[type];
+	byte *const objectPtr = data + index * iObjects::OBJECT_TYPE_SIZE[type];
 	iObjects::OBJECT_BASE_t *object = reinterpret_cast<iObjects::OBJECT_BASE_t *>( objectPtr );
 	const u16 generation = object->id.generation + 1;
 	const byte *const constructorTable = defaultConstructor ? iObjects::OBJECT_CTOR_DEFAULT_BUFFER : iObjects::OBJECT_CTOR_MANUAL_BUFFER;
@@ -288,27 +743,35 @@ Object ObjectContext::ObjectBucket::new_object( const bool defaultConstructor )
 	memory_copy( object, constructor, iObjects::OBJECT_TYPE_SIZE[type] );
 
 	// Set Object
-	object->id = { type, generation, bucketID, current };
+	object->id = { type, generation, bucketID, index };
 	object->id.alive = true;
 
-	// Move current to next open slot
-	while( ++current < iObjects::OBJECT_TYPE_BUCKET_CAPACITY[type] )
+	// Scatter HOT fields into the field arrays
+	if( iObjects::OBJECT_TYPE_HOT_SIZE[type] > 0 )
 	{
-		const byte *const objectPtr = data + current * iObjects::OBJECT_TYPE_SIZE[type];
-		if( reinterpret_cast<const iObjects::OBJECT_BASE_t *>( objectPtr )->id.alive == false ) { break; }
+		const usize capacity = iObjects::OBJECT_TYPE_BUCKET_CAPACITY[type];
+		const byte *const recordTable = defaultConstructor ? iObjects::OBJECT_CTOR_HOT_DEFAULT_BUFFER : iObjects::OBJECT_CTOR_HOT_MANUAL_BUFFER;
+		const byte *const record = recordTable + iObjects::OBJECT_CTOR_HOT_OFFSET[type];
+		byte *const arrays = data + capacity * iObjects::OBJECT_TYPE_SIZE[type];
+
+		for( u16 i = 0; i < iObjects::OBJECT_TYPE_HOT_FIELD_COUNT[type]; i++ )
+		{
+			const iObjects::HotFieldInfo &field = iObjects::OBJECT_TYPE_HOT_FIELDS[type][i];
+			memory_copy( arrays + capacity * field.recordOffset + index * field.size, record + field.recordOffset, field.size );
+		}
 	}
 
 	// Update bottom & top
-	bottom = ( current - 1 ) < bottom ? ( current - 1 ) : bottom;
-	top = current > top ? current : top;
+	if( top == 0 ) { bottom = index; top = index + 1; } else
+	{
+		bottom = index < bottom ? index : bottom;
+		top = index >= top ? index + 1 : top;
+	}
 
 	// Increment Object Count
 	context.objectCountType[type]++;
 	context.objectCountTotal++;
 
-	// Cache bucket
-	context.bucketCache[type] = bucketID;
-
 	// Create Event
 	object->event_create();
 
@@ -317,7 +780,7 @@ Object ObjectContext::ObjectBucket::new_object( const bool defaultConstructor )
 }
 
 
-bool ObjectContext::ObjectBucket::delete_object( const u16 index, const u16 generation )
+bool ObjectContext::ObjectBucket::delete_object( const u16 index, const u16 generation, const bool updateBounds )
 {
 	// Verify alive
 	Assert( data != nullptr );
@@ -333,34 +796,18 @@ bool ObjectContext::ObjectBucket::delete_object( const u16 index, const u16 gene
 	// Mark dead
 	object->id.alive = false;
 
-	// Update current
-	if( index < current ) { current = index; }
-
-	// Update bottom
-	if( index == bottom )
-	{
-		iObjects::OBJECT_BASE_t *objectBottom = reinterpret_cast<iObjects::OBJECT_BASE_t *>( data + bottom * iObjects::OBJECT_TYPE_SIZE[type] );
-		while( bottom < iObjects::OBJECT_TYPE_BUCKET_CAPACITY[type] && objectBottom->id.alive == false )
-		{
-			bottom++;
-			objectBottom = reinterpret_cast<iObjects::OBJECT_BASE_t *>( data + bottom * iObjects::OBJECT_TYPE_SIZE[type] );
-		}
-		if( bottom == iObjects::OBJECT_TYPE_BUCKET_CAPACITY[type] ) { bottom = 0; }
-	}
+	// Push free slot
+	freeSlots[freeCount++] = index;
 
-	// Update top
-	if( index == ( top - 1 ) )
+	// Bucket has room again?
+	if( freeCount == 1 )
 	{
-		iObjects::OBJECT_BASE_t *objectTop = reinterpret_cast<iObjects::OBJECT_BASE_t *>( data + ( top - 1 ) * iObjects::OBJECT_TYPE_SIZE[type] );
-		while( top > 0 && objectTop->id.alive == false )
-		{
-			top--;
-			objectTop = reinterpret_cast<iObjects::OBJECT_BASE_t *>( data + ( top - 1 ) * iObjects::OBJECT_TYPE_SIZE[type] );
-		}
+		bucketIDAvailable = context.bucketAvailable[type];
+		context.bucketAvailable[type] = bucketID;
 	}
 
-	// Cache bucket
-	context.bucketCache[type] = context.bucketCache[type] > bucketID ? bucketID : context.bucketCache[type];
+	// Update bottom & top
+	if( updateBounds && ( index == bottom || index == top - 1 ) ) { update_bounds(); }
 
 	// Decerement Object Count
 	context.objectCountType[type]--;
@@ -371,6 +818,22 @@ bool ObjectContext::ObjectBucket::delete_object( const u16 index, const u16 gene
 }
 
 
+void ObjectContext::ObjectBucket::update_bounds()
+{
+	// The existing bounds are conservative, so shrink them inwards
+	const u16 size = iObjects::OBJECT_TYPE_SIZE[type];
+
+	// Update top
+	while( top > 0 && reinterpret_cast<iObjects::OBJECT_BASE_t *>( data + ( top - 1 ) * size )->id.alive == false ) { top--; }
+
+	// Update bottom
+	while( bottom < top && reinterpret_cast<iObjects::OBJECT_BASE_t *>( data + bottom * size )->id.alive == false ) { bottom++; }
+	if( bottom == top ) { bottom = 0; }
+
+	dirty = false;
+}
+
+
 byte * ObjectContext::ObjectBucket::get_object( const u16 index, const u16 generation ) const
 {
 	// Get Object Pointer
@@ -3,6 +3,8 @@
 #include <types.hpp>
 #include <debug.hpp>
 
+#include <manta/buffer.hpp>
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 template <int N> struct ObjectHandle { };
@@ -61,6 +63,62 @@ private:
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// HOT fields are stored per ObjectBucket as structure-of-arrays rather than inside the object instance. Objects keep
+// an empty ObjectHotField accessor in their place, so both 'x' (within events) and 'handle->x' remain valid.
+//
+// Bucket layout: [ instances: capacity * OBJECT_TYPE_SIZE ][ field arrays: capacity * OBJECT_TYPE_HOT_SIZE ]
+// Each field array begins at 'capacity * recordOffset' where recordOffset is the field's offset in the hot record
+
+namespace iObjects
+{
+	struct HotFieldInfo
+	{
+		u16 objectOffset; // accessor offset within the object instance
+		u16 recordOffset; // field offset within the hot record (obj_*_hot_t)
+		u16 size;
+	};
+
+	template <int N> struct object_hot; // impl: objects.generated.hpp
+
+	using SnapshotEvent = void (*)( void *object, byte *buffer ); // EVENT_SAVE, EVENT_LOAD, EVENT_NETWORK_* (OBJECT_TYPE_EVENT_*)
+
+	struct NetFieldInfo
+	{
+		u16 offset; // field offset within the object instance
+		u16 size;
+		u16 hot;    // index into OBJECT_TYPE_HOT_FIELDS (U16_MAX: not a HOT field)
+	};
+
+	inline byte *object_hot_field( const void *field, const HotFieldInfo &info );
+	extern byte *object_hot_prototype( const byte *object, const u16 recordOffset );
+}
+
+
+template <int N, int F, typename T> struct ObjectHotField
+{
+	ObjectHotField() = default;
+	ObjectHotField( const ObjectHotField & ) = delete; // accessors locate their object by address
+
+	inline T &get() const { return *reinterpret_cast<T *>( iObjects::object_hot_field( this, iObjects::object_hot<N>::fields[F] ) ); }
+	inline operator T &() const { return get(); }
+
+	inline T &operator=( const ObjectHotField &other ) { return get() = other.get(); }
+	inline T &operator=( const T &value ) { return get() = value; }
+	inline T &operator+=( const T &value ) { return get() += value; }
+	inline T &operator-=( const T &value ) { return get() -= value; }
+	inline T &operator*=( const T &value ) { return get() *= value; }
+	inline T &operator/=( const T &value ) { return get() /= value; }
+	inline T &operator++() { return ++get(); }
+	inline T &operator--() { return --get(); }
+	inline T operator++( int ) { return get()++; }
+	inline T operator--( int ) { return get()--; }
+};
+
+
+template <int N> struct ObjectFields { }; // HOT field arrays of one ObjectBucket (impl: objects.generated.hpp)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 #include <objects.generated.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -78,19 +136,23 @@ public:
 	{
 		ObjectBucket( ObjectContext &context ) : context( context ) { }
 
-		ObjectContext &context; // parent ObjectContext
-		byte *data = nullptr;   // data buffer pointer
-		u16 bucketIDNext = 0;   // index of next ObjectBucket in ObjectContext
-		u16 bucketID = 0;       // index of this ObjectBucket in ObjectContext
-		u16 current = 0;        // current insertion index
-		u16 type = 0;           // object type
-		u16 bottom = 0;         // lowest 'alive' index
-		u16 top = 0;            // highest 'alive' index
+		ObjectContext &context;    // parent ObjectContext
+		byte *data = nullptr;      // data buffer pointer
+		u16 bucketIDNext = 0;      // index of next ObjectBucket in ObjectContext
+		u16 bucketID = 0;          // index of this ObjectBucket in ObjectContext
+		u16 bucketIDAvailable = 0; // index of next ObjectBucket of this type with free slots
+		u16 *freeSlots = nullptr;  // stack of dead indices (stored after 'data')
+		u16 freeCount = 0;         // number of dead indices
+		u16 type = 0;              // object type
+		u16 bottom = 0;            // lowest 'alive' index
+		u16 top = 0;               // highest 'alive' index
+		bool dirty = false;        // bottom & top need recomputing (deferred destroys)
 
 		// Objects
 		Object new_object( const bool defaultConstructor );
-		bool delete_object( const u16 index, const u16 generation );
+		bool delete_object( const u16 index, const u16 generation, const bool updateBounds = true );
 		byte *get_object( const u16 index, const u16 generation ) const;
+		void update_bounds();
 
 		// Memory
 		bool init( const u16 type );
@@ -120,9 +182,20 @@ public:
 		inline void find_next() { find_object( index + 1 ); }
 	};
 
+	struct ObjectCommand
+	{
+		u16 command;   // ObjectCommandType (objects.cpp)
+		u16 type;      // object type
+		Object object; // object to destroy
+		u32 size;      // payload size (manual constructor: prototype instance & HOT record)
+	};
+
 	ObjectBucket *buckets = nullptr;    // ObjectBucket array (dynamic)
+	Buffer commands;                    // deferred create/destroy commands (ObjectCommand + payload)
+	u32 commandCount = 0;               // number of deferred commands
+	bool deferred = false;              // record create/destroy calls rather than applying them
 public:
-	u16 bucketCache[OBJECT_TYPE_COUNT]; // most recent buckets touched by object create/destroy
+	u16 bucketAvailable[OBJECT_TYPE_COUNT]; // head of each type's list of ObjectBuckets with free slots
 	u16 capacity = 0;                   // number of allocated ObjectBucket slots
 	u16 current = 0;                    // current ObjectBucket insertion index
 
@@ -132,6 +205,7 @@ public:
 	u16 new_bucket( const u16 type );
 
 	friend Object; // so Object::handle() can access ObjectContext::object_pointer()
+	ObjectBucket *object_bucket( const Object &object ) const;
 	byte *object_pointer( const Object &object ) const;
 
 	Object create_default_constructor( const u16 type );
@@ -144,9 +218,10 @@ public:
 		return create_default_constructor( type );
 	}
 
-	template <int N, typename... Args> Object create( Args... args )
+	template <int N, typename... Args> Object create( const Args &... args )
 	{
 		// Create objects with manual constructor
+		// Arguments are forwarded by reference so that HOT field accessors (non-copyable) convert in place
 		iObjects::object_constructor<N, Args...>::construct( args... );
 		return create_manual_constructor( N );
 	}
@@ -155,8 +230,23 @@ public:
 	void destroy_all();
 	void destroy_all_type( const u16 type );
 
+	// Snapshots: binary copy of every ObjectBucket's memory (instances & HOT field arrays), for quicksaves & rollback
+	// Object ids stay valid across snapshot() & restore(). Objects should store other objects as Object ids rather
+	// than pointers, and use EVENT_SAVE/EVENT_LOAD to patch or rebuild transient state. EVENT_SAVE receives the
+	// object's copy within the snapshot, and EVENT_LOAD runs once the entire context is restored (no create or
+	// destroy events run during restore). Snapshots are only compatible with identical object layouts & VERSIONs.
+	bool snapshot( Buffer &buffer );
+	bool restore( Buffer &buffer );
+
 	inline bool exists( const Object &object ) const { return object_pointer( object ) != nullptr; }
 
+	// Deferred mode: create() & destroy() are recorded and applied in bulk by defer_end(), so event passes never
+	// mutate the buckets they iterate. While deferred, create() returns NULL_OBJECT and destroyed objects keep
+	// existing until defer_end(). destroy_all() & destroy_all_type() always apply immediately.
+	void defer_begin();
+	void defer_end();
+	inline bool is_deferred() const { return deferred; }
+
 	inline u32 count( const u16 type ) { Assert( type > 0 && type < OBJECT_TYPE_COUNT ); return objectCountType[type]; }
 	inline u32 count_all() const { return objectCountTotal; }
 
@@ -176,6 +266,30 @@ public:
 	template <int N> ObjectIterator<N> objects( const bool includeChildren = false ) { Assert( buckets != nullptr ); return { *this, N, includeChildren }; }
 	template <int N> ObjectHandle<N> handle( const Object &object ) const { return { object_pointer( object ) }; }
 
+	u16 fields_bucket( const u16 type, u16 bucketID ) const;
+
+	template <int N> struct ObjectFieldsIterator
+	{
+		ObjectContext &context;
+		u16 bucketID;
+		ObjectFieldsIterator( ObjectContext &context, const u16 bucketID ) :
+			context { context }, bucketID { context.fields_bucket( N, bucketID ) } { }
+
+		ObjectFieldsIterator<N> begin() { return { context, N }; }
+		ObjectFieldsIterator<N> end() { return { context, 0 }; }
+
+		bool operator!=( const ObjectFieldsIterator<N> &other ) const { return bucketID != other.bucketID; }
+		ObjectFieldsIterator<N> &operator++() { bucketID = context.fields_bucket( N, context.buckets[bucketID].bucketIDNext ); return *this; }
+		ObjectFields<N> operator*() const
+		{
+			const ObjectBucket &bucket = context.buckets[bucketID];
+			const u16 capacity = iObjects::OBJECT_TYPE_BUCKET_CAPACITY[N];
+			return { bucket.data + capacity * iObjects::OBJECT_TYPE_SIZE[N], capacity, bucket.bottom, bucket.top };
+		}
+	};
+
+	template <int N> ObjectFieldsIterator<N> fields() { Assert( buckets != nullptr ); return { *this, N }; }
+
 public:
 	void event_create();
 	void event_destroy();
@@ -210,3 +324,24 @@ public:
 	// Loop over all instances of a specified object type and derived child types
 	#define foreach_object_polymorphic( objectContext, objectType, handle ) \
 		for( ObjectHandle<objectType> handle : objectContext.objects<objectType>( true ) )
+
+	// Loop over the HOT field arrays of every ObjectBucket of a specified object type
+	// Indices [fields.bottom, fields.top) may include dead slots, so loops should be free of side effects
+	#define foreach_object_fields( objectContext, objectType, arrays ) \
+		for( ObjectFields<objectType> arrays : objectContext.fields<objectType>() )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+inline byte *iObjects::object_hot_field( const void *field, const HotFieldInfo &info )
+{
+	const byte *const objectPtr = reinterpret_cast<const byte *>( field ) - info.objectOffset;
+	const Object &id = reinterpret_cast<const iObjects::OBJECT_BASE_t *>( objectPtr )->id;
+
+	// Constructors run on prototype instances outside of any bucket
+	if( !id.alive ) { return object_hot_prototype( objectPtr, info.recordOffset ); }
+
+	const usize capacity = iObjects::OBJECT_TYPE_BUCKET_CAPACITY[id.type];
+	const usize size = iObjects::OBJECT_TYPE_SIZE[id.type];
+	byte *const data = const_cast<byte *>( objectPtr ) - id.index * size;
+	return data + capacity * ( size + info.recordOffset ) + id.index * info.size;
+}
@@ -0,0 +1,450 @@
+#include <manta/partition.hpp>
+
+#include <manta/memory.hpp>
+#include <manta/math.hpp>
+
+#include <vendor/vendor.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static inline float partition_min( const float a, const float b ) { return a < b ? a : b; }
+static inline float partition_max( const float a, const float b ) { return a > b ? a : b; }
+static inline int partition_clamp( const int v, const int min, const int max ) { return v < min ? min : ( v > max ? max : v ); }
+
+
+static bool region_overlaps( const iPartition::Region &region, const PartitionProxy &proxy )
+{
+	const float p[3] = { proxy.x, proxy.y, proxy.z };
+	float distanceSqr = 0.0f;
+
+	if( region.radius >= 0.0f )
+	{
+		// Sphere vs. sphere
+		for( int i = 0; i < 3; i++ ) { const float d = p[i] - region.center[i]; distanceSqr += d * d; }
+		const float r = region.radius + proxy.radius;
+		return distanceSqr <= r * r;
+	}
+
+	// Box vs. sphere
+	for( int i = 0; i < 3; i++ )
+	{
+		const float d = p[i] - partition_max( region.min[i], partition_min( p[i], region.max[i] ) );
+		distanceSqr += d * d;
+	}
+	return distanceSqr <= proxy.radius * proxy.radius;
+}
+
+
+static iPartition::Region region_sphere( const float x, const float y, const float z, const float radius )
+{
+	iPartition::Region region;
+	region.center[0] = x; region.center[1] = y; region.center[2] = z;
+	region.min[0] = x - radius; region.min[1] = y - radius; region.min[2] = z - radius;
+	region.max[0] = x + radius; region.max[1] = y + radius; region.max[2] = z + radius;
+	region.radius = radius;
+	return region;
+}
+
+
+static iPartition::Region region_box( const float x1, const float y1, const float z1,
+                                      const float x2, const float y2, const float z2 )
+{
+	iPartition::Region region;
+	region.min[0] = partition_min( x1, x2 ); region.min[1] = partition_min( y1, y2 ); region.min[2] = partition_min( z1, z2 );
+	region.max[0] = partition_max( x1, x2 ); region.max[1] = partition_max( y1, y2 ); region.max[2] = partition_max( z1, z2 );
+	for( int i = 0; i < 3; i++ ) { region.center[i] = ( region.min[i] + region.max[i] ) * 0.5f; }
+	region.radius = -1.0f;
+	return region;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace iPartition
+{
+	bool Partition::init_partition( const u32 cellCount, const u32 reserve )
+	{
+		Assert( proxies == nullptr && cells == nullptr );
+
+		// Proxies
+		proxyCapacity = reserve == 0 ? 1 : reserve;
+		proxies = reinterpret_cast<PartitionProxy *>( memory_alloc( proxyCapacity * sizeof( PartitionProxy ) ) );
+		ErrorReturnIf( proxies == nullptr, false, "Partition: failed to allocate proxies (%u)", proxyCapacity );
+
+		// Cells
+		this->cellCount = cellCount;
+		cells = reinterpret_cast<u32 *>( memory_alloc( cellCount * sizeof( u32 ) ) );
+		ErrorReturnIf( cells == nullptr, false, "Partition: failed to allocate cells (%u)", cellCount );
+
+		clear();
+
+		// Success
+		return true;
+	}
+
+
+	void Partition::free_partition()
+	{
+		if( proxies != nullptr ) { memory_free( proxies ); proxies = nullptr; }
+		if( cells != nullptr ) { memory_free( cells ); cells = nullptr; }
+		proxyCapacity = 0;
+		proxyCurrent = 0;
+		cellCount = 0;
+	}
+
+
+	u32 Partition::update_proxy( u32 proxy, const Object &object, const float x, const float y, const float z,
+	                             const float radius, const u32 cell )
+	{
+		Assert( cell < cellCount );
+
+		// Acquire a proxy if the object's index is unset or stale
+		if( proxy >= proxyCurrent || proxies[proxy].cell == PARTITION_NULL || !( proxies[proxy].object == object ) )
+		{
+			if( proxyFree != PARTITION_NULL )
+			{
+				proxy = proxyFree;
+				proxyFree = proxies[proxy].next;
+			}
+			else
+			{
+				if( UNLIKELY( proxyCurrent == proxyCapacity ) )
+				{
+					proxyCapacity *= 2;
+					proxies = reinterpret_cast<PartitionProxy *>(
+						memory_realloc( proxies, proxyCapacity * sizeof( PartitionProxy ) ) );
+					ErrorIf( proxies == nullptr, "Partition: failed to grow proxies (%u)", proxyCapacity );
+				}
+				proxy = proxyCurrent++;
+			}
+
+			proxies[proxy].object = object;
+			proxies[proxy].cell = PARTITION_NULL;
+		}
+
+		PartitionProxy &p = proxies[proxy];
+		p.x = x;
+		p.y = y;
+		p.z = z;
+		p.radius = radius;
+		p.pass = pass;
+
+		// Relink only when the proxy changes cells
+		if( p.cell != cell )
+		{
+			if( p.cell != PARTITION_NULL ) { unlink( proxy ); }
+			link( proxy, cell );
+		}
+
+		return proxy;
+	}
+
+
+	void Partition::link( const u32 proxy, const u32 cell )
+	{
+		PartitionProxy &p = proxies[proxy];
+		p.cell = cell;
+		p.prev = PARTITION_NULL;
+		p.next = cells[cell];
+		if( p.next != PARTITION_NULL ) { proxies[p.next].prev = proxy; }
+		cells[cell] = proxy;
+	}
+
+
+	void Partition::unlink( const u32 proxy )
+	{
+		PartitionProxy &p = proxies[proxy];
+		if( p.prev != PARTITION_NULL ) { proxies[p.prev].next = p.next; } else { cells[p.cell] = p.next; }
+		if( p.next != PARTITION_NULL ) { proxies[p.next].prev = p.prev; }
+		p.cell = PARTITION_NULL;
+	}
+
+
+	u32 Partition::gather( const u32 cell, const Region &region, const u16 type,
+	                       Object *results, const u32 capacity, u32 count ) const
+	{
+		for( u32 proxy = cells[cell]; proxy != PARTITION_NULL && count < capacity; proxy = proxies[proxy].next )
+		{
+			const PartitionProxy &p = proxies[proxy];
+			if( type != 0 && p.object.type != type ) { continue; }
+			if( !region_overlaps( region, p ) ) { continue; }
+			results[count++] = p.object;
+		}
+
+		return count;
+	}
+
+
+	void Partition::begin()
+	{
+		pass++;
+	}
+
+
+	void Partition::end()
+	{
+		// Release proxies that were not updated this pass
+		for( u32 proxy = 0; proxy < proxyCurrent; proxy++ )
+		{
+			if( proxies[proxy].cell == PARTITION_NULL || proxies[proxy].pass == pass ) { continue; }
+			remove( proxy );
+		}
+	}
+
+
+	void Partition::clear()
+	{
+		for( u32 i = 0; i < cellCount; i++ ) { cells[i] = PARTITION_NULL; }
+		proxyCurrent = 0;
+		proxyFree = PARTITION_NULL;
+	}
+
+
+	void Partition::remove( const u32 proxy )
+	{
+		if( proxy >= proxyCurrent || proxies[proxy].cell == PARTITION_NULL ) { return; }
+		unlink( proxy );
+		proxies[proxy].object = Object { };
+		proxies[proxy].next = proxyFree;
+		proxyFree = proxy;
+	}
+
+
+	u32 Partition::count() const
+	{
+		u32 count = 0;
+		for( u32 proxy = 0; proxy < proxyCurrent; proxy++ ) { count += proxies[proxy].cell != PARTITION_NULL; }
+		return count;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool PartitionGrid::init( const float cellSize, const u32 buckets, const u32 reserve )
+{
+	ErrorReturnIf( cellSize <= 0.0f, false, "PartitionGrid: cell size must be positive (%f)", cellSize );
+	this->cellSize = cellSize;
+	cellSizeInv = 1.0f / cellSize;
+	radiusMax = 0.0f;
+	radiusPass = 0.0f;
+
+	// Success
+	return init_partition( static_cast<u32>( align_pow2( buckets == 0 ? 1 : buckets ) ), reserve );
+}
+
+
+void PartitionGrid::free()
+{
+	free_partition();
+}
+
+
+void PartitionGrid::begin()
+{
+	Partition::begin();
+	radiusPass = 0.0f;
+}
+
+
+void PartitionGrid::end()
+{
+	Partition::end();
+
+	// Shrink the query expansion to the proxies that survived this pass
+	radiusMax = radiusPass;
+}
+
+
+u32 PartitionGrid::bucket( const int cx, const int cy, const int cz ) const
+{
+	const u32 h = ( static_cast<u32>( cx ) * 73856093u ) ^
+	              ( static_cast<u32>( cy ) * 19349663u ) ^
+	              ( static_cast<u32>( cz ) * 83492791u );
+	return h & ( cellCount - 1 );
+}
+
+
+u32 PartitionGrid::update( const u32 proxy, const Object &object, const float x, const float y, const float radius )
+{
+	return update( proxy, object, x, y, 0.0f, radius );
+}
+
+
+u32 PartitionGrid::update( const u32 proxy, const Object &object, const float x, const float y, const float z,
+                           const float radius )
+{
+	radiusMax = partition_max( radiusMax, radius );
+	radiusPass = partition_max( radiusPass, radius );
+	const u32 cell = bucket( fast_floor( x * cellSizeInv ), fast_floor( y * cellSizeInv ), fast_floor( z * cellSizeInv ) );
+	return update_proxy( proxy, object, x, y, z, radius, cell );
+}
+
+
+u32 PartitionGrid::query( const iPartition::Region &region, const bool planar, Object *results, const u32 capacity,
+                          const u16 type ) const
+{
+	// Proxies are bucketed by center, so expand the search by the largest proxy radius
+	// 2D proxies all sit at z = 0, so planar queries only visit that slice
+	int cmin[3];
+	int cmax[3];
+	u64 cellsSpanned = 1;
+	for( int i = 0; i < 3; i++ )
+	{
+		if( planar && i == 2 ) { cmin[i] = 0; cmax[i] = 0; continue; }
+		cmin[i] = fast_floor( ( region.min[i] - radiusMax ) * cellSizeInv );
+		cmax[i] = fast_floor( ( region.max[i] + radiusMax ) * cellSizeInv );
+		cellsSpanned *= static_cast<u64>( cmax[i] - cmin[i] + 1 );
+	}
+
+	u32 count = 0;
+
+	// Large queries: scan every bucket once
+	if( cellsSpanned >= cellCount )
+	{
+		for( u32 cell = 0; cell < cellCount && count < capacity; cell++ )
+		{
+			count = gather( cell, region, type, results, capacity, count );
+		}
+		return count;
+	}
+
+	// Several cells can share a bucket, so only accept proxies whose own cell is the one being visited
+	for( int cz = cmin[2]; cz <= cmax[2]; cz++ )
+	for( int cy = cmin[1]; cy <= cmax[1]; cy++ )
+	for( int cx = cmin[0]; cx <= cmax[0]; cx++ )
+	{
+		for( u32 proxy = cells[bucket( cx, cy, cz )]; proxy != PARTITION_NULL; proxy = proxies[proxy].next )
+		{
+			const PartitionProxy &p = proxies[proxy];
+			if( type != 0 && p.object.type != type ) { continue; }
+			if( fast_floor( p.x * cellSizeInv ) != cx ||
+			    fast_floor( p.y * cellSizeInv ) != cy ||
+			    fast_floor( p.z * cellSizeInv ) != cz ) { continue; }
+			if( !region_overlaps( region, p ) ) { continue; }
+
+			results[count++] = p.object;
+			if( count == capacity ) { return count; }
+		}
+	}
+
+	return count;
+}
+
+
+u32 PartitionGrid::query_radius( const float x, const float y, const float radius,
+                                 Object *results, const u32 capacity, const u16 type ) const
+{
+	return query( region_sphere( x, y, 0.0f, radius ), true, results, capacity, type );
+}
+
+
+u32 PartitionGrid::query_radius( const float x, const float y, const float z, const float radius,
+                                 Object *results, const u32 capacity, const u16 type ) const
+{
+	return query( region_sphere( x, y, z, radius ), false, results, capacity, type );
+}
+
+
+u32 PartitionGrid::query_aabb( const float x1, const float y1, const float x2, const float y2,
+                               Object *results, const u32 capacity, const u16 type ) const
+{
+	return query( region_box( x1, y1, 0.0f, x2, y2, 0.0f ), true, results, capacity, type );
+}
+
+
+u32 PartitionGrid::query_aabb( const float x1, const float y1, const float z1, const float x2, const float y2,
+                               const float z2, Object *results, const u32 capacity, const u16 type ) const
+{
+	return query( region_box( x1, y1, z1, x2, y2, z2 ), false, results, capacity, type );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool PartitionQuadTree::init( const float x1, const float y1, const float x2, const float y2, const u32 depth,
+                              const u32 reserve )
+{
+	ErrorReturnIf( depth == 0 || depth > PARTITION_QUADTREE_DEPTH_MAX, false,
+	               "PartitionQuadTree: depth must be within 1 and %d (%u)", PARTITION_QUADTREE_DEPTH_MAX, depth );
+
+	originX = partition_min( x1, x2 );
+	originY = partition_min( y1, y2 );
+	size = partition_max( partition_max( x1, x2 ) - originX, partition_max( y1, y2 ) - originY );
+	ErrorReturnIf( size <= 0.0f, false, "PartitionQuadTree: bounds must not be empty" );
+	this->depth = depth;
+
+	// Level L is a ( 2^L x 2^L ) grid
+	u32 cellTotal = 0;
+	for( u32 level = 0; level < depth; level++ )
+	{
+		levelOffset[level] = cellTotal;
+		cellTotal += 1u << ( level * 2 );
+	}
+
+	// Success
+	return init_partition( cellTotal, reserve );
+}
+
+
+void PartitionQuadTree::free()
+{
+	free_partition();
+}
+
+
+u32 PartitionQuadTree::update( const u32 proxy, const Object &object, const float x, const float y,
+                               const float radius )
+{
+	// Deepest level that loosely fits the proxy
+	u32 level = depth - 1;
+	while( level > 0 && radius > size / static_cast<float>( 1u << level ) * 0.5f ) { level--; }
+
+	const int n = 1 << level;
+	const float scale = static_cast<float>( n ) / size;
+	const int cx = partition_clamp( fast_floor( ( x - originX ) * scale ), 0, n - 1 );
+	const int cy = partition_clamp( fast_floor( ( y - originY ) * scale ), 0, n - 1 );
+
+	return update_proxy( proxy, object, x, y, 0.0f, radius, levelOffset[level] + static_cast<u32>( cy * n + cx ) );
+}
+
+
+u32 PartitionQuadTree::query( const iPartition::Region &region, Object *results, const u32 capacity,
+                              const u16 type ) const
+{
+	u32 count = 0;
+
+	for( u32 level = 0; level < depth && count < capacity; level++ )
+	{
+		// A cell's loose bounds extend half a cell beyond its edges
+		const int n = 1 << level;
+		const float scale = static_cast<float>( n ) / size;
+		const float loose = size / static_cast<float>( n ) * 0.5f;
+
+		const int x1 = partition_clamp( fast_floor( ( region.min[0] - loose - originX ) * scale ), 0, n - 1 );
+		const int y1 = partition_clamp( fast_floor( ( region.min[1] - loose - originY ) * scale ), 0, n - 1 );
+		const int x2 = partition_clamp( fast_floor( ( region.max[0] + loose - originX ) * scale ), 0, n - 1 );
+		const int y2 = partition_clamp( fast_floor( ( region.max[1] + loose - originY ) * scale ), 0, n - 1 );
+
+		for( int cy = y1; cy <= y2; cy++ )
+		for( int cx = x1; cx <= x2; cx++ )
+		{
+			count = gather( levelOffset[level] + static_cast<u32>( cy * n + cx ), region, type, results, capacity, count );
+		}
+	}
+
+	return count;
+}
+
+
+u32 PartitionQuadTree::query_radius( const float x, const float y, const float radius,
+                                     Object *results, const u32 capacity, const u16 type ) const
+{
+	return query( region_sphere( x, y, 0.0f, radius ), results, capacity, type );
+}
+
+
+u32 PartitionQuadTree::query_aabb( const float x1, const float y1, const float x2, const float y2,
+                                   Object *results, const u32 capacity, const u16 type ) const
+{
+	return query( region_box( x1, y1, 0.0f, x2, y2, 0.0f ), results, capacity, type );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
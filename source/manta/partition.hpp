@@ -0,0 +1,145 @@
+#pragma once
+
+#include <types.hpp>
+#include <debug.hpp>
+
+#include <manta/objects.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define PARTITION_NULL ( U32_MAX )
+#define PARTITION_QUADTREE_DEPTH_MAX ( 10 )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Spatial partitions for broadphase object queries
+//
+// Objects keep a proxy index (initialized to PARTITION_NULL) and register themselves in EVENT_PARTITION, where
+// 'ptr' is the partition passed to ObjectContext::event_partition():
+//
+//     EVENT_PARTITION { proxy = reinterpret_cast<PartitionGrid *>( ptr )->update( proxy, id, x, y, radius ); }
+//
+// Each pass is bracketed by begin() & end(). Proxies are only relinked when they move between cells, and proxies
+// not updated during a pass (destroyed objects) are released in end(). Queries return the objects whose bounding
+// circle/sphere overlaps the query region.
+
+struct PartitionProxy
+{
+	Object object;
+	float x, y, z;
+	float radius;
+	u32 cell; // PARTITION_NULL: released
+	u32 next; // next proxy in cell (or free list)
+	u32 prev; // previous proxy in cell
+	u32 pass; // last pass that updated this proxy
+};
+
+
+namespace iPartition
+{
+	struct Region
+	{
+		float min[3];
+		float max[3];
+		float center[3];
+		float radius; // < 0.0f: axis-aligned box
+	};
+
+	struct Partition
+	{
+		PartitionProxy *proxies = nullptr;
+		u32 proxyCapacity = 0;
+		u32 proxyCurrent = 0;             // high-water mark
+		u32 proxyFree = PARTITION_NULL;   // free list head
+		u32 *cells = nullptr;             // head proxy of each cell
+		u32 cellCount = 0;
+		u32 pass = 0;
+
+		bool init_partition( const u32 cellCount, const u32 reserve );
+		void free_partition();
+
+		u32 update_proxy( u32 proxy, const Object &object, const float x, const float y, const float z,
+		                  const float radius, const u32 cell );
+		void link( const u32 proxy, const u32 cell );
+		void unlink( const u32 proxy );
+
+		u32 gather( const u32 cell, const Region &region, const u16 type,
+		            Object *results, const u32 capacity, u32 count ) const;
+
+		void begin();
+		void end();
+		void clear();
+		void remove( const u32 proxy );
+
+		u32 count() const;
+	};
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Uniform hash grid: infinite grid of 'cellSize' cells hashed into a fixed bucket table
+// The 3D overloads make this a hashed voxel grid (2D & 3D proxies should not be mixed in a single grid)
+
+struct PartitionGrid : public iPartition::Partition
+{
+	bool init( const float cellSize, const u32 buckets = 4096, const u32 reserve = 1024 );
+	void free();
+
+	void begin();
+	void end();
+
+	u32 update( const u32 proxy, const Object &object, const float x, const float y, const float radius );
+	u32 update( const u32 proxy, const Object &object, const float x, const float y, const float z, const float radius );
+
+	// Returns the number of objects written to 'results' (at most 'capacity'); type 0 matches all object types
+	u32 query_radius( const float x, const float y, const float radius,
+	                  Object *results, const u32 capacity, const u16 type = 0 ) const;
+	u32 query_radius( const float x, const float y, const float z, const float radius,
+	                  Object *results, const u32 capacity, const u16 type = 0 ) const;
+	u32 query_aabb( const float x1, const float y1, const float x2, const float y2,
+	                Object *results, const u32 capacity, const u16 type = 0 ) const;
+	u32 query_aabb( const float x1, const float y1, const float z1, const float x2, const float y2, const float z2,
+	                Object *results, const u32 capacity, const u16 type = 0 ) const;
+
+private:
+	u32 bucket( const int cx, const int cy, const int cz ) const;
+	u32 query( const iPartition::Region &region, const bool planar, Object *results, const u32 capacity,
+	           const u16 type ) const;
+
+	float cellSize = 0.0f;
+	float cellSizeInv = 0.0f;
+	float radiusMax = 0.0f;  // largest proxy radius (queries are expanded by this)
+	float radiusPass = 0.0f; // largest proxy radius updated this pass (becomes radiusMax in end())
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Loose quadtree: stored as a pyramid of grids over [x1, x2] x [y1, y2]
+// Proxies live in the deepest level whose cells are at least twice their radius, and each cell's loose bounds
+// extend half a cell beyond its edges. Proxies outside the bounds are clamped into the border cells.
+
+struct PartitionQuadTree : public iPartition::Partition
+{
+	bool init( const float x1, const float y1, const float x2, const float y2, const u32 depth = 6,
+	           const u32 reserve = 1024 );
+	void free();
+
+	u32 update( const u32 proxy, const Object &object, const float x, const float y, const float radius );
+
+	// Returns the number of objects written to 'results' (at most 'capacity'); type 0 matches all object types
+	u32 query_radius( const float x, const float y, const float radius,
+	                  Object *results, const u32 capacity, const u16 type = 0 ) const;
+	u32 query_aabb( const float x1, const float y1, const float x2, const float y2,
+	                Object *results, const u32 capacity, const u16 type = 0 ) const;
+
+private:
+	u32 query( const iPartition::Region &region, Object *results, const u32 capacity, const u16 type ) const;
+
+	float originX = 0.0f;
+	float originY = 0.0f;
+	float size = 0.0f;
+	u32 depth = 0;
+	u32 levelOffset[PARTITION_QUADTREE_DEPTH_MAX];
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
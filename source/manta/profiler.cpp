@@ -0,0 +1,320 @@
+#include <manta/profiler.hpp>
+
+#if PROFILING
+#include <manta/memory.hpp>
+#include <manta/buffer.hpp>
+#include <manta/thread.hpp>
+#include <manta/time.hpp>
+#include <manta/draw.hpp>
+#include <manta/color.hpp>
+
+#include <vendor/stdio.hpp>
+#include <vendor/string.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static_assert( ( PROFILING_ZONES_PER_THREAD & ( PROFILING_ZONES_PER_THREAD - 1 ) ) == 0,
+	"PROFILING_ZONES_PER_THREAD must be a power of 2" );
+
+#define PROFILING_ZONES_MASK ( PROFILING_ZONES_PER_THREAD - 1 )
+#define PROFILING_DEPTH_MAX ( 64 )
+#define PROFILING_OVERLAY_TOP ( 8 )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Single-producer (owning thread) / single-consumer (Profiler::collect) ring of completed zones
+
+struct ProfileThread
+{
+	ProfileZone zones[PROFILING_ZONES_PER_THREAD];
+	volatile i64 head; // next zone written by the owning thread
+	volatile i64 tail; // next zone read by Profiler::collect()
+
+	const char *stackName[PROFILING_DEPTH_MAX];
+	double stackStart[PROFILING_DEPTH_MAX];
+	u16 depth;
+	u16 index;
+};
+
+
+static ProfileThread *volatile threads[PROFILING_THREADS_MAX];
+static volatile i32 threadCount = 0;
+static thread_local ProfileThread *threadLocal = nullptr;
+static thread_local bool threadDisabled = false;
+
+static Buffer frame;       // ProfileZone array (most recently collected frame)
+static Buffer trace;       // ProfileZone array (Chrome trace capture)
+static bool traceActive = false;
+static double frameStart = 0.0;
+static double frameEnd = 0.0;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static ProfileThread *profile_thread()
+{
+	if( LIKELY( threadLocal != nullptr ) ) { return threadLocal; }
+	if( threadDisabled ) { return nullptr; }
+
+	// Register
+	const i32 index = atomic_add( &threadCount, 1 );
+	if( index >= PROFILING_THREADS_MAX ) { threadDisabled = true; return nullptr; }
+
+	ProfileThread *thread = reinterpret_cast<ProfileThread *>( memory_alloc( sizeof( ProfileThread ) ) );
+	memory_set( thread, 0, sizeof( ProfileThread ) );
+	thread->index = static_cast<u16>( index );
+	threads[index] = thread;
+
+	threadLocal = thread;
+	return thread;
+}
+
+
+void iProfiler::zone_begin( const char *name )
+{
+	ProfileThread *thread = profile_thread();
+	if( thread == nullptr ) { return; }
+
+	if( thread->depth < PROFILING_DEPTH_MAX )
+	{
+		thread->stackName[thread->depth] = name;
+		thread->stackStart[thread->depth] = Time::value();
+	}
+	thread->depth++;
+}
+
+
+void iProfiler::zone_end()
+{
+	ProfileThread *thread = threadLocal;
+	if( thread == nullptr ) { return; }
+	Assert( thread->depth > 0 );
+
+	thread->depth--;
+	if( thread->depth >= PROFILING_DEPTH_MAX ) { return; }
+
+	// Full? (drop rather than overwrite zones the consumer may be reading)
+	const i64 head = thread->head;
+	if( head - atomic_load( &thread->tail ) >= PROFILING_ZONES_PER_THREAD ) { return; }
+
+	ProfileZone &zone = thread->zones[head & PROFILING_ZONES_MASK];
+	zone.name = thread->stackName[thread->depth];
+	zone.start = thread->stackStart[thread->depth];
+	zone.end = Time::value();
+	zone.depth = thread->depth;
+	zone.thread = thread->index;
+	atomic_store( &thread->head, head + 1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Profiler::collect()
+{
+	if( frame.data == nullptr ) { frame.init( PROFILING_ZONES_PER_THREAD * sizeof( ProfileZone ), true ); }
+	frame.clear();
+
+	frameStart = frameEnd;
+	frameEnd = Time::value();
+
+	const i32 count = atomic_load( &threadCount );
+	for( i32 i = 0; i < count && i < PROFILING_THREADS_MAX; i++ )
+	{
+		ProfileThread *thread = threads[i];
+		if( thread == nullptr ) { continue; } // registering
+
+		const i64 head = atomic_load( &thread->head );
+		for( i64 tail = thread->tail; tail < head; tail++ )
+		{
+			const ProfileZone &zone = thread->zones[tail & PROFILING_ZONES_MASK];
+			frame.write( zone );
+			if( traceActive ) { trace.write( zone ); }
+		}
+		atomic_store( &thread->tail, head );
+	}
+}
+
+
+const ProfileZone *Profiler::zones( u32 &count )
+{
+	count = static_cast<u32>( frame.current / sizeof( ProfileZone ) );
+	return reinterpret_cast<const ProfileZone *>( frame.data );
+}
+
+
+double Profiler::frame_start()
+{
+	return frameStart;
+}
+
+
+double Profiler::frame_end()
+{
+	return frameEnd;
+}
+
+
+void Profiler::trace_begin()
+{
+	if( trace.data == nullptr ) { trace.init( 1024 * 1024, true ); }
+	trace.clear();
+	traceActive = true;
+}
+
+
+static void trace_write_text( Buffer &output, const char *text )
+{
+	output.write( text, strlen( text ) );
+}
+
+
+static void trace_write_string( Buffer &output, const char *string )
+{
+	output.write( '"' );
+	for( const char *c = string; *c != '\0'; c++ )
+	{
+		if( *c == '"' || *c == '\\' ) { output.write( '\\' ); }
+		output.write( *c );
+	}
+	output.write( '"' );
+}
+
+
+bool Profiler::trace_end( const char *path )
+{
+	ErrorReturnIf( !traceActive, false, "Profiler: trace_end() without trace_begin()" );
+	traceActive = false;
+
+	Buffer output;
+	output.init( trace.current * 2 + 1024, true );
+	char text[256];
+
+	// Threads
+	trace_write_text( output, "{\"traceEvents\":[\n" );
+	const i32 count = atomic_load( &threadCount );
+	for( i32 i = 0; i < count && i < PROFILING_THREADS_MAX; i++ )
+	{
+		const int length = snprintf( text, sizeof( text ), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+			"\"args\":{\"name\":\"%s %d\"}},\n", i, i == 0 ? "Main" : "Thread", i );
+		output.write( text, static_cast<usize>( length ) );
+	}
+
+	// Zones (complete events, microseconds)
+	const ProfileZone *zones = reinterpret_cast<const ProfileZone *>( trace.data );
+	const usize zoneCount = trace.current / sizeof( ProfileZone );
+	for( usize i = 0; i < zoneCount; i++ )
+	{
+		const ProfileZone &zone = zones[i];
+		trace_write_text( output, "{\"name\":" );
+		trace_write_string( output, zone.name );
+		const int length = snprintf( text, sizeof( text ), ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}%s\n",
+			zone.thread, zone.start * 1e+6, ( zone.end - zone.start ) * 1e+6, i + 1 < zoneCount ? "," : "" );
+		output.write( text, static_cast<usize>( length ) );
+	}
+	trace_write_text( output, "],\"displayTimeUnit\":\"ms\"}\n" );
+
+	const bool success = output.save( path );
+	output.free();
+	trace.clear();
+	ErrorReturnIf( !success, false, "Profiler: failed to write trace '%s'", path );
+
+	// Success
+	return true;
+}
+
+
+bool Profiler::tracing()
+{
+	return traceActive;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static Color zone_color( const char *name )
+{
+	// Stable color per zone name
+	u32 hash = 2166136261u;
+	for( const char *c = name; *c != '\0'; c++ ) { hash = ( hash ^ static_cast<u8>( *c ) ) * 16777619u; }
+	return color_hsv_to_rgb( ColorHSV( static_cast<u8>( hash ), 140, 200 ) );
+}
+
+
+void debug_overlay_profiler( const float x, const float y, const float width )
+{
+	u32 count;
+	const ProfileZone *zones = Profiler::zones( count );
+	const double duration = frameEnd - frameStart;
+	if( count == 0 || duration <= 0.0 ) { return; }
+
+	const float rowHeight = 16.0f;
+	const float scale = static_cast<float>( width / duration );
+	float drawY = y;
+
+	draw_text_f( fnt_consolas, 14, x, drawY, c_white, "CPU Frame: %.2f ms", duration * 1000.0 );
+	drawY += 20.0f;
+
+	// Flame graph (zones are grouped by thread)
+	for( u32 first = 0; first < count; )
+	{
+		const u16 thread = zones[first].thread;
+		u32 last = first;
+		u16 depthMax = 0;
+		for( ; last < count && zones[last].thread == thread; last++ ) { depthMax = zones[last].depth > depthMax ? zones[last].depth : depthMax; }
+
+		draw_rectangle( x, drawY, x + width, drawY + ( depthMax + 1 ) * rowHeight, Color( 0, 0, 0, 160 ) );
+		for( u32 i = first; i < last; i++ )
+		{
+			const ProfileZone &zone = zones[i];
+			float x1 = x + static_cast<float>( zone.start - frameStart ) * scale;
+			float x2 = x + static_cast<float>( zone.end - frameStart ) * scale;
+			x1 = x1 < x ? x : x1;
+			x2 = x2 > x + width ? x + width : x2;
+			if( x2 < x1 + 1.0f ) { x2 = x1 + 1.0f; }
+
+			const float y1 = drawY + zone.depth * rowHeight;
+			draw_rectangle( x1, y1, x2, y1 + rowHeight - 1.0f, zone_color( zone.name ) );
+			if( x2 - x1 > 48.0f && text_dimensions( fnt_consolas, 12, zone.name ).x < x2 - x1 - 4.0f )
+			{
+				draw_text( fnt_consolas, 12, x1 + 2.0f, y1 + 1.0f, c_black, zone.name );
+			}
+		}
+
+		drawY += ( depthMax + 1 ) * rowHeight + 4.0f;
+		first = last;
+	}
+
+	// Most expensive zones (inclusive time, summed across threads)
+	struct Total { const char *name; double time; u32 calls; };
+	Total totals[64];
+	u32 totalCount = 0;
+	for( u32 i = 0; i < count; i++ )
+	{
+		u32 j = 0;
+		for( ; j < totalCount; j++ ) { if( totals[j].name == zones[i].name || strcmp( totals[j].name, zones[i].name ) == 0 ) { break; } }
+		if( j == totalCount )
+		{
+			if( totalCount == ARRAY_LENGTH( totals ) ) { continue; }
+			totals[totalCount++] = { zones[i].name, 0.0, 0 };
+		}
+		totals[j].time += zones[i].end - zones[i].start;
+		totals[j].calls++;
+	}
+
+	drawY += 4.0f;
+	for( u32 rank = 0; rank < PROFILING_OVERLAY_TOP && rank < totalCount; rank++ )
+	{
+		// Selection sort (partial)
+		u32 best = rank;
+		for( u32 j = rank + 1; j < totalCount; j++ ) { if( totals[j].time > totals[best].time ) { best = j; } }
+		const Total swap = totals[rank];
+		totals[rank] = totals[best];
+		totals[best] = swap;
+
+		draw_rectangle( x, drawY + 2.0f, x + 10.0f, drawY + 12.0f, zone_color( totals[rank].name ) );
+		draw_text_f( fnt_consolas, 14, x + 16.0f, drawY, c_white, "%6.3f ms  %5ux  %s",
+			totals[rank].time * 1000.0, totals[rank].calls, totals[rank].name );
+		drawY += 18.0f;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif
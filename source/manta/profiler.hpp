@@ -0,0 +1,70 @@
+#pragma once
+
+#include <config.hpp>
+#include <types.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Hierarchical CPU profiler
+//
+// PROFILE_ZONE( "name" ) times the enclosing scope. Zone names must be string literals (or otherwise outlive the
+// profiler). Each thread records completed zones into its own lock-free ring buffer, which Profiler::collect()
+// drains once per frame on the main thread (zones are dropped if a ring fills between collections). Zones compile
+// out unless PROFILING is enabled (default: debug builds).
+
+struct ProfileZone
+{
+	const char *name;
+	double start; // Time::value()
+	double end;
+	u16 depth;    // nesting depth within its thread (0: outermost)
+	u16 thread;   // profiler thread index (registration order)
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if PROFILING
+	namespace iProfiler
+	{
+		extern void zone_begin( const char *name );
+		extern void zone_end();
+
+		struct ZoneScope
+		{
+			ZoneScope( const char *name ) { zone_begin( name ); }
+			~ZoneScope() { zone_end(); }
+		};
+	}
+
+	#define PROFILE_ZONE_NAME_CONCAT( a, b ) a##b
+	#define PROFILE_ZONE_NAME( line ) PROFILE_ZONE_NAME_CONCAT( profileZone, line )
+	#define PROFILE_ZONE( name ) iProfiler::ZoneScope PROFILE_ZONE_NAME( __LINE__ ) { name }
+#else
+	#define PROFILE_ZONE( name )
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if PROFILING
+	namespace Profiler
+	{
+		// Drains every thread's ring buffer: the zones completed since the previous call become the current frame
+		extern void collect();
+
+		// Zones of the most recently collected frame (grouped by thread)
+		extern const ProfileZone *zones( u32 &count );
+		extern double frame_start();
+		extern double frame_end();
+
+		// Chrome trace export: records every collected zone between trace_begin() and trace_end(), then writes
+		// them as Chrome trace event JSON (open with chrome://tracing or ui.perfetto.dev)
+		extern void trace_begin();
+		extern bool trace_end( const char *path );
+		extern bool tracing();
+	}
+
+	// Flame graph of the most recently collected frame (one band per thread) & the most expensive zones
+	extern void debug_overlay_profiler( const float x, const float y, const float width );
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -11,6 +11,40 @@ namespace iRandom
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#define PCG_MULTIPLIER ( 6364136223846793005ULL )
+
+
+static inline u32 pcg_output( const u64 state )
+{
+	const u32 xorshifted = static_cast<u32>( ( ( state >> 18 ) ^ state ) >> 27 );
+	const u32 rot = static_cast<u32>( state >> 59 );
+	return ( xorshifted >> rot ) | ( xorshifted << ( ( ~rot + 1 ) & 31 ) );
+}
+
+
+static inline void pcg_jump( const u64 increment, u64 delta, u64 &multiplier, u64 &plus )
+{
+	// Composes 'delta' LCG steps into one: state * multiplier + plus (Brown, "Random Number Generation with
+	// Arbitrary Strides", 1994) -- O(log delta)
+	u64 stepMultiplier = PCG_MULTIPLIER;
+	u64 stepPlus = increment;
+	multiplier = 1;
+	plus = 0;
+
+	while( delta > 0 )
+	{
+		if( delta & 1 )
+		{
+			multiplier *= stepMultiplier;
+			plus = plus * stepMultiplier + stepPlus;
+		}
+		stepPlus = ( stepMultiplier + 1 ) * stepPlus;
+		stepMultiplier *= stepMultiplier;
+		delta >>= 1;
+	}
+}
+
+
 void RandomContext::seed( const u64 seed )
 {
 	state = 0;
@@ -23,14 +57,80 @@ void RandomContext::seed( const u64 seed )
 
 u32 RandomContext::base()
 {
-    // Advance State
-	u64 oldstate = state;
-    state = oldstate * 6364136223846793005 + where;
-
-    // Calculate Output
-    u32 xorshifted = static_cast<u32>( ( ( oldstate >> 18 ) ^ oldstate ) >> 27 );
-    u32 rot = oldstate >> 59;
-    return ( xorshifted >> rot ) | ( xorshifted << ( ( ~rot + 1 ) & 31 ) );
+	// Advance State
+	const u64 oldstate = state;
+	state = oldstate * PCG_MULTIPLIER + where;
+
+	// Calculate Output
+	return pcg_output( oldstate );
+}
+
+
+void RandomContext::advance( const u64 delta )
+{
+	u64 multiplier, plus;
+	pcg_jump( where, delta, multiplier, plus );
+	state = state * multiplier + plus;
+}
+
+
+RandomContext RandomContext::split()
+{
+	const u64 high = base();
+	const u64 low = base();
+	return RandomContext { ( high << 32 ) | low };
+}
+
+
+void RandomContext::fill_u32( u32 *output, const usize count )
+{
+	// Lane k starts k steps ahead & every lane strides RANDOM_FILL_LANES steps: the lanes are independent
+	// dependency chains, so their multiplies overlap (SSE2 & NEON have no 64-bit multiply, so they stay scalar)
+	u64 multiplier, plus;
+	pcg_jump( where, RANDOM_FILL_LANES, multiplier, plus );
+
+	u64 lanes[RANDOM_FILL_LANES];
+	for( int lane = 0; lane < RANDOM_FILL_LANES; lane++ ) { lanes[lane] = state; state = state * PCG_MULTIPLIER + where; }
+
+	usize i = 0;
+	for( ; i + RANDOM_FILL_LANES <= count; i += RANDOM_FILL_LANES )
+	{
+		for( int lane = 0; lane < RANDOM_FILL_LANES; lane++ )
+		{
+			output[i + lane] = pcg_output( lanes[lane] );
+			lanes[lane] = lanes[lane] * multiplier + plus;
+		}
+	}
+
+	// Remainder (lane 0 holds the state for output 'i')
+	state = lanes[0];
+	for( ; i < count; i++ ) { output[i] = base(); }
+}
+
+
+void RandomContext::fill_float( float *output, const usize count, const float min, const float max )
+{
+	// See fill_u32()
+	u64 multiplier, plus;
+	pcg_jump( where, RANDOM_FILL_LANES, multiplier, plus );
+
+	u64 lanes[RANDOM_FILL_LANES];
+	for( int lane = 0; lane < RANDOM_FILL_LANES; lane++ ) { lanes[lane] = state; state = state * PCG_MULTIPLIER + where; }
+
+	usize i = 0;
+	const float range = max - min;
+	for( ; i + RANDOM_FILL_LANES <= count; i += RANDOM_FILL_LANES )
+	{
+		for( int lane = 0; lane < RANDOM_FILL_LANES; lane++ )
+		{
+			output[i + lane] = pcg_output( lanes[lane] ) * 0x1.0p-32f * range + min;
+			lanes[lane] = lanes[lane] * multiplier + plus;
+		}
+	}
+
+	// Remainder
+	state = lanes[0];
+	for( ; i < count; i++ ) { output[i] = random<float>( min, max ); }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -5,6 +5,11 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Interleaved PCG32 lanes (strided views of one stream) stepped together by fill_u32() / fill_float()
+#define RANDOM_FILL_LANES ( 4 )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 struct RandomContext
 {
 	RandomContext() { } // default
@@ -13,6 +18,18 @@ struct RandomContext
 	void seed( const u64 seed );
 	u32 base();
 
+	// Equivalent to calling base() 'delta' times, in O(log delta)
+	void advance( const u64 delta );
+
+	// Returns a context on its own stream, seeded from the next two outputs of this one -- deterministic, so jobs
+	// that split() from a shared context in a fixed order reproduce the same values regardless of thread timing
+	RandomContext split();
+
+	// Bulk generation: identical to 'count' calls of base() / random<float>( min, max ), but steps
+	// RANDOM_FILL_LANES interleaved streams at once (lane k produces outputs k, k + lanes, k + 2 * lanes, ...)
+	void fill_u32( u32 *output, const usize count );
+	void fill_float( float *output, const usize count, const float min, const float max );
+
 	u64 state = 0;
 	u64 where = 0;
 
@@ -48,6 +65,14 @@ namespace Random
 {
 	inline void seed( const u64 seed ) { iRandom::context.seed( seed ); }
 	inline u32 base() { return iRandom::context.base(); }
+	inline void advance( const u64 delta ) { iRandom::context.advance( delta ); }
+	inline RandomContext split() { return iRandom::context.split(); }
+
+	inline void fill_u32( u32 *output, const usize count ) { iRandom::context.fill_u32( output, count ); }
+	inline void fill_float( float *output, const usize count, const float min, const float max )
+	{
+		iRandom::context.fill_float( output, count, min, max );
+	}
 
 	inline RandomContext &context() { return iRandom::context; }
 }
@@ -0,0 +1,630 @@
+#include <manta/replication.hpp>
+
+#include <manta/memory.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define REPLICATION_TAG_STATE ( 0x5253 ) // "SR"
+#define REPLICATION_TAG_ACK ( 0x4152 )   // "RA"
+#define REPLICATION_BASELINE_NONE ( U32_MAX )
+
+// Packet: [ tag : 16 ][ sequence : 32 ][ baseline : 32 ] { [ more : 1 ][ op : 2 ][ key : 32 ][ op data ] } [ more = 0 : 1 ]
+//     Create:  [ generation : 16 ][ type : 15 ][ fields ]
+//     Update:  { [ dirty : 1 ][ field (if dirty) ] } for every field
+//     Destroy: -
+enum ReplicationOp
+{
+	ReplicationOp_Update,
+	ReplicationOp_Create,
+	ReplicationOp_Destroy,
+};
+
+#define REPLICATION_ENTRY_BITS ( 1 + 2 + 32 )
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct BitWriter
+{
+	BitWriter( byte *data, const usize capacity ) : data( data ), capacity( capacity ) { }
+
+	void write( const u32 value, const u32 count )
+	{
+		Assert( bits + count <= capacity * 8 );
+		for( u32 i = 0; i < count; i++, bits++ )
+		{
+			if( ( bits & 7 ) == 0 ) { data[bits >> 3] = 0; }
+			data[bits >> 3] |= static_cast<byte>( ( ( value >> i ) & 1 ) << ( bits & 7 ) );
+		}
+	}
+
+	void write_bytes( const byte *source, const usize size )
+	{
+		for( usize i = 0; i < size; i++ ) { write( source[i], 8 ); }
+	}
+
+	inline usize size() const { return ( bits + 7 ) >> 3; }
+
+	byte *data;
+	usize capacity;
+	usize bits = 0;
+};
+
+
+struct BitReader
+{
+	BitReader( const byte *data, const usize size ) : data( data ), size( size ) { }
+
+	u32 read( const u32 count )
+	{
+		if( bits + count > size * 8 ) { overflow = true; return 0; }
+		u32 value = 0;
+		for( u32 i = 0; i < count; i++, bits++ )
+		{
+			value |= static_cast<u32>( ( data[bits >> 3] >> ( bits & 7 ) ) & 1 ) << i;
+		}
+		return value;
+	}
+
+	const byte *data;
+	usize size;
+	usize bits = 0;
+	bool overflow = false;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static iReplication::Record record_at( const Buffer &records, const usize tell )
+{
+	// Records are packed (field data is unaligned)
+	iReplication::Record record;
+	memory_copy( &record, records.data + tell, sizeof( iReplication::Record ) );
+	return record;
+}
+
+
+static byte *field_pointer( byte *objectPtr, const u16 type, const iObjects::NetFieldInfo &field )
+{
+	if( field.hot == U16_MAX ) { return objectPtr + field.offset; }
+	const iObjects::HotFieldInfo &info = iObjects::OBJECT_TYPE_HOT_FIELDS[type][field.hot];
+	return iObjects::object_hot_field( objectPtr + info.objectOffset, info );
+}
+
+
+usize iReplication::record_size( const u16 type )
+{
+	usize size = sizeof( Record );
+	for( u16 i = 0; i < iObjects::OBJECT_TYPE_NET_FIELD_COUNT[type]; i++ ) { size += iObjects::OBJECT_TYPE_NET_FIELDS[type][i].size; }
+	return size;
+}
+
+
+void iReplication::History::init()
+{
+	for( State &state : states )
+	{
+		state.records.init( 1024, true );
+		state.sequence = 0;
+	}
+}
+
+
+void iReplication::History::free()
+{
+	for( State &state : states ) { state.records.free(); }
+}
+
+
+iReplication::State &iReplication::History::insert( const u32 sequence )
+{
+	State &state = states[sequence % REPLICATION_HISTORY];
+	state.records.clear();
+	state.sequence = sequence;
+	return state;
+}
+
+
+iReplication::State *iReplication::History::find( const u32 sequence )
+{
+	State &state = states[sequence % REPLICATION_HISTORY];
+	return ( sequence != 0 && state.sequence == sequence ) ? &state : nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ReplicationServer::init( ObjectContext &context, NetSocket &socket )
+{
+	Assert( context.buckets != nullptr );
+	Assert( socket.handle >= 0 );
+	this->context = &context;
+	this->socket = &socket;
+	state.init( 4096, true );
+	sequence = 0;
+
+	// Success
+	return true;
+}
+
+
+void ReplicationServer::free()
+{
+	for( Peer &peer : peers ) { if( peer.active ) { peer.sent.free(); peer.active = false; } }
+	state.free();
+	context = nullptr;
+	socket = nullptr;
+}
+
+
+bool ReplicationServer::peer_add( const NetAddress &address )
+{
+	Peer *slot = nullptr;
+	for( Peer &peer : peers )
+	{
+		if( peer.active && peer.address == address ) { return true; }
+		if( !peer.active && slot == nullptr ) { slot = &peer; }
+	}
+	ErrorReturnIf( slot == nullptr, false, "ReplicationServer: exceeded REPLICATION_PEERS_MAX (%u)", REPLICATION_PEERS_MAX );
+
+	slot->address = address;
+	slot->acked = 0;
+	slot->sent.init();
+	slot->active = true;
+
+	// Success
+	return true;
+}
+
+
+bool ReplicationServer::peer_remove( const NetAddress &address )
+{
+	for( Peer &peer : peers )
+	{
+		if( !peer.active || peer.address != address ) { continue; }
+		peer.sent.free();
+		peer.active = false;
+		return true;
+	}
+
+	return false;
+}
+
+
+void ReplicationServer::update()
+{
+	Assert( context != nullptr );
+
+	// Acknowledgements
+	byte packet[NETWORK_PACKET_SIZE];
+	NetAddress address;
+	usize size;
+	while( ( size = Network::receive( *socket, address, packet, sizeof( packet ) ) ) > 0 )
+	{
+		BitReader reader { packet, size };
+		if( reader.read( 16 ) != REPLICATION_TAG_ACK ) { continue; }
+		const u32 ack = reader.read( 32 );
+		if( reader.overflow ) { continue; }
+
+		for( Peer &peer : peers )
+		{
+			if( !peer.active || peer.address != address ) { continue; }
+			if( ack > peer.acked && ack <= sequence ) { peer.acked = ack; }
+		}
+	}
+
+	// State
+	sequence++;
+	capture();
+
+	// Deltas
+	for( Peer &peer : peers )
+	{
+		if( peer.active ) { send( peer ); }
+	}
+}
+
+
+void ReplicationServer::capture()
+{
+	state.clear();
+
+	// Buckets are walked in order, so records are sorted by key
+	for( u16 bucketID = 0; bucketID < context->current; bucketID++ )
+	{
+		const ObjectContext::ObjectBucket &bucket = context->buckets[bucketID];
+		if( bucket.data == nullptr || bucket.top == 0 ) { continue; }
+
+		const u16 fieldCount = iObjects::OBJECT_TYPE_NET_FIELD_COUNT[bucket.type];
+		if( fieldCount == 0 ) { continue; }
+		const iObjects::NetFieldInfo *fields = iObjects::OBJECT_TYPE_NET_FIELDS[bucket.type];
+		const iObjects::SnapshotEvent event = iObjects::OBJECT_TYPE_EVENT_NETWORK_SEND[bucket.type];
+		const usize size = iObjects::OBJECT_TYPE_SIZE[bucket.type];
+
+		for( u16 index = bucket.bottom; index < bucket.top; index++ )
+		{
+			byte *const objectPtr = bucket.data + index * size;
+			const Object &id = reinterpret_cast<iObjects::OBJECT_BASE_t *>( objectPtr )->id;
+			if( !id.alive ) { continue; }
+
+			const usize start = state.current;
+			const iReplication::Record record { ( static_cast<u32>( bucketID ) << 16 ) | index, id.generation, bucket.type };
+			state.write( record );
+			for( u16 i = 0; i < fieldCount; i++ ) { state.write( field_pointer( objectPtr, bucket.type, fields[i] ), fields[i].size ); }
+
+			// EVENT_NETWORK_SEND
+			if( event != nullptr ) { event( objectPtr, state.data + start + sizeof( iReplication::Record ) ); }
+		}
+	}
+}
+
+
+void ReplicationServer::send( Peer &peer )
+{
+	// Baseline: newest acknowledged state (if it has not been overwritten by this sequence)
+	iReplication::State *baseline = peer.sent.find( peer.acked );
+	if( baseline != nullptr && ( sequence - baseline->sequence ) >= REPLICATION_HISTORY ) { baseline = nullptr; }
+	iReplication::State &sent = peer.sent.insert( sequence );
+
+	byte packet[NETWORK_PACKET_SIZE];
+	BitWriter writer { packet, sizeof( packet ) };
+	writer.write( REPLICATION_TAG_STATE, 16 );
+	writer.write( sequence, 32 );
+	writer.write( baseline == nullptr ? REPLICATION_BASELINE_NONE : baseline->sequence, 32 );
+	const usize budget = sizeof( packet ) * 8 - 1; // terminating 'more' bit
+
+	// Merge the current state with the baseline (both sorted by key)
+	// Entries that do not fit keep the peer's baseline record in 'sent', so they are retried in later deltas
+	const usize currentSize = state.current;
+	const usize baselineSize = baseline == nullptr ? 0 : baseline->records.current;
+	usize c = 0;
+	usize b = 0;
+	while( c < currentSize || b < baselineSize )
+	{
+		const bool hasCurrent = c < currentSize;
+		const bool hasBaseline = b < baselineSize;
+		const iReplication::Record current = hasCurrent ? record_at( state, c ) : iReplication::Record { };
+		const iReplication::Record previous = hasBaseline ? record_at( baseline->records, b ) : iReplication::Record { };
+		const usize currentRecordSize = hasCurrent ? iReplication::record_size( current.type ) : 0;
+		const usize previousRecordSize = hasBaseline ? iReplication::record_size( previous.type ) : 0;
+
+		// Destroy
+		if( !hasCurrent || ( hasBaseline && previous.key < current.key ) )
+		{
+			if( writer.bits + REPLICATION_ENTRY_BITS <= budget )
+			{
+				writer.write( 1, 1 );
+				writer.write( ReplicationOp_Destroy, 2 );
+				writer.write( previous.key, 32 );
+			}
+			else
+			{
+				sent.records.write( baseline->records.data + b, previousRecordSize );
+			}
+			b += previousRecordSize;
+			continue;
+		}
+
+		const bool matches = hasBaseline && previous.key == current.key &&
+			previous.generation == current.generation && previous.type == current.type;
+		const byte *currentFields = state.data + c + sizeof( iReplication::Record );
+		const u16 fieldCount = iObjects::OBJECT_TYPE_NET_FIELD_COUNT[current.type];
+		const iObjects::NetFieldInfo *fields = iObjects::OBJECT_TYPE_NET_FIELDS[current.type];
+
+		if( matches )
+		{
+			// Update (dirty fields only)
+			const byte *previousFields = baseline->records.data + b + sizeof( iReplication::Record );
+			usize bits = REPLICATION_ENTRY_BITS;
+			usize offset = 0;
+			for( u16 i = 0; i < fieldCount; offset += fields[i].size, i++ )
+			{
+				const bool dirty = memory_compare( currentFields + offset, previousFields + offset, fields[i].size ) != 0;
+				bits += 1 + ( dirty ? fields[i].size * 8 : 0 );
+			}
+
+			if( bits == REPLICATION_ENTRY_BITS + static_cast<usize>( fieldCount ) )
+			{
+				// Unchanged
+			}
+			else if( writer.bits + bits <= budget )
+			{
+				writer.write( 1, 1 );
+				writer.write( ReplicationOp_Update, 2 );
+				writer.write( current.key, 32 );
+				offset = 0;
+				for( u16 i = 0; i < fieldCount; offset += fields[i].size, i++ )
+				{
+					const bool dirty = memory_compare( currentFields + offset, previousFields + offset, fields[i].size ) != 0;
+					writer.write( dirty, 1 );
+					if( dirty ) { writer.write_bytes( currentFields + offset, fields[i].size ); }
+				}
+			}
+			else
+			{
+				sent.records.write( baseline->records.data + b, previousRecordSize );
+				c += currentRecordSize;
+				b += previousRecordSize;
+				continue;
+			}
+		}
+		else
+		{
+			// Create (new objects & objects that replaced the baseline's object at this key)
+			const usize bits = REPLICATION_ENTRY_BITS + 16 + 15 + ( currentRecordSize - sizeof( iReplication::Record ) ) * 8;
+			if( writer.bits + bits <= budget )
+			{
+				writer.write( 1, 1 );
+				writer.write( ReplicationOp_Create, 2 );
+				writer.write( current.key, 32 );
+				writer.write( current.generation, 16 );
+				writer.write( current.type, 15 );
+				writer.write_bytes( currentFields, currentRecordSize - sizeof( iReplication::Record ) );
+			}
+			else
+			{
+				if( hasBaseline && previous.key == current.key )
+				{
+					sent.records.write( baseline->records.data + b, previousRecordSize );
+					b += previousRecordSize;
+				}
+				c += currentRecordSize;
+				continue;
+			}
+		}
+
+		sent.records.write( state.data + c, currentRecordSize );
+		if( hasBaseline && previous.key == current.key ) { b += previousRecordSize; }
+		c += currentRecordSize;
+	}
+	writer.write( 0, 1 );
+
+	Network::send( *socket, peer.address, packet, writer.size() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static bool replication_decode( BitReader &reader, iReplication::State *baseline, iReplication::State &next )
+{
+	const usize baselineSize = baseline == nullptr ? 0 : baseline->records.current;
+	usize b = 0;
+
+	while( reader.read( 1 ) )
+	{
+		const u32 op = reader.read( 2 );
+		const u32 key = reader.read( 32 );
+		if( reader.overflow ) { return false; }
+
+		// Baseline records preceding this entry are unchanged
+		while( b < baselineSize && record_at( baseline->records, b ).key < key )
+		{
+			const usize size = iReplication::record_size( record_at( baseline->records, b ).type );
+			next.records.write( baseline->records.data + b, size );
+			b += size;
+		}
+
+		const bool hasBaseline = b < baselineSize && record_at( baseline->records, b ).key == key;
+		const iReplication::Record previous = hasBaseline ? record_at( baseline->records, b ) : iReplication::Record { };
+		const usize previousRecordSize = hasBaseline ? iReplication::record_size( previous.type ) : 0;
+
+		switch( op )
+		{
+			case ReplicationOp_Create:
+			{
+				iReplication::Record record;
+				record.key = key;
+				record.generation = static_cast<u16>( reader.read( 16 ) );
+				record.type = static_cast<u16>( reader.read( 15 ) );
+				if( reader.overflow || record.type == 0 || record.type >= OBJECT_TYPE_COUNT ||
+				    iObjects::OBJECT_TYPE_NET_FIELD_COUNT[record.type] == 0 ) { return false; }
+
+				next.records.write( record );
+				const usize size = iReplication::record_size( record.type ) - sizeof( iReplication::Record );
+				for( usize i = 0; i < size; i++ ) { next.records.write( static_cast<byte>( reader.read( 8 ) ) ); }
+				b += previousRecordSize;
+			}
+			break;
+
+			case ReplicationOp_Update:
+			{
+				if( !hasBaseline ) { return false; }
+				const usize start = next.records.current;
+				next.records.write( baseline->records.data + b, previousRecordSize );
+
+				const u16 fieldCount = iObjects::OBJECT_TYPE_NET_FIELD_COUNT[previous.type];
+				const iObjects::NetFieldInfo *fields = iObjects::OBJECT_TYPE_NET_FIELDS[previous.type];
+				usize offset = start + sizeof( iReplication::Record );
+				for( u16 i = 0; i < fieldCount; offset += fields[i].size, i++ )
+				{
+					if( !reader.read( 1 ) ) { continue; }
+					for( u16 j = 0; j < fields[i].size; j++ ) { next.records.data[offset + j] = static_cast<byte>( reader.read( 8 ) ); }
+				}
+				b += previousRecordSize;
+			}
+			break;
+
+			case ReplicationOp_Destroy:
+			{
+				if( !hasBaseline ) { return false; }
+				b += previousRecordSize;
+			}
+			break;
+
+			default: return false;
+		}
+
+		if( reader.overflow ) { return false; }
+	}
+
+	// Remaining baseline records are unchanged
+	if( b < baselineSize ) { next.records.write( baseline->records.data + b, baselineSize - b ); }
+
+	// Success
+	return !reader.overflow;
+}
+
+
+bool ReplicationClient::init( ObjectContext &context, NetSocket &socket, const NetAddress &server )
+{
+	Assert( context.buckets != nullptr );
+	Assert( socket.handle >= 0 );
+	this->context = &context;
+	this->socket = &socket;
+	this->server = server;
+	history.init();
+	mappings.init( 1024, true );
+	mappingsNext.init( 1024, true );
+	sequence = 0;
+
+	// Success
+	return true;
+}
+
+
+void ReplicationClient::free()
+{
+	history.free();
+	mappings.free();
+	mappingsNext.free();
+	context = nullptr;
+	socket = nullptr;
+}
+
+
+void ReplicationClient::update()
+{
+	Assert( context != nullptr );
+	const u32 sequencePrevious = sequence;
+
+	byte packet[NETWORK_PACKET_SIZE];
+	NetAddress address;
+	usize size;
+	while( ( size = Network::receive( *socket, address, packet, sizeof( packet ) ) ) > 0 )
+	{
+		if( address != server ) { continue; }
+		receive( packet, size );
+	}
+
+	// Only the newest state is applied
+	if( sequence == sequencePrevious ) { return; }
+	iReplication::State *state = history.find( sequence );
+	Assert( state != nullptr );
+	apply( *state );
+}
+
+
+Object ReplicationClient::object( const u32 key ) const
+{
+	const Mapping *array = reinterpret_cast<const Mapping *>( mappings.data );
+	usize low = 0;
+	usize high = mappings.current / sizeof( Mapping );
+	while( low < high )
+	{
+		const usize middle = ( low + high ) / 2;
+		if( array[middle].key == key ) { return array[middle].object; }
+		if( array[middle].key < key ) { low = middle + 1; } else { high = middle; }
+	}
+	return NULL_OBJECT;
+}
+
+
+bool ReplicationClient::receive( const byte *packet, const usize size )
+{
+	BitReader reader { packet, size };
+	if( reader.read( 16 ) != REPLICATION_TAG_STATE ) { return false; }
+	const u32 packetSequence = reader.read( 32 );
+	const u32 baselineSequence = reader.read( 32 );
+
+	// Late, duplicate, or malformed packets are dropped
+	if( reader.overflow || packetSequence <= sequence ) { return false; }
+
+	iReplication::State *baseline = nullptr;
+	if( baselineSequence != REPLICATION_BASELINE_NONE )
+	{
+		baseline = history.find( baselineSequence );
+		if( baseline == nullptr || ( packetSequence - baselineSequence ) >= REPLICATION_HISTORY ) { return false; }
+	}
+
+	iReplication::State &next = history.insert( packetSequence );
+	if( !replication_decode( reader, baseline, next ) ) { next.sequence = 0; return false; }
+	sequence = packetSequence;
+
+	// Acknowledge
+	byte ack[6];
+	BitWriter writer { ack, sizeof( ack ) };
+	writer.write( REPLICATION_TAG_ACK, 16 );
+	writer.write( packetSequence, 32 );
+	Network::send( *socket, server, ack, writer.size() );
+
+	// Success
+	return true;
+}
+
+
+static void replication_write( ObjectContext &context, const Object &object, const iReplication::Record &record, byte *data )
+{
+	byte *const objectPtr = context.object_pointer( object );
+	if( objectPtr == nullptr ) { return; }
+
+	const iObjects::NetFieldInfo *fields = iObjects::OBJECT_TYPE_NET_FIELDS[record.type];
+	for( u16 i = 0, offset = 0; i < iObjects::OBJECT_TYPE_NET_FIELD_COUNT[record.type]; offset += fields[i].size, i++ )
+	{
+		memory_copy( field_pointer( objectPtr, record.type, fields[i] ), data + offset, fields[i].size );
+	}
+
+	// EVENT_NETWORK_RECEIVE
+	const iObjects::SnapshotEvent event = iObjects::OBJECT_TYPE_EVENT_NETWORK_RECEIVE[record.type];
+	if( event != nullptr ) { event( objectPtr, data ); }
+}
+
+
+void ReplicationClient::apply( const iReplication::State &state )
+{
+	Assert( !context->is_deferred() );
+	mappingsNext.clear();
+
+	// Merge the state with the current mappings (both sorted by key)
+	const usize stateSize = state.records.current;
+	const usize mappingsSize = mappings.current;
+	usize r = 0;
+	usize m = 0;
+	while( r < stateSize || m < mappingsSize )
+	{
+		const bool hasRecord = r < stateSize;
+		const bool hasMapping = m < mappingsSize;
+		const iReplication::Record record = hasRecord ? record_at( state.records, r ) : iReplication::Record { };
+		Mapping mapping = hasMapping ? *reinterpret_cast<Mapping *>( mappings.data + m ) : Mapping { };
+
+		// Destroyed on the server
+		if( !hasRecord || ( hasMapping && mapping.key < record.key ) )
+		{
+			context->destroy( mapping.object );
+			m += sizeof( Mapping );
+			continue;
+		}
+
+		byte *const data = state.records.data + r + sizeof( iReplication::Record );
+		const bool matches = hasMapping && mapping.key == record.key &&
+			mapping.generation == record.generation && mapping.type == record.type;
+
+		if( matches && context->exists( mapping.object ) )
+		{
+			// Update
+			replication_write( *context, mapping.object, record, data );
+			mappingsNext.write( mapping );
+		}
+		else
+		{
+			// Create (replacing the object previously mapped to this key)
+			if( hasMapping && mapping.key == record.key ) { context->destroy( mapping.object ); }
+			const Object object = context->create( record.type );
+			replication_write( *context, object, record, data );
+			mappingsNext.write( Mapping { record.key, record.generation, record.type, object } );
+		}
+
+		if( hasMapping && mapping.key == record.key ) { m += sizeof( Mapping ); }
+		r += iReplication::record_size( record.type );
+	}
+
+	mappings.clear();
+	mappings.write( mappingsNext.data, mappingsNext.current );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
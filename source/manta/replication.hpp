@@ -0,0 +1,124 @@
+#pragma once
+
+#include <config.hpp>
+#include <types.hpp>
+#include <debug.hpp>
+
+#include <manta/buffer.hpp>
+#include <manta/network.hpp>
+#include <manta/objects.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// State replication for NETWORKED objects
+//
+// Each ReplicationServer::update() captures the PUBLIC & HOT fields of every NETWORKED object into a state record
+// (EVENT_NETWORK_SEND may rewrite an object's record, e.g. to quantize it) and sends each peer the state as a delta
+// against the last state that peer acknowledged. Deltas only carry created & destroyed objects and the changed fields
+// of updated objects, packed into one datagram of at most NETWORK_PACKET_SIZE bytes. Entries that do not fit are
+// sent in later updates.
+//
+// ReplicationClient::update() rebuilds the newest state from its baseline, acknowledges it, and mirrors it into its
+// ObjectContext: objects are created (default constructor), written, and destroyed to match the server, after which
+// EVENT_NETWORK_RECEIVE runs on each updated object. Client & server must be built from identical object files.
+
+namespace iReplication
+{
+	struct Record
+	{
+		u32 key;        // ( bucketID << 16 ) | index on the server
+		u16 generation;
+		u16 type;
+		// field data follows (OBJECT_TYPE_NET_FIELDS order)
+	};
+
+	struct State
+	{
+		Buffer records;      // Record array (sorted by key)
+		u32 sequence = 0;    // 0: empty slot
+	};
+
+	struct History
+	{
+		State states[REPLICATION_HISTORY];
+
+		void init();
+		void free();
+		State &insert( const u32 sequence );
+		State *find( const u32 sequence );
+	};
+
+	extern usize record_size( const u16 type );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ReplicationServer
+{
+public:
+	bool init( ObjectContext &context, NetSocket &socket );
+	void free();
+
+	bool peer_add( const NetAddress &address );
+	bool peer_remove( const NetAddress &address );
+
+	// Processes acknowledgements, captures the current state, and sends a delta to each peer
+	void update();
+
+	u32 sequence = 0; // sequence of the most recently captured state
+
+private:
+	struct Peer
+	{
+		NetAddress address;
+		u32 acked = 0;               // newest acknowledged sequence (0: none)
+		iReplication::History sent;  // states the peer reconstructs from the deltas it was sent
+		bool active = false;
+	};
+
+	void capture();
+	void send( Peer &peer );
+
+	ObjectContext *context = nullptr;
+	NetSocket *socket = nullptr;
+	Buffer state;
+	Peer peers[REPLICATION_PEERS_MAX];
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+class ReplicationClient
+{
+public:
+	bool init( ObjectContext &context, NetSocket &socket, const NetAddress &server );
+	void free();
+
+	// Receives pending deltas, acknowledges them, and applies the newest state to the ObjectContext
+	void update();
+
+	// Returns the local object mirroring a server object (NULL_OBJECT if none)
+	Object object( const u32 key ) const;
+
+	u32 sequence = 0; // sequence of the most recently applied state
+
+private:
+	struct Mapping
+	{
+		u32 key;
+		u16 generation;
+		u16 type;
+		Object object;
+	};
+
+	bool receive( const byte *packet, const usize size );
+	void apply( const iReplication::State &state );
+
+	ObjectContext *context = nullptr;
+	NetSocket *socket = nullptr;
+	NetAddress server;
+	iReplication::History history;
+	Buffer mappings;     // Mapping array (sorted by key)
+	Buffer mappingsNext; // scratch for apply()
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
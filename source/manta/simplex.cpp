@@ -4,6 +4,8 @@
 
 #include <manta/math.hpp>
 
+#include <vendor/simd.hpp>
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #define F2 0.366025403f
@@ -150,3 +152,234 @@ float Simplex::sample_fbm( float x, float y, float f, float a, float l, float p,
 
 	return output;
 }
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static inline void hash4( const i32 *i, const i32 *j, const i32 *lower, i32 *gi0, i32 *gi1, i32 *gi2 )
+{
+	// Neither SSE2 nor NEON can gather: the perm lookups for each lane go through memory
+	for( int k = 0; k < 4; k++ )
+	{
+		const int i1 = lower[k] & 1;
+		const int j1 = i1 ^ 1;
+		gi0[k] = perm[ static_cast<u8>( i[k]      + perm[ static_cast<u8>( j[k] ) ] ) ];
+		gi1[k] = perm[ static_cast<u8>( i[k] + i1 + perm[ static_cast<u8>( j[k] + j1 ) ] ) ];
+		gi2[k] = perm[ static_cast<u8>( i[k] + 1  + perm[ static_cast<u8>( j[k] + 1 ) ] ) ];
+	}
+}
+
+
+#if SIMD_SSE
+
+static inline __m128i floor4( const __m128 x )
+{
+	// fast_floor(): truncate, then subtract 1 where truncation rounded up (mask is -1)
+	const __m128i i = _mm_cvttps_epi32( x );
+	return _mm_add_epi32( i, _mm_castps_si128( _mm_cmpgt_ps( _mm_cvtepi32_ps( i ), x ) ) );
+}
+
+
+static inline __m128 grad4( const __m128i hash, const __m128 x, const __m128 y )
+{
+	const __m128i h = _mm_and_si128( hash, _mm_set1_epi32( 0x3F ) );
+	const __m128 swap = _mm_castsi128_ps( _mm_cmplt_epi32( h, _mm_set1_epi32( 4 ) ) );
+	const __m128 u = _mm_or_ps( _mm_and_ps( swap, x ), _mm_andnot_ps( swap, y ) );
+	const __m128 v = _mm_or_ps( _mm_and_ps( swap, y ), _mm_andnot_ps( swap, x ) );
+
+	// Bits 0 & 1 flip the sign of u & v
+	const __m128 signU = _mm_castsi128_ps( _mm_slli_epi32( _mm_and_si128( h, _mm_set1_epi32( 1 ) ), 31 ) );
+	const __m128 signV = _mm_castsi128_ps( _mm_slli_epi32( _mm_and_si128( h, _mm_set1_epi32( 2 ) ), 30 ) );
+	return _mm_add_ps( _mm_xor_ps( u, signU ), _mm_xor_ps( _mm_mul_ps( _mm_set1_ps( 2.0f ), v ), signV ) );
+}
+
+
+static inline __m128 corner4( const __m128i hash, const __m128 x, const __m128 y )
+{
+	// Corners outside the radius clamp to t = 0 and contribute nothing
+	__m128 t = _mm_sub_ps( _mm_sub_ps( _mm_set1_ps( 0.5f ), _mm_mul_ps( x, x ) ), _mm_mul_ps( y, y ) );
+	t = _mm_max_ps( t, _mm_setzero_ps() );
+	t = _mm_mul_ps( t, t );
+	return _mm_mul_ps( _mm_mul_ps( t, t ), grad4( hash, x, y ) );
+}
+
+
+static inline __m128 sample4( const __m128 x, const __m128 y )
+{
+	const __m128 g2 = _mm_set1_ps( G2 );
+	const __m128 one = _mm_set1_ps( 1.0f );
+
+	const __m128 s = _mm_mul_ps( _mm_add_ps( x, y ), _mm_set1_ps( F2 ) );
+	const __m128i i = floor4( _mm_add_ps( x, s ) );
+	const __m128i j = floor4( _mm_add_ps( y, s ) );
+	const __m128 t = _mm_mul_ps( _mm_cvtepi32_ps( _mm_add_epi32( i, j ) ), g2 );
+	const __m128 x0 = _mm_sub_ps( x, _mm_sub_ps( _mm_cvtepi32_ps( i ), t ) );
+	const __m128 y0 = _mm_sub_ps( y, _mm_sub_ps( _mm_cvtepi32_ps( j ), t ) );
+
+	// Middle corner: (1, 0) in the lower triangle, (0, 1) in the upper
+	const __m128 lower = _mm_cmpgt_ps( x0, y0 );
+	const __m128 x1 = _mm_add_ps( _mm_sub_ps( x0, _mm_and_ps( lower, one ) ), g2 );
+	const __m128 y1 = _mm_add_ps( _mm_sub_ps( y0, _mm_andnot_ps( lower, one ) ), g2 );
+	const __m128 x2 = _mm_add_ps( _mm_sub_ps( x0, one ), _mm_set1_ps( 2.0f * G2 ) );
+	const __m128 y2 = _mm_add_ps( _mm_sub_ps( y0, one ), _mm_set1_ps( 2.0f * G2 ) );
+
+	alignas( 16 ) i32 lanesI[4];
+	alignas( 16 ) i32 lanesJ[4];
+	alignas( 16 ) i32 lanesLower[4];
+	alignas( 16 ) i32 gi0[4];
+	alignas( 16 ) i32 gi1[4];
+	alignas( 16 ) i32 gi2[4];
+	_mm_store_si128( reinterpret_cast<__m128i *>( lanesI ), i );
+	_mm_store_si128( reinterpret_cast<__m128i *>( lanesJ ), j );
+	_mm_store_si128( reinterpret_cast<__m128i *>( lanesLower ), _mm_castps_si128( lower ) );
+	hash4( lanesI, lanesJ, lanesLower, gi0, gi1, gi2 );
+
+	const __m128 n0 = corner4( _mm_load_si128( reinterpret_cast<const __m128i *>( gi0 ) ), x0, y0 );
+	const __m128 n1 = corner4( _mm_load_si128( reinterpret_cast<const __m128i *>( gi1 ) ), x1, y1 );
+	const __m128 n2 = corner4( _mm_load_si128( reinterpret_cast<const __m128i *>( gi2 ) ), x2, y2 );
+	return _mm_mul_ps( _mm_set1_ps( 45.23065f ), _mm_add_ps( _mm_add_ps( n0, n1 ), n2 ) );
+}
+
+#elif SIMD_NEON
+
+static inline int32x4_t floor4( const float32x4_t x )
+{
+	// fast_floor(): truncate, then subtract 1 where truncation rounded up (mask is -1)
+	const int32x4_t i = vcvtq_s32_f32( x );
+	return vaddq_s32( i, vreinterpretq_s32_u32( vcgtq_f32( vcvtq_f32_s32( i ), x ) ) );
+}
+
+
+static inline float32x4_t grad4( const int32x4_t hash, const float32x4_t x, const float32x4_t y )
+{
+	const int32x4_t h = vandq_s32( hash, vdupq_n_s32( 0x3F ) );
+	const uint32x4_t swap = vcltq_s32( h, vdupq_n_s32( 4 ) );
+	const float32x4_t u = vbslq_f32( swap, x, y );
+	const float32x4_t v = vbslq_f32( swap, y, x );
+
+	// Bits 0 & 1 flip the sign of u & v
+	const uint32x4_t signU = vshlq_n_u32( vreinterpretq_u32_s32( vandq_s32( h, vdupq_n_s32( 1 ) ) ), 31 );
+	const uint32x4_t signV = vshlq_n_u32( vreinterpretq_u32_s32( vandq_s32( h, vdupq_n_s32( 2 ) ) ), 30 );
+	const float32x4_t uSigned = vreinterpretq_f32_u32( veorq_u32( vreinterpretq_u32_f32( u ), signU ) );
+	const float32x4_t vSigned = vreinterpretq_f32_u32( veorq_u32( vreinterpretq_u32_f32( vmulq_n_f32( v, 2.0f ) ), signV ) );
+	return vaddq_f32( uSigned, vSigned );
+}
+
+
+static inline float32x4_t corner4( const int32x4_t hash, const float32x4_t x, const float32x4_t y )
+{
+	// Corners outside the radius clamp to t = 0 and contribute nothing
+	float32x4_t t = vsubq_f32( vsubq_f32( vdupq_n_f32( 0.5f ), vmulq_f32( x, x ) ), vmulq_f32( y, y ) );
+	t = vmaxq_f32( t, vdupq_n_f32( 0.0f ) );
+	t = vmulq_f32( t, t );
+	return vmulq_f32( vmulq_f32( t, t ), grad4( hash, x, y ) );
+}
+
+
+static inline float32x4_t sample4( const float32x4_t x, const float32x4_t y )
+{
+	const float32x4_t g2 = vdupq_n_f32( G2 );
+	const float32x4_t one = vdupq_n_f32( 1.0f );
+
+	const float32x4_t s = vmulq_n_f32( vaddq_f32( x, y ), F2 );
+	const int32x4_t i = floor4( vaddq_f32( x, s ) );
+	const int32x4_t j = floor4( vaddq_f32( y, s ) );
+	const float32x4_t t = vmulq_f32( vcvtq_f32_s32( vaddq_s32( i, j ) ), g2 );
+	const float32x4_t x0 = vsubq_f32( x, vsubq_f32( vcvtq_f32_s32( i ), t ) );
+	const float32x4_t y0 = vsubq_f32( y, vsubq_f32( vcvtq_f32_s32( j ), t ) );
+
+	// Middle corner: (1, 0) in the lower triangle, (0, 1) in the upper
+	const uint32x4_t lower = vcgtq_f32( x0, y0 );
+	const float32x4_t i1 = vreinterpretq_f32_u32( vandq_u32( lower, vreinterpretq_u32_f32( one ) ) );
+	const float32x4_t j1 = vreinterpretq_f32_u32( vbicq_u32( vreinterpretq_u32_f32( one ), lower ) );
+	const float32x4_t x1 = vaddq_f32( vsubq_f32( x0, i1 ), g2 );
+	const float32x4_t y1 = vaddq_f32( vsubq_f32( y0, j1 ), g2 );
+	const float32x4_t x2 = vaddq_f32( vsubq_f32( x0, one ), vdupq_n_f32( 2.0f * G2 ) );
+	const float32x4_t y2 = vaddq_f32( vsubq_f32( y0, one ), vdupq_n_f32( 2.0f * G2 ) );
+
+	alignas( 16 ) i32 lanesI[4];
+	alignas( 16 ) i32 lanesJ[4];
+	alignas( 16 ) i32 lanesLower[4];
+	alignas( 16 ) i32 gi0[4];
+	alignas( 16 ) i32 gi1[4];
+	alignas( 16 ) i32 gi2[4];
+	vst1q_s32( lanesI, i );
+	vst1q_s32( lanesJ, j );
+	vst1q_s32( lanesLower, vreinterpretq_s32_u32( lower ) );
+	hash4( lanesI, lanesJ, lanesLower, gi0, gi1, gi2 );
+
+	const float32x4_t n0 = corner4( vld1q_s32( gi0 ), x0, y0 );
+	const float32x4_t n1 = corner4( vld1q_s32( gi1 ), x1, y1 );
+	const float32x4_t n2 = corner4( vld1q_s32( gi2 ), x2, y2 );
+	return vmulq_n_f32( vaddq_f32( vaddq_f32( n0, n1 ), n2 ), 45.23065f );
+}
+
+#endif
+
+
+void Simplex::sample_batch( const float *xs, const float *ys, float *out, const usize count )
+{
+	usize i = 0;
+
+#if SIMD_SSE
+	for( ; i + 4 <= count; i += 4 )
+	{
+		_mm_storeu_ps( out + i, sample4( _mm_loadu_ps( xs + i ), _mm_loadu_ps( ys + i ) ) );
+	}
+#elif SIMD_NEON
+	for( ; i + 4 <= count; i += 4 )
+	{
+		vst1q_f32( out + i, sample4( vld1q_f32( xs + i ), vld1q_f32( ys + i ) ) );
+	}
+#endif
+
+	// Remainder
+	for( ; i < count; i++ ) { out[i] = Simplex::sample( xs[i], ys[i] ); }
+}
+
+
+void Simplex::sample_fbm_batch( const float *xs, const float *ys, float *out, const usize count,
+	float f, float a, float l, float p, int o )
+{
+	usize i = 0;
+
+#if SIMD_SSE
+	for( ; i + 4 <= count; i += 4 )
+	{
+		const __m128 x = _mm_loadu_ps( xs + i );
+		const __m128 y = _mm_loadu_ps( ys + i );
+		__m128 output = _mm_setzero_ps();
+		float frequency = f;
+		float amplitude = a;
+		for( int octave = 0; octave < o; octave++ )
+		{
+			const __m128 frequencies = _mm_set1_ps( frequency );
+			const __m128 n = sample4( _mm_mul_ps( x, frequencies ), _mm_mul_ps( y, frequencies ) );
+			output = _mm_add_ps( output, _mm_mul_ps( _mm_set1_ps( amplitude ), n ) );
+			frequency *= l;
+			amplitude *= p;
+		}
+		_mm_storeu_ps( out + i, output );
+	}
+#elif SIMD_NEON
+	for( ; i + 4 <= count; i += 4 )
+	{
+		const float32x4_t x = vld1q_f32( xs + i );
+		const float32x4_t y = vld1q_f32( ys + i );
+		float32x4_t output = vdupq_n_f32( 0.0f );
+		float frequency = f;
+		float amplitude = a;
+		for( int octave = 0; octave < o; octave++ )
+		{
+			const float32x4_t n = sample4( vmulq_n_f32( x, frequency ), vmulq_n_f32( y, frequency ) );
+			output = vaddq_f32( output, vmulq_n_f32( n, amplitude ) );
+			frequency *= l;
+			amplitude *= p;
+		}
+		vst1q_f32( out + i, output );
+	}
+#endif
+
+	// Remainder
+	for( ; i < count; i++ ) { out[i] = Simplex::sample_fbm( xs[i], ys[i], f, a, l, p, o ); }
+}
@@ -0,0 +1,264 @@
+#include <manta/text.hpp>
+
+#include <manta/gfx.hpp>
+#include <manta/fonts.hpp>
+#include <manta/utf8.hpp>
+#include <manta/assets.hpp>
+
+#include <vendor/vendor.hpp>
+#include <vendor/stdarg.hpp>
+#include <vendor/stdio.hpp>
+#include <vendor/string.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct TextQuad
+{
+	GfxBuiltInQuad quad;
+	const GfxTexture2D *texture;
+	bool sdf;
+};
+
+
+static void quads_offset( Buffer &quads, const usize first, const usize last, const float x, const float y )
+{
+	TextQuad *const text = reinterpret_cast<TextQuad *>( quads.data );
+	for( usize i = first; i < last; i++ )
+	{
+		GfxBuiltInQuad &quad = text[i].quad;
+		quad.v1.position.x += x; quad.v1.position.y += y;
+		quad.v2.position.x += x; quad.v2.position.y += y;
+		quad.v3.position.x += x; quad.v3.position.y += y;
+		quad.v4.position.x += x; quad.v4.position.y += y;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void TextMesh::init()
+{
+	string.init( 64, true );
+	quads.init( 64 * sizeof( TextQuad ), true );
+	string.write( '\0' );
+	bounds = 0;
+	generation = U32_MAX;
+	lineCount = 0;
+}
+
+
+void TextMesh::free()
+{
+	string.free();
+	quads.free();
+}
+
+
+bool TextMesh::set( const u16 font, const u16 size, const char *string, const u16 wrapWidth )
+{
+	Assert( font < Assets::fontsCount );
+	Assert( size > 0 );
+	Assert( this->string.data != nullptr );
+
+	// Unchanged?
+	if( font == fontID && size == fontSize && wrapWidth == wrap &&
+	    strcmp( reinterpret_cast<const char *>( this->string.data ), string ) == 0 )
+	{
+		return false;
+	}
+
+	fontID = font;
+	fontSize = size;
+	wrap = wrapWidth;
+	this->string.clear();
+	this->string.write( string, strlen( string ) + 1 );
+
+	layout();
+	return true;
+}
+
+
+bool TextMesh::set_f( const u16 font, const u16 size, const char *format, ... )
+{
+	va_list args;
+	va_start( args, format );
+	char buffer[1024];
+	vsnprintf( buffer, 1024, format, args );
+	va_end( args );
+
+	return set( font, size, buffer );
+}
+
+
+void TextMesh::validate()
+{
+	if( generation != iFonts::generation || halign != draw_get_halign() || valign != draw_get_valign() ) { layout(); }
+}
+
+
+void TextMesh::layout()
+{
+	// Alignment & atlas the layout is valid for
+	generation = iFonts::generation;
+	halign = draw_get_halign();
+	valign = draw_get_valign();
+
+	quads.clear();
+	bounds = 0;
+	lineCount = 0;
+
+	float offsetX = 0.0f;
+	float offsetY = 0.0f;
+	float width = 0.0f;      // widest line
+	usize lineFirst = 0;     // first quad of the current line
+	usize breakFirst = 0;    // first quad after the last whitespace of the current line
+	float breakX = -1.0f;    // offsetX after the last whitespace of the current line (< 0: none)
+	float breakWidth = 0.0f; // line width before the last whitespace
+
+	u32 state = UTF8_ACCEPT;
+	u32 codepoint;
+	char c;
+	const char *text = reinterpret_cast<const char *>( string.data );
+
+	for( ;; )
+	{
+		c = *text++;
+		if( c != '\0' && utf8_decode( &state, &codepoint, c ) != UTF8_ACCEPT ) { continue; }
+
+		// Line break
+		const bool end = ( c == '\0' );
+		const bool newline = !end && UNLIKELY( codepoint == '\n' );
+		if( end || newline )
+		{
+			quads_offset( quads, lineFirst, quads.current / sizeof( TextQuad ), -offsetX * halign * 0.5f, 0.0f );
+			width = max( width, offsetX );
+			lineCount++;
+			if( end ) { break; }
+
+			offsetX = 0.0f;
+			offsetY += fontSize;
+			lineFirst = quads.current / sizeof( TextQuad );
+			breakX = -1.0f;
+			continue;
+		}
+
+		// Retrieve FontQuad
+		FontQuad glyph;
+		iFonts::quad( fontID, fontSize, codepoint, glyph );
+		const bool whitespace = ( codepoint == ' ' || codepoint == '\t' );
+
+		// Word wrap
+		if( wrap > 0 && !whitespace && offsetX > 0.0f && offsetX + glyph.advance > wrap )
+		{
+			// Break at the last whitespace (or mid-word if the line has none)
+			const usize current = quads.current / sizeof( TextQuad );
+			const usize first = breakX >= 0.0f ? breakFirst : current;
+			const float lineWidth = breakX >= 0.0f ? breakWidth : offsetX;
+			const float carry = breakX >= 0.0f ? breakX : offsetX;
+
+			quads_offset( quads, lineFirst, first, -lineWidth * halign * 0.5f, 0.0f );
+			quads_offset( quads, first, current, -carry, static_cast<float>( fontSize ) );
+			width = max( width, lineWidth );
+			lineCount++;
+
+			offsetX -= carry;
+			offsetY += fontSize;
+			lineFirst = first;
+			breakX = -1.0f;
+		}
+
+		// Glyph quad
+		if( glyph.texture != nullptr )
+		{
+			const float x1 = offsetX + glyph.x1;
+			const float y1 = offsetY + glyph.y1;
+			const float x2 = offsetX + glyph.x2;
+			const float y2 = offsetY + glyph.y2;
+
+			const TextQuad quad =
+			{
+				{
+					{ { x1, y1, 0.0f }, { glyph.u1, glyph.v1 }, { 255, 255, 255, 255 } },
+					{ { x2, y1, 0.0f }, { glyph.u2, glyph.v1 }, { 255, 255, 255, 255 } },
+					{ { x1, y2, 0.0f }, { glyph.u1, glyph.v2 }, { 255, 255, 255, 255 } },
+					{ { x2, y2, 0.0f }, { glyph.u2, glyph.v2 }, { 255, 255, 255, 255 } },
+				},
+				glyph.texture,
+				glyph.sdf,
+			};
+			quads.write( quad );
+		}
+
+		// Advance Character
+		if( whitespace && offsetX > 0.0f )
+		{
+			breakWidth = breakX == offsetX ? breakWidth : offsetX;
+			breakX = offsetX + glyph.advance;
+			breakFirst = quads.current / sizeof( TextQuad );
+		}
+		offsetX += glyph.advance;
+	}
+
+	// Vertical alignment
+	bounds.x = static_cast<i32>( ceilf( width ) );
+	bounds.y = lineCount * fontSize;
+	const float alignY = -static_cast<float>( bounds.y * valign ) * 0.5f;
+	if( alignY != 0.0f ) { quads_offset( quads, 0, quads.current / sizeof( TextQuad ), 0.0f, alignY ); }
+}
+
+
+void TextMesh::draw( const float x, const float y, const Color color, const float depth )
+{
+#if !RENDER_NONE
+	validate();
+
+	const TextQuad *const cached = reinterpret_cast<const TextQuad *>( quads.data );
+	const usize count = quads.current / sizeof( TextQuad );
+	bool sdf = false;
+
+	for( usize i = 0; i < count; i++ )
+	{
+		GfxBuiltInQuad quad = cached[i].quad;
+		quad.v1.position.x += x; quad.v1.position.y += y; quad.v1.position.z = depth;
+		quad.v2.position.x += x; quad.v2.position.y += y; quad.v2.position.z = depth;
+		quad.v3.position.x += x; quad.v3.position.y += y; quad.v3.position.z = depth;
+		quad.v4.position.x += x; quad.v4.position.y += y; quad.v4.position.z = depth;
+		quad.v1.color.x = color.r; quad.v1.color.y = color.g; quad.v1.color.z = color.b; quad.v1.color.w = color.a;
+		quad.v2.color = quad.v1.color;
+		quad.v3.color = quad.v1.color;
+		quad.v4.color = quad.v1.color;
+
+		// Switch between runtime atlas & SDF glyphs
+		if( UNLIKELY( cached[i].sdf != sdf ) )
+		{
+			sdf = cached[i].sdf;
+			if( sdf ) { iFonts::sdf_begin(); } else { iFonts::sdf_end(); }
+		}
+
+		// Rasterize pending glyphs when the atlas can be swapped (see draw_text)
+		if( !sdf && ( Gfx::quad_batch_can_break() || UNLIKELY( !Gfx::texture_bound( iFonts::texture2D ) ) ) )
+		{
+			iFonts::update();
+		}
+
+		Gfx::quad_batch_write( quad, cached[i].texture );
+	}
+
+	if( sdf ) { iFonts::sdf_end(); }
+#endif
+}
+
+
+i32v2 TextMesh::dimensions()
+{
+	validate();
+	return bounds;
+}
+
+
+u16 TextMesh::lines()
+{
+	validate();
+	return lineCount;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <types.hpp>
+#include <debug.hpp>
+
+#include <manta/buffer.hpp>
+#include <manta/color.hpp>
+#include <manta/draw.hpp>
+#include <manta/math.hpp>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Retained text
+//
+// TextMesh shapes a string once (UTF-8 decoding, glyph lookups, line breaks & alignment) and caches the resulting
+// glyph quads. Drawing a TextMesh only offsets & colors the cached quads into the quad batch. The layout is rebuilt
+// when the string, font, size, or wrap width passed to set() changes, when draw_set_halign/valign() differ from the
+// alignment it was shaped with, or when the font atlas is flushed (iFonts::generation).
+//
+//     static TextMesh label;
+//     label.set( fnt_consolas, 14, "Score" );
+//     label.draw( 16.0f, 16.0f, c_white );
+
+class TextMesh
+{
+public:
+	void init();
+	void free();
+
+	// Returns true if the layout was rebuilt ('wrapWidth' > 0 breaks lines on whitespace at that pixel width)
+	bool set( const u16 font, const u16 size, const char *string, const u16 wrapWidth = 0 );
+	bool set_f( const u16 font, const u16 size, const char *format, ... );
+
+	void draw( const float x, const float y, const Color color = c_white, const float depth = 0.0f );
+
+	i32v2 dimensions();
+	u16 lines();
+
+private:
+	void layout();
+	void validate();
+
+	Buffer string;    // null-terminated copy of the string
+	Buffer quads;     // TextQuad array (relative to the alignment origin, white)
+	i32v2 bounds = 0; // dimensions in pixels
+	u32 generation = U32_MAX;
+	u16 fontID = 0;
+	u16 fontSize = 0;
+	u16 wrap = 0;
+	u16 lineCount = 0;
+	Align halign = Align_Left;
+	Align valign = Align_Top;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
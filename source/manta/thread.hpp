@@ -11,14 +11,18 @@
 
 #if THREAD_WINDOWS
 	// Windows
-	#define THREAD_FUNCTION( name ) unsigned int STD_CALL name( void * )
+	#define THREAD_FUNCTION( name ) unsigned int STD_CALL name( void *argument )
 	using ThreadFunction = unsigned int (STD_CALL *)( void * );
 	#include <vendor/windows.hpp>
 #elif THREAD_POSIX
 	// POSIX
-	#define THREAD_FUNCTION( name ) void * name( void * )
+	#define THREAD_FUNCTION( name ) void * name( void *argument )
 	using ThreadFunction = void *(*)( void * );
 	#include <vendor/pthread.hpp>
+#else
+	// None
+	#define THREAD_FUNCTION( name ) void * name( void *argument )
+	using ThreadFunction = void *(*)( void * );
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -34,7 +38,7 @@ struct ThreadID
 	ThreadID( const pthread_t id ) { this->id = id; }
 	bool operator==( const ThreadID &other ) const { return ( id == other.id ); }
 #else
-	ThreadID( const pthread_t id ) { this->id = id; }
+	ThreadID() = default;
 	bool operator==( const ThreadID &other ) const { return true; }
 #endif
 };
@@ -44,12 +48,50 @@ struct ThreadID
 namespace Thread
 {
 	extern void sleep( u32 milliseconds );
+	extern void yield();
 	extern struct ThreadID id();
-	extern void *create( ThreadFunction function );
+	extern void *create( ThreadFunction function, void *argument = nullptr );
+	extern bool join( void *handle );
+	extern bool pin( void *handle, const u32 core );
+	extern u32 core_count();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Atomics (sequentially consistent)
+
+#if TOOLCHAIN_MSVC
+	extern "C" long _InterlockedExchange( long volatile *, long );
+	extern "C" long _InterlockedExchangeAdd( long volatile *, long );
+	extern "C" long _InterlockedCompareExchange( long volatile *, long, long );
+	extern "C" long long _InterlockedExchange64( long long volatile *, long long );
+	extern "C" long long _InterlockedExchangeAdd64( long long volatile *, long long );
+	extern "C" long long _InterlockedCompareExchange64( long long volatile *, long long, long long );
+	#pragma intrinsic( _InterlockedExchange, _InterlockedExchangeAdd, _InterlockedCompareExchange )
+	#pragma intrinsic( _InterlockedExchange64, _InterlockedExchangeAdd64, _InterlockedCompareExchange64 )
+
+	inline i32 atomic_load( const volatile i32 *ptr ) { return _InterlockedCompareExchange( reinterpret_cast<long volatile *>( const_cast<volatile i32 *>( ptr ) ), 0, 0 ); }
+	inline i64 atomic_load( const volatile i64 *ptr ) { return _InterlockedCompareExchange64( reinterpret_cast<long long volatile *>( const_cast<volatile i64 *>( ptr ) ), 0, 0 ); }
+	inline void atomic_store( volatile i32 *ptr, const i32 value ) { _InterlockedExchange( reinterpret_cast<long volatile *>( ptr ), value ); }
+	inline void atomic_store( volatile i64 *ptr, const i64 value ) { _InterlockedExchange64( reinterpret_cast<long long volatile *>( ptr ), value ); }
+	inline i32 atomic_add( volatile i32 *ptr, const i32 value ) { return _InterlockedExchangeAdd( reinterpret_cast<long volatile *>( ptr ), value ); }
+	inline i64 atomic_add( volatile i64 *ptr, const i64 value ) { return _InterlockedExchangeAdd64( reinterpret_cast<long long volatile *>( ptr ), value ); }
+	inline bool atomic_compare_exchange( volatile i32 *ptr, const i32 expected, const i32 desired )
+		{ return _InterlockedCompareExchange( reinterpret_cast<long volatile *>( ptr ), desired, expected ) == expected; }
+	inline bool atomic_compare_exchange( volatile i64 *ptr, const i64 expected, const i64 desired )
+		{ return _InterlockedCompareExchange64( reinterpret_cast<long long volatile *>( ptr ), desired, expected ) == expected; }
+	inline void atomic_fence() { volatile long fence = 0; _InterlockedExchange( &fence, 0 ); }
+#else
+	template <typename T> inline T atomic_load( const volatile T *ptr ) { return __atomic_load_n( ptr, __ATOMIC_SEQ_CST ); }
+	template <typename T> inline void atomic_store( volatile T *ptr, const T value ) { __atomic_store_n( ptr, value, __ATOMIC_SEQ_CST ); }
+	template <typename T> inline T atomic_add( volatile T *ptr, const T value ) { return __atomic_fetch_add( ptr, value, __ATOMIC_SEQ_CST ); }
+	template <typename T> inline bool atomic_compare_exchange( volatile T *ptr, T expected, const T desired )
+		{ return __atomic_compare_exchange_n( ptr, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST ); }
+	inline void atomic_fence() { __atomic_thread_fence( __ATOMIC_SEQ_CST ); }
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 struct Mutex
 {
 #if THREAD_WINDOWS
@@ -78,6 +120,7 @@ struct Condition
 	void free();
 	void sleep( Mutex &mutex );
 	void wake();
+	void wake_all();
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -131,6 +174,7 @@ template <typename T> bool ConcurrentQueue<T>::free()
 
 	memory_free( data );
 	data = nullptr;
+	return true;
 }
 
 
@@ -1,7 +1,7 @@
 #include <manta/time.hpp>
 
 #include <config.hpp>
-#include <manta/thread.hpp>
+#include <manta/math.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -19,6 +19,8 @@ namespace Time
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#define FRAME_SPIN_MARGIN_MIN ( 0.0001 ) // seconds
+
 namespace Frame
 {
 	u32 fps = 0;
@@ -27,23 +29,69 @@ namespace Frame
 	bool tickFrame = false;
 	bool tickSecond = false;
 
+	u32 steps = 1;
+	Delta deltaStep = 0.0;
+	double alpha = 1.0;
+
 	static u32 fpsCounter = 0;
 	static double timeStart = 0.0;
 	static double timeEnd = 0.0;
 	static double tickSecondTimer = 0.0;
 	static double tickFrameTimer = 0.0;
 
+	static double deadline = 0.0;                      // absolute end time of the current frame (0.0: unpaced)
+	static double spinMargin = FPS_MARGIN / 1000.0;    // seconds to busy-wait after waking (calibrated)
+	static double accumulator = 0.0;                   // FIXED_TIMESTEP time not yet simulated
+
 	static void regulate()
 	{
 		// Uncapped FPS?
-		if( Frame::fpsLimit == 0 ) { return; }
+		if( Frame::fpsLimit == 0 ) { Frame::deadline = 0.0; return; }
+
+		// Deadlines advance by exactly one period, so rounding errors and wake-up jitter do not accumulate
+		const double period = 1.0 / Frame::fpsLimit;
+		Frame::deadline = Frame::deadline == 0.0 ? Frame::timeStart + period : Frame::deadline + period;
+
+		// Late? (resynchronize if more than a frame behind rather than rushing the following frames)
+		if( Frame::timeEnd >= Frame::deadline )
+		{
+			if( Frame::timeEnd - Frame::deadline > period ) { Frame::deadline = Frame::timeEnd; }
+			return;
+		}
 
-		const double remaining = ( 1.0 / Frame::fpsLimit ) - ( Frame::timeEnd - Frame::timeStart );
-		const int sleep = static_cast<int>( remaining * 1000.0 ) - FPS_MARGIN; // miliseconds
+		// Sleep until shortly before the deadline
+		const double wake = Frame::deadline - Frame::spinMargin;
+		if( wake > Frame::timeEnd )
+		{
+			Time::sleep_until( wake );
+
+			// Calibrate: track oversleep, rising quickly after late wake-ups and falling slowly
+			const double oversleep = ( Time::value() - wake ) * 1.25;
+			Frame::spinMargin += ( oversleep - Frame::spinMargin ) * ( oversleep > Frame::spinMargin ? 0.5 : 0.05 );
+			Frame::spinMargin = clamp( Frame::spinMargin, FRAME_SPIN_MARGIN_MIN, FPS_MARGIN / 1000.0 );
+		}
 
-		// Sleep & Busy-wait
-		if( sleep > 0 ) { Thread::sleep( sleep ); }
-		while( Time::value() < Frame::timeEnd + remaining );
+		// Busy-wait the remainder
+		while( Time::value() < Frame::deadline ) { }
+	}
+
+	static void accumulate()
+	{
+	#if FIXED_TIMESTEP
+		// Fixed steps
+		deltaStep = 1.0 / FIXED_TIMESTEP;
+		accumulator += delta;
+		for( steps = 0; accumulator >= deltaStep && steps < FIXED_TIMESTEP_STEPS_MAX; steps++ ) { accumulator -= deltaStep; }
+
+		// Drop time the simulation cannot catch up on (e.g. after a stall)
+		if( accumulator >= deltaStep ) { accumulator = 0.0; }
+		alpha = accumulator / deltaStep;
+	#else
+		// Variable step
+		steps = 1;
+		deltaStep = delta;
+		alpha = 1.0;
+	#endif
 	}
 
 	void start()
@@ -53,6 +101,9 @@ namespace Frame
 		timeStart = Time::value();
 		delta = ( timeStart - timePrevious );
 
+		// Simulation steps
+		accumulate();
+
 		// Reset ticks
 		tickSecond = false;
 		tickFrame = false;
@@ -16,6 +16,9 @@ namespace Time
 {
 	extern double value();
 	extern u64 seed();
+
+	// Blocks until Time::value() >= time (may oversleep by the OS scheduler granularity)
+	extern void sleep_until( const double time );
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -59,6 +62,13 @@ namespace Frame
 	extern bool tickSecond;
 	extern bool tickFrame;
 
+	// Simulation steps: with FIXED_TIMESTEP, 'steps' steps of 'deltaStep' (1 / FIXED_TIMESTEP) run this frame and
+	// 'alpha' is the fraction of a step left in the accumulator (for interpolating between the last two simulated
+	// states when rendering). Otherwise there is 1 step of 'delta' and 'alpha' is 1.0.
+	extern u32 steps;
+	extern Delta deltaStep;
+	extern double alpha;
+
 	extern void start();
 	extern void end();
 }
\ No newline at end of file
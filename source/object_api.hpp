@@ -75,6 +75,10 @@
 	// Usage: GLOBAL void kill_all_rabbits() { ... }
 	#define GLOBAL
 
+	// Public object data stored per bucket as structure-of-arrays (iterate with foreach_object_fields)
+	// Usage: HOT float x = 0.0f;
+	#define HOT
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 